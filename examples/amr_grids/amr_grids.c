@@ -70,7 +70,7 @@ INT main(INT   argc,   char *argv[])
   //NNNNNNNNNNNNNNNN
   if(amr_marking_type==0){
     // refine ref_levels;
-    refine(ref_levels,sc,NULL);
+    refine_par(ref_levels,sc,NULL);
   } else if (amr_marking_type==44){
     node_ins=icsr_create(0,0,0);
     nstar = feat.nf;
@@ -90,7 +90,7 @@ INT main(INT   argc,   char *argv[])
       for(k=0;k<marked.row;++k)
 	if(marked.val[k]) kmarked++;
       fprintf(stdout,"\n|lvl=%2lld|simplices[%2lld:%2lld]=%12lld|simplices[%2lld]=%12lld|",(long long int)j,0LL,(long long int)j,(long long int)sc->ns,(long long int)j,(long long int)sctop->ns);fflush(stdout);      
-      refine(1,sc,&marked);
+      refine_par(1,sc,&marked);
       if(!kmarked){
 	fprintf(stdout,"\nthere were no simplices containing > %lld points. Exiting",(long long )MAX_NODES_PER_SIMPLEX);
 		ivec_free(&marked);
@@ -123,7 +123,7 @@ INT main(INT   argc,   char *argv[])
        */
       marked=mark_near_points(sctop,nstar,xstar, threshold);
       fprintf(stdout,"\n|lvl=%2lld|simplices[%2lld:%2lld]=%12lld|simplices[%2lld]=%12lld|",(long long int)j,0LL,(long long int)j,(long long int)sc->ns,(long long int)j,(long long int)sctop->ns);fflush(stdout);
-      refine(1,sc,&marked);
+      refine_par(1,sc,&marked);
       /* free */
       ivec_free(&marked);
       haz_scomplex_free(sctop);
@@ -164,7 +164,7 @@ INT main(INT   argc,   char *argv[])
        *  are in a loop, it will refine ref_levels times;
        */
       //      haz_scomplex_print(sctop,0,__FUNCTION__);
-      refine(1,sc,&marked);
+      refine_par(1,sc,&marked);
       /* free */
       haz_scomplex_free(sctop);
       dvec_free(&solfem);
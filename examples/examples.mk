@@ -105,6 +105,16 @@ ifeq ($(WITH_LAPACK),1)
 	LIBS += -llapack
 endif
 
+ifeq ($(WITH_ZLIB),1)
+	CFLAGS += -DWITH_ZLIB=1
+	LIBS += -lz
+endif
+
+ifeq ($(WITH_PTHREADS),1)
+	CFLAGS += -DWITH_PTHREADS=1
+	LIBS += -lpthread
+endif
+
 ifeq ($(WITH_HDF5),1)
 	CFLAGS += -DWITH_HDF5=1
 	LIBS += -lhdf5_serial
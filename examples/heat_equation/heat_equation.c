@@ -180,11 +180,14 @@ int main (int argc, char* argv[])
   time_stepper.sol = &sol;
 
   // Dump Solution
+  // The files are written by a background thread while the next step is computed
   char solout[40];
   char exactout[40];
+  async_writer *writer = NULL;
   if (inparam.output_dir!=NULL) {
+    writer = async_writer_create(ASYNC_NBUF);
     sprintf(solout,"output/solution_ts000.vtu");
-    dump_sol_vtk(solout,"u",&mesh,&FE,time_stepper.sol->val);
+    async_dump_sol_vtk(writer,solout,"u",&mesh,&FE,time_stepper.sol->val);
   }
 
   // Store current RHS
@@ -310,9 +313,9 @@ int main (int argc, char* argv[])
 
     if (inparam.output_dir!=NULL) {
       sprintf(solout,"output/solution_ts%03lld.vtu",(long long )time_stepper.current_step);
-      dump_sol_vtk(solout,"u",&mesh,&FE,time_stepper.sol->val);
+      async_dump_sol_vtk(writer,solout,"u",&mesh,&FE,time_stepper.sol->val);
       sprintf(exactout,"output/exact_solution_ts%03lld.vtu",(long long )time_stepper.current_step);
-      dump_sol_vtk(exactout,"ut",&mesh,&FE,exact_sol.val);
+      async_dump_sol_vtk(writer,exactout,"ut",&mesh,&FE,exact_sol.val);
     }
     printf("\n");
   } // End Timestepping Loop
@@ -331,6 +334,7 @@ int main (int argc, char* argv[])
 
   // Combine all timestep vtks in one file
   if (inparam.output_dir!=NULL) {
+    async_writer_free(writer);
     create_pvd("output/solution.pvd",time_stepper.tsteps+1,"solution_ts","timestep");
   }
 
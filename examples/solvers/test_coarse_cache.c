@@ -0,0 +1,78 @@
+/*! \file examples/solver/test_coarse_cache.c
+ *
+ *  Copyright 2019_HAZMATH__. All rights reserved.
+ *
+ * \brief This program sets up UA AMG for the 5-point Laplacian with the
+ *        automatic coarse solver (SOLVER_AUTO) twice and checks that the
+ *        second setup reuses the cached coarsest level factorization.
+ *
+ * \note The first hierarchy is freed before the second setup, so the
+ *       factorization is kept alive only by the cache. Returns 0 if it
+ *       is reused and 1 otherwise.
+ *
+ */
+
+/************* HAZMATH FUNCTIONS and INCLUDES ***************************/
+#include "hazmath.h"
+/***********************************************************************/
+// 5-point finite difference Laplacian on an m x m grid
+static dCSRmat laplacian(const INT m)
+{
+  INT i,j,k,nnz=0;
+  dCSRmat A=dcsr_create(m*m,m*m,5*m*m);
+  for(k=0;k<m*m;k++){
+    i=k/m; j=k%m;
+    A.IA[k]=nnz;
+    if(i>0)  {A.JA[nnz]=k-m; A.val[nnz++]=-1.;}
+    if(j>0)  {A.JA[nnz]=k-1; A.val[nnz++]=-1.;}
+    A.JA[nnz]=k; A.val[nnz++]=4.;
+    if(j<m-1){A.JA[nnz]=k+1; A.val[nnz++]=-1.;}
+    if(i<m-1){A.JA[nnz]=k+m; A.val[nnz++]=-1.;}
+  }
+  A.IA[m*m]=nnz; A.nnz=nnz;
+  return A;
+}
+// UA AMG setup of A with the automatic coarse solver, then the hierarchy
+// is freed; returns its coarsest level factorization (NULL: iterative)
+static void *setup_and_free(dCSRmat *A)
+{
+  void *Numeric;
+  AMG_param amgparam;
+  param_amg_init(&amgparam); // amg_setup_ua changes the parameters
+  amgparam.AMG_type = UA_AMG;
+  amgparam.aggregation_type = MIS; // same coarse matrix every time
+  amgparam.coarse_solver = SOLVER_AUTO;
+  amgparam.print_level = PRINT_MORE;
+  AMG_data *mgl = amg_data_create(amgparam.max_levels);
+  mgl[0].A = dcsr_create(A->row,A->col,A->nnz); dcsr_cp(A,&mgl[0].A);
+  mgl[0].b = dvec_create(A->row); mgl[0].x = dvec_create(A->row);
+  amg_setup_ua(mgl,&amgparam);
+  Numeric = mgl[mgl[0].num_levels-1].Numeric;
+  amg_data_free(mgl,&amgparam); free(mgl);
+  return Numeric;
+}
+/****** MAIN DRIVER **************************************************/
+int main (int argc, char* argv[])
+{
+  void *first, *second;
+  INT cached;
+  dCSRmat A = laplacian((argc>1) ? atoi(argv[1]) : 256);
+
+  first = setup_and_free(&A);
+  second = setup_and_free(&A);
+  // one factorization, kept by the cache and found by the second setup
+  cached = amg_coarse_cache_size();
+
+  amg_coarse_cache_free();
+  dcsr_free(&A);
+
+  if (first==NULL || second!=first || cached!=1) {
+    fprintf(stdout,"\nFAILED: the coarsest level factorization was not reused\n");
+    return 1;
+  }
+  fprintf(stdout,"\nPASSED: the coarsest level factorization was reused\n");
+  return 0;
+}
+/*---------------------------------*/
+/*--        End of File          --*/
+/*---------------------------------*/
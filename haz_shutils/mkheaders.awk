@@ -72,7 +72,7 @@ BEGIN {
   next;
 }
 
-!/^INT|^REAL|^coordinates|^mesh_struct|^qcoordinates|^FILE|^OFF_T|^size_t|^off_t|^pid_t|^unsigned|^mode_t|^DIR|^user|^int|^char|^uint|^struct|^SHORT|^BOOL|^void|^double|^time|^dCSRmat|^dvector|^iCSRmat|^ivector|^dCOOmat|^dDENSEmat|^iDENSEmat|^dBSRmat|^block_dCSRmat|^AMG_data|^AMG_param|^scomplex|^MG_blk_data|^HX_curl_data|^HX_div_data|^precond_block_data|^precond_data|^precond_ra_data|^smoother_data|^smoother_matvec|^PyObject|^subscomplex|^macrocomplex|^unigrid|^cube2simp|^input_grid|^coordsystem|^features|^locdetails/ {
+!/^INT|^REAL|^coordinates|^mesh_struct|^qcoordinates|^FILE|^OFF_T|^size_t|^off_t|^pid_t|^unsigned|^mode_t|^DIR|^user|^int|^char|^uint|^struct|^SHORT|^BOOL|^void|^double|^time|^dCSRmat|^dvector|^iCSRmat|^ivector|^dCOOmat|^dDENSEmat|^iDENSEmat|^dBSRmat|^dSELLmat|^vtu_writer|^async_writer|^block_dCSRmat|^AMG_data|^AMG_param|^scomplex|^MG_blk_data|^HX_curl_data|^HX_div_data|^precond_block_data|^precond_data|^precond_ra_data|^precond[ *]|^smoother_data|^smoother_matvec|^PyObject|^subscomplex|^macrocomplex|^unigrid|^cube2simp|^input_grid|^coordsystem|^features|^locdetails/ {
 
   next;
 }
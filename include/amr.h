@@ -35,6 +35,10 @@ typedef struct /* n-homogenous simplicial complex */
   INT n; /* the dimension of SC */
   INT nv; /* number of 0-dimensional simplices */
   INT ns; /* number of n-dimensional simplices */
+  INT ns_max; /* capacity (in simplices) of the arrays indexed by
+		 simplices; ns<=ns_max */
+  INT nv_max; /* capacity (in vertices) of the arrays indexed by
+		 vertices; nv<=nv_max */
   INT level; /* level of refinement */
   INT *marked; /*whether marked or not*/
   INT *gen; /* array to hold the simplex generation during refinement */
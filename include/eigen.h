@@ -10,6 +10,13 @@
 #define _eigen_h
 #endif
 
+// BLAS Routines
+
+// matrix-matrix product C = alpha*op(A)*op(B) + beta*C
+void dgemm_(char *transa, char *transb, INT *m, INT *n, INT *k,	\
+	    REAL *alpha, REAL *a, INT *lda, REAL *b, INT *ldb,	\
+	    REAL *beta, REAL *c, INT *ldc);
+
 // LAPACK Routines
 
 // Symmetric eigenvalue computation
@@ -0,0 +1,2439 @@
+/*******************************************************************/  
+/* This header file was automatically generated with "make headers".   */
+/* WARNING: DO NOT EDIT!!!                               */  
+/*******************************************************************/  
+
+// Standard Includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+#include <assert.h>
+#if WITH_HAZNICS
+#include <Python.h>
+#endif
+// Internal Includes
+#include "macro.h"
+#include "mesh.h"
+#include "amr.h"
+#include "sparse.h"
+#include "dense.h"
+#include "vec.h"
+#include "fem.h"
+#include "solver.h"
+#include "nonlinear.h"
+#include "timestep.h"
+#include "param.h"
+#include "eigen.h"
+#include "graphs.h"
+// Special Includes
+#if WITH_MATLAB
+#include "mex.h"
+#endif
+#if WITH_HAZNICS
+#include "haznics_add.h"
+#endif
+
+/* In file: src/amr/any_dimension_p1.c */
+SHORT grad_compute(INT dim, REAL factorial, REAL *xs, REAL *grad,	\
+		   void *wrk);
+void local_sm(REAL *slocal,		\
+	      REAL *grad,			\
+	      const INT dim,			\
+	      const REAL vols);
+REAL *local_mm(const INT dim);
+void local_coords(const INT dim,REAL *xs,INT *nodes, REAL *x);
+void local_coords_batch(const INT dim,const INT nb,REAL *xsb,	\
+			INT *nodes,REAL *x);
+SHORT grad_compute_batch(INT dim, REAL factorial, REAL *xsb,	\
+			 REAL *gradb,void *wrk);
+void local_sm_batch(REAL *slocalb,			\
+		    REAL *gradb,			\
+		    const INT dim,			\
+		    const REAL *vols);
+INT assemble_p1(scomplex *sc, dCSRmat *A, dCSRmat *M);
+
+/* In file: src/assemble/assemble_global.c */
+void assemble_global(dCSRmat* A,dvector *b,void (*local_assembly)(REAL *,fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_withBC(dCSRmat* A,dvector *b,void (*local_assembly)(REAL *,fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),void (*bc)(REAL *,REAL *,REAL,void *),void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_FE1FE2(dCSRmat* A,dvector *b,void (*local_assembly)(REAL *,fespace *,fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),fespace *FE1, fespace *FE2, mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_block(block_dCSRmat* A,dvector *b,void (*local_assembly)(REAL *,block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,REAL),void (*local_rhs_assembly)(REAL *,block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_Jacobian(block_dCSRmat* A,dvector *b,dvector *old_sol,void (*local_assembly)(REAL *,REAL *,dvector *,block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_RHS(dvector *b,fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_RHS_block(dvector *b,void (*local_rhs_assembly)(REAL *,block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_RHS_Jacobian(dvector *b,dvector *old_sol,void (*local_rhs_assembly)(REAL *,dvector *,block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_global_face(dCSRmat* A,dvector* b,dvector *old_sol,void (*local_assembly_face)(REAL *,dvector *,fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT *,INT,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),void (*local_rhs_assembly_face)(REAL *,dvector *,fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT *,INT,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*coeff)(REAL *,REAL *,REAL,void *),void (*rhs)(REAL *,REAL *, REAL,void *),REAL time,INT flag0,INT flag1);
+void assemble_global_RHS_face(dvector* b,dvector *old_sol,void (*local_rhs_assembly_face)(REAL *,dvector *,fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT *,INT,INT,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *, REAL,void *),REAL time,INT flag0,INT flag1);
+void assemble_global_face_block(block_dCSRmat* A,dvector* b,dvector *old_sol,void (*local_assembly_face)(REAL *,dvector *,block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT *,INT,INT,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),void (*local_rhs_assembly_face)(REAL *,dvector *,block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT *,INT,INT,INT,void (*)(REAL *,REAL *,REAL,void *),REAL),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*coeff)(REAL *,REAL *,REAL,void *),void (*rhs)(REAL *,REAL *, REAL,void *),REAL time,INT flag0,INT flag1);
+void assemble_global_RHS_face_block(dvector *b, dvector *old_sol, void (*local_rhs_assembly_face)(REAL *, dvector *, block_fespace *,mesh_struct *,qcoordinates *,INT *,INT *, INT *, INT, INT, INT,void (*)(REAL *,REAL *,REAL,void *),REAL),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time, INT flag0, INT flag1);
+void assemble_global_Ned_GradH1_RHS(dvector *b,fespace *FE_H1,fespace *FE_Ned,mesh_struct *mesh,qcoordinates *cq,dvector* u);
+
+/* In file: src/assemble/assemble_local.c */
+void assemble_DuDv_local(REAL* ALoc,fespace *FE,mesh_struct *mesh,qcoordinates *cq,INT *dof_on_elm,INT *v_on_elm,INT elm,void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_mass_local(REAL* MLoc,fespace *FE,mesh_struct *mesh,qcoordinates *cq,INT *dof_on_elm,INT *v_on_elm,INT elm,void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_P1masslump_local(REAL* MLoc,fespace *FE,mesh_struct *mesh,qcoordinates *cq,INT *dof_on_elm,INT *v_on_elm,INT elm,void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_DuDvplusmass_local(REAL* ALoc,fespace *FE,mesh_struct *mesh,qcoordinates *cq,INT *dof_on_elm,INT *v_on_elm,INT elm,void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void assemble_symmetricDuDv_local(REAL* ALoc, block_fespace *FE, mesh_struct *mesh, qcoordinates *cq, INT *dof_on_elm, INT *v_on_elm, INT elm, REAL time);
+void boundary_mass_local(REAL* MLoc,dvector* old_sol,fespace *FE,mesh_struct *mesh,qcoordinates *cq, \
+                         INT *dof_on_f,INT *dof_on_elm,INT *v_on_elm,INT face,INT elm,void (*coeff)(REAL *,REAL *,REAL,void *),REAL time);
+void FEM_RHS_Local(REAL* bLoc,fespace *FE,mesh_struct *mesh,qcoordinates *cq,INT *dof_on_elm,INT *v_on_elm,INT elm,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+void FEM_Block_RHS_Local(REAL* bLoc,block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,INT *dof_on_elm,INT *v_on_elm,INT elm,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+void Ned_GradH1_RHS_local(REAL* bLoc,fespace *FE_H1,fespace *FE_Ned,mesh_struct *mesh,qcoordinates *cq,INT *ed_on_elm,INT *v_on_elm,INT elm,dvector* u);
+void FEM_RHS_Local_face(REAL* bLoc,dvector* old_sol,fespace *FE,mesh_struct *mesh,qcoordinates *cq,INT *dof_on_f,INT *dof_on_elm,INT *v_on_elm,INT dof_per_face,INT face,INT elm,void (*rhs)(REAL *,REAL *,REAL,void *),REAL time);
+
+/* In file: src/assemble/assemble_utils.c */
+void create_CSR_rows(dCSRmat *A, fespace *FE);
+void create_CSR_rows_FE1FE2(dCSRmat *A, fespace *FE1, fespace *FE2);
+void create_CSR_rows_withBC(dCSRmat *A, fespace *FE);
+void create_CSR_rows_flag(dCSRmat *A, fespace *FE,INT flag0,INT flag1);
+void create_CSR_cols(dCSRmat *A, fespace *FE);
+void create_CSR_cols_FE1FE2(dCSRmat *A, fespace *FE1, fespace *FE2);
+void create_CSR_cols_withBC(dCSRmat *A, fespace *FE);
+void create_CSR_cols_flag(dCSRmat *A, fespace *FE,INT flag0,INT flag1);
+void LocaltoGlobal(INT *dof_on_elm,fespace *FE,dvector *b,dCSRmat *A,REAL *ALoc,REAL *bLoc);
+void LocaltoGlobal_FE1FE2(INT *dof_on_elm1,fespace *FE1,INT *dof_on_elm2,fespace *FE2,dvector *b,dCSRmat *A,REAL *ALoc,REAL *bLoc);
+void block_LocaltoGlobal(INT *dof_on_elm,block_fespace *FE,dvector *b,block_dCSRmat *A,REAL *ALoc,REAL *bLoc);
+void LocaltoGlobal_withBC(INT *dof_on_elm,fespace *FE,dvector *b,dCSRmat *A,REAL *ALoc,REAL *bLoc);
+void LocaltoGlobal_face(INT *dof_on_f,INT dof_per_f,fespace *FE,dvector *b,dCSRmat *A,REAL *ALoc,REAL *bLoc,INT flag0,INT flag1);
+void block_LocaltoGlobal_face(INT *dof_on_f,INT dof_per_f,INT* dof_per_face_blk,block_fespace *FE,dvector *b,block_dCSRmat *A,REAL *ALoc,REAL *bLoc,INT flag0,INT flag1);
+void eliminate_DirichletBC(void (*bc)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,dvector *b,dCSRmat *A,REAL time);
+void eliminate_DirichletBC_RHS(void (*bc)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,dvector *b,dCSRmat *A,REAL time);
+void block_eliminate_DirichletBC(void (*bc)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,dvector *b,
+void *A,INT Atype,REAL time);
+void block_eliminate_DirichletBC_RHS(void (*bc)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,
+dvector *b,void *A,INT Atype,REAL time);
+void eliminate_DirichletBC_blockFE(void (*bc)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,dvector *b,dCSRmat *A,REAL time);
+void eliminate_DirichletBC_RHS_blockFE(void (*bc)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,dvector *b,dCSRmat *A,REAL time);
+void eliminate_DirichletBC_blockFE_blockA(void (*bc)(REAL *, REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,dvector *b,
+block_dCSRmat *A,REAL time);
+void eliminate_DirichletBC_RHS_blockFE_blockA(void (*bc)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,dvector *b,block_dCSRmat *A,REAL time);
+void generate_periodic_P(fespace* FE, dCSRmat* P_periodic);
+void generate_periodic_R_scaled(dCSRmat* P_periodic, dCSRmat* R_periodic_scaled);
+void eliminate_PeriodicBC(dCSRmat* P_periodic, dCSRmat* A, dvector* b);
+void eliminate_PeriodicBC_nonoverwrite(dCSRmat* P_periodic, dCSRmat* A, dvector* b, dCSRmat* PTAP, dvector* PTb);
+void apply_PeriodicBC(dCSRmat* P_periodic, dvector* u);
+void apply_PeriodicBC_nonoverwrite(dCSRmat* P_periodic, dvector* u_periodic, dvector* u);
+void generate_periodic_P_blockFE(block_fespace* FE, block_dCSRmat* P_periodic);
+void generate_periodic_R_scaled_blockFE(block_dCSRmat* P_periodic, block_dCSRmat* R_periodic_scaled);
+void eliminate_PeriodicBC_blockFE(block_dCSRmat* P_periodic, block_dCSRmat* A, dvector* b);
+void eliminate_PeriodicBC_blockFE_nonoverwrite(block_dCSRmat* P_periodic, block_dCSRmat* A, dvector* b, block_dCSRmat* PTAP, dvector* PTb);
+void eliminate_PeriodicBC_blockFE_RHS_nonoverwrite(block_dCSRmat* P_periodic, dvector* b, dvector* PTb);
+void apply_PeriodicBC_blockFE(block_dCSRmat* P_periodic, dvector* u);
+void apply_PeriodicBC_blockFE_nonoverwrite(block_dCSRmat* P_periodic, dvector* u_periodic, dvector* u);
+
+/* In file: src/fem/basis.c */
+void P1_basis_ref(REAL *lam,REAL *dlam,REAL *x,INT dim);
+void P1_basis_physical(REAL *lam,REAL *dlam,REAL *x,simplex_local_data* elm_data);
+void compute_refelm_mapping(REAL* ref_map,REAL* lamgrads,REAL *xv,INT dim);
+void PX_basis(REAL *p,REAL *dp,INT porder,INT dim,REAL* lam, REAL* dlam);
+void ned0_basis(REAL *phi,REAL *cphi,REAL* lam,REAL* dlam,INT dim,INT* v_on_elm,INT* v_on_ed,REAL* ed_len);
+void rt0_basis(REAL *phi,REAL *dphi,REAL* lam,REAL* dlam,INT dim,INT* v_on_elm,INT* v_on_face,REAL* f_area);
+void bdm1_basis(REAL *phi,REAL *dphix,REAL *dphiy,REAL* lam,REAL* dlam,INT dim,INT* v_on_elm,INT* v_on_face,REAL* farea);
+void face_bubble_basis(REAL *phi, REAL *dphi,REAL* lam,REAL* dlam,INT dim,INT* v_on_elm,INT* v_on_face,REAL* f_area,REAL* f_norm);
+void get_FEM_basis_on_elm(REAL *phi,REAL *dphi,simplex_local_data *simplex_data,fe_local_data *fe_data,REAL *lam, REAL* dlam,INT space_index);
+void get_FEM_basis_at_quadpt(simplex_local_data *simplex_data,fe_local_data *fe_data,INT space_index,INT quadpt);
+void get_FEM_basis_at_x(simplex_local_data *simplex_data,fe_local_data *fe_data,INT space_index,REAL *x);
+void PX_H1_basis(REAL *p,REAL *dp,REAL *x,INT *dof,INT porder,mesh_struct *mesh);
+void quad_tri_2D_2der(REAL *p,REAL *dpx,REAL *dpy,REAL *dpxx,REAL *dpyy,REAL *dpxy,REAL x,REAL y,REAL z,INT *dof,INT porder,mesh_struct *mesh);
+void P2_basis_2der(REAL *p,REAL *dp,REAL *ddp,REAL* x,INT *dof,mesh_struct *mesh);
+void ned_basis(REAL *phi,REAL *cphi,REAL *x,INT *v_on_elm,INT *dof,mesh_struct *mesh);
+void rt_basis(REAL *phi,REAL *dphi,REAL *x,INT *v_on_elm,INT *dof,mesh_struct *mesh);
+void bdm1_basis_global(REAL *phi,REAL *dphix,REAL *dphiy,REAL *x,INT *v_on_elm,INT *dof,mesh_struct *mesh);
+void bubble_face_basis(REAL *phi, REAL *dphi, REAL *x, INT *v_on_elm, INT *dof, mesh_struct *mesh);
+void MINI_basis(REAL *p,REAL *dp,REAL *x,INT *v_on_elm,mesh_struct *mesh);
+void get_FEM_basis(REAL *phi,REAL *dphi,REAL *x,INT *v_on_elm,INT *dof,mesh_struct *mesh,fespace *FE);
+
+/* In file: src/fem/error.c */
+REAL L2norm(REAL *u,fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+void L2norm_block(REAL *norm,REAL *u,block_fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+REAL L2_InnerProduct(REAL *u,REAL *v,fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+void L2_InnerProduct_block(REAL *prod,REAL *u,REAL *v,block_fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+REAL L2error(REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+void L2error_block(REAL *err,REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+REAL L2error_mass(REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+void L2error_block_mass(REAL *err, REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+REAL HDseminorm(REAL *u,fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+void HDseminorm_block(REAL *norm,REAL *u,block_fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+REAL HDsemierror(REAL *u,void (*D_truesol)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+void HDsemierror_block(REAL *err,REAL *u,void (*D_truesol)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+REAL HDsemierror_stiff(REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+void HDsemierror_block_stiff(REAL *err, REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+REAL HDnorm(REAL *u,fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+void HDnorm_block(REAL *norm,REAL *u,block_fespace *FE,mesh_struct *mesh,qcoordinates *cq);
+REAL HDerror(REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),void (*D_truesol)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+void HDerror_block(REAL *err,REAL *u,void (*truesol)(REAL *,REAL *,REAL,void *),void (*D_truesol)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,qcoordinates *cq,REAL time);
+REAL energynorm_discrete(REAL *u,fespace *FE,mesh_struct *mesh,qcoordinates *cq, void (*coeff)(REAL *,REAL *,REAL,void *),void (*local_assembly_routine)(REAL *,fespace *,mesh_struct *,qcoordinates *,INT *,INT *,INT,void (*)(REAL *,REAL *,REAL,void *),REAL), REAL param);
+
+/* In file: src/fem/fespace.c */
+void initialize_fespace(fespace *FE);
+void create_fespace(fespace *FE,mesh_struct* mesh,INT FEtype);
+void free_fespace(fespace* FE);
+void initialize_fesystem(block_fespace *FE,INT nspaces,INT nun,INT ndof,INT nelm);
+void initialize_localdata_elm(simplex_local_data *simplex_data,fe_local_data *fe_data,mesh_struct* mesh,block_fespace *FE,INT nq1d);
+void get_elmlocaldata(simplex_local_data* elm_data,mesh_struct* mesh,INT elm);
+void initialize_localdata_face(simplex_local_data *simplex_data,fe_local_data *fe_data,mesh_struct* mesh,block_fespace *FE,INT nq1d);
+void get_facelocaldata(simplex_local_data* face_data,mesh_struct* mesh,INT face);
+void initialize_localdata_edge(simplex_local_data *simplex_data,fe_local_data *fe_data,mesh_struct* mesh,block_fespace *FE,INT nq1d);
+void get_edgelocaldata(simplex_local_data* edge_data,mesh_struct* mesh,INT edge);
+INT get_blocksize_fespace(block_fespace *FE,mesh_struct *mesh);
+void free_blockfespace(block_fespace* FE);
+void free_felocaldata(fe_local_data* loc_data);
+void free_simplexlocaldata(simplex_local_data* loc_data);
+void get_P2(fespace* FE,mesh_struct* mesh);
+void get_MINI(fespace* FE,mesh_struct* mesh);
+void dump_el_dof(FILE* fid,iCSRmat *el_dof);
+void dump_fespace(fespace *FE,char *varname,char *dir);
+void set_dirichlet_bdry(fespace* FE,mesh_struct* mesh, const INT flag0, const INT flag1);
+void set_dirichlet_bdry_block(block_fespace* FE,mesh_struct* mesh);
+void set_periodic_bdry(fespace* FE,mesh_struct* mesh,const REAL minx,const REAL maxx,const REAL miny,const REAL maxy,const REAL minz,const REAL maxz);
+void get_incidence_row(INT row,iCSRmat *fem_map,INT* thisrow);
+void get_coords(REAL* x,INT dof,coordinates* cdof,INT dim);
+
+/* In file: src/fem/interp.c */
+void fe_interpolation_to_x(REAL* val,REAL* u,REAL* x,fe_local_data* fe_data,simplex_local_data* elm_data,INT space_index);
+void fe_interpolation_to_quadpt(REAL* val,fe_local_data* fe_data,simplex_local_data* elm_data,INT space_index,INT quadpt);
+void fe_dinterp_to_x(REAL* val,REAL* u,REAL* x,fe_local_data* fe_data,simplex_local_data* elm_data,INT space_index);
+void fe_dinterp_to_quadpt(REAL* val,fe_local_data* fe_data,simplex_local_data* elm_data,INT space_index,INT quadpt);
+void blockfe_interpolation_to_x(REAL* val,REAL* u,REAL* x,fe_local_data* fe_data,simplex_local_data* elm_data);
+void blockfe_interpolation_to_quadpt(REAL* val,fe_local_data* fe_data,simplex_local_data* elm_data,INT quadpt);
+void blockfe_dinterp_to_x(REAL* val,REAL* u,REAL* x,fe_local_data* fe_data,simplex_local_data* elm_data);
+void blockfe_dinterp_to_quadpt(REAL* val,fe_local_data* fe_data,simplex_local_data* elm_data,INT quadpt);
+REAL FE_Evaluate_DOF(void (*expr)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,REAL time,INT DOF);
+void FE_Evaluate(REAL* val,void (*expr)(REAL *,REAL *,REAL,void *),fespace *FE,mesh_struct *mesh,REAL time);
+REAL blockFE_Evaluate_DOF(void (*expr)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,REAL time,INT comp,INT DOF);
+void blockFE_Evaluate(REAL* val,void (*expr)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,REAL time);
+void blockFE_EvaluateBoundary(REAL* val,void (*expr)(REAL *,REAL *,REAL,void *),block_fespace *FE,mesh_struct *mesh,REAL time);
+void Project_to_Vertices(REAL* u_on_V,REAL *u,fespace *FE,mesh_struct *mesh);
+void get_unknown_component(dvector* u,dvector* ublock,block_fespace *FE,INT comp);
+void set_unknown_component(dvector* u,dvector* ublock,block_fespace *FE,INT comp);
+void get_grad_H1toNed(dCSRmat* Grad,mesh_struct* mesh);
+void get_curl_NedtoRT(dCSRmat* Curl,mesh_struct* mesh);
+void get_div_RTtoL2(dCSRmat* Div,mesh_struct* mesh);
+void get_Pigrad_H1toNed(dCSRmat* Pgrad,mesh_struct* mesh);
+void get_Pigrad_H1toRT( dCSRmat* Pdiv, dCSRmat* Pcurl, dCSRmat* Curl, mesh_struct* mesh);
+void ProjectOut_Grad(dvector* u,fespace* FE_H1,fespace* FE_Ned,mesh_struct* mesh,qcoordinates* cq,dCSRmat* G);
+void FE_Interpolation(REAL* val,REAL *u,REAL* x,INT *dof_on_elm,INT *v_on_elm,fespace *FE,mesh_struct *mesh);
+void FE_DerivativeInterpolation(REAL* val,REAL *u,REAL *x,INT *dof_on_elm,INT *v_on_elm,fespace *FE,mesh_struct *mesh);
+void blockFE_Interpolation(REAL* val,REAL *u,REAL* x,INT *dof_on_elm,INT *v_on_elm,block_fespace *FE,mesh_struct *mesh);
+void blockFE_DerivativeInterpolation(REAL* val,REAL *u,REAL* x,INT *dof_on_elm,INT *v_on_elm,block_fespace *FE,mesh_struct *mesh);
+void P2_2ndDerivativeInterpolation(REAL* val,REAL *u,REAL *x,INT *dof_on_elm,fespace *FE,mesh_struct *mesh);
+
+/* In file: src/fem/quadrature.c */
+struct quadrature *alloc_quadrature(INT nq1d,INT nsimplex,INT dim);
+struct quadrature *alloc_quadrature_bdry(INT nq1d,INT nregion,INT dim,INT ed_or_f);
+void free_quadrature(quadrature* Q);
+void quad_refelm(quadrature *cqelm,INT nq1d,INT dim);
+void quad_elm_local(quadrature *cqelm,simplex_local_data *loc_data,INT nq1d);
+void quad_edge_local(quadrature *cqedge,simplex_local_data *loc_data,INT nq1d,INT edge);
+void quad_face_local(quadrature *cqface,simplex_local_data *loc_data,INT nq1d,INT face);
+REAL integrate_elm_local(void (*expr)(REAL *,REAL *,INT,REAL,void *),INT nun,INT comp,quadrature *cq,simplex_local_data *elm_data,REAL time);
+REAL integrate_face_local(void (*expr)(REAL *,REAL *,INT,REAL,void *),INT nun,INT comp,quadrature *cq,simplex_local_data *face_data,REAL time);
+REAL integrate_edge_local(void (*expr)(REAL *,REAL *,INT,REAL,void *),INT nun,INT comp,quadrature *cq,simplex_local_data *edge_data,REAL time);
+REAL integrate_edge_vector_tangent_local(void (*expr)(REAL *,REAL *,INT,REAL,void *),INT nun,INT comp,quadrature *cq,simplex_local_data *edge_data,REAL time);
+REAL integrate_face_vector_normal_local(void (*expr)(REAL *,REAL *,INT,REAL,void *),INT nun,INT comp,quadrature *cq,simplex_local_data *face_data,REAL time);
+REAL integrate_domain_local(void (*expr)(REAL *,REAL *,INT,REAL,void *),INT nun,INT comp,INT nq1d,quadrature *cq,simplex_local_data *elm_data,mesh_struct *mesh,REAL time);
+void quad1d(REAL *gaussp, REAL *gaussc, INT ng1d);
+void triquad_(REAL *gp, REAL *gc, INT ng1d);
+void tetquad_(REAL *gp, REAL *gc, INT ng1d);
+struct qcoordinates *allocateqcoords(INT nq1d,INT nelm,INT mydim);
+struct qcoordinates *allocateqcoords_bdry(INT nq1d,INT nregion,INT dim,INT ed_or_f);
+void free_qcoords(qcoordinates* A);
+qcoordinates* get_quadrature(mesh_struct *mesh,INT nq1d);
+void quad_elm(qcoordinates *cqelm,mesh_struct *mesh,INT nq1d,INT elm);
+qcoordinates* get_quadrature_boundary(mesh_struct *mesh,INT nq1d,INT ed_or_f);
+void quad_edge(qcoordinates *cqbdry,mesh_struct *mesh,INT nq1d,INT dof);
+void quad_face(qcoordinates *cqbdry,mesh_struct *mesh,INT nq1d,INT dof);
+void dump_qcoords(qcoordinates *q);
+REAL integrate_elm(void (*expr)(REAL *,REAL *,REAL,void *),INT nun,INT comp,INT nq1d,qcoordinates *cq,mesh_struct *mesh,REAL time,INT elm);
+REAL integrate_domain(void (*expr)(REAL *,REAL *,REAL,void *),INT nun,INT comp,INT nq1d,qcoordinates *cq,mesh_struct *mesh,REAL time);
+REAL integrate_face(void (*expr)(REAL *,REAL *,REAL,void *),INT nun,INT comp,INT nq1d,qcoordinates *cq,mesh_struct *mesh,REAL time,INT face);
+REAL integrate_edge(void (*expr)(REAL *,REAL *,REAL,void *),INT nun,INT comp,INT nq1d,qcoordinates *cq,mesh_struct *mesh,REAL time,INT edge);
+REAL integrate_edge_vector_tangent(void (*expr)(REAL *,REAL *,REAL,void *),INT nun,INT comp,INT nq1d,qcoordinates *cq,mesh_struct *mesh,REAL time,INT edge);
+REAL integrate_face_vector_normal(void (*expr)(REAL *,REAL *,REAL,void *),INT nun,INT comp,INT nq1d,qcoordinates *cq,mesh_struct *mesh,REAL time,INT face);
+
+/* In file: src/mesh/mesh_create.c */
+void initialize_mesh(mesh_struct* mesh);
+void creategrid_fread(FILE *gfid,INT file_type,mesh_struct* mesh);
+struct mesh_struct make_uniform_mesh(const INT dim,const INT mesh_ref_levels,const INT mesh_ref_type,const INT set_bndry_codes);
+void build_mesh_all(mesh_struct* mesh);
+struct coordinates *allocatecoords(INT ndof,INT mydim);
+void free_coords(coordinates* A);
+void dump_coords(FILE* fid,coordinates *c);
+void free_mesh(mesh_struct* mesh);
+
+/* In file: src/mesh/mesh_io.c */
+void read_grid_haz(FILE *gfid,mesh_struct *mesh);
+void read_grid_vtk(FILE *gfid,mesh_struct *mesh);
+void dump_mesh_haz(char *namehaz,mesh_struct *mesh);
+void dump_mesh_vtk(char *namevtk,mesh_struct *mesh);
+void create1Dgrid_Line(mesh_struct* mesh,REAL left_end,REAL right_end,INT nelm);
+
+/* In file: src/mesh/mesh_renumber.c */
+void mesh_renumber_vertices(mesh_struct *mesh,
+                            const INT *p,
+                            INT *pel);
+ivector *rcm_el_dof(iCSRmat *el_dof,
+                    const INT ndof);
+void mesh_renumber_rcm(mesh_struct *mesh,
+                       INT *pel);
+ivector *sfc_perm(const INT n,
+                  const INT dim,
+                  const REAL *x,
+                  const SHORT curve);
+void mesh_renumber_sfc(mesh_struct *mesh,
+                       const SHORT curve,
+                       INT *pel);
+
+/* In file: src/mesh/mesh_stats.c */
+iCSRmat convert_elmnode(INT *element_vertex,INT nelm,INT nv,INT nve);
+iCSRmat get_edge_v(INT* nedge,iCSRmat* el_v);
+void boundary_f_ed(iCSRmat* f_ed,iCSRmat* ed_v,INT nedge, INT nface,INT *f_flag,INT *v_flag,INT *nbedge,INT *ed_flag,INT dim);
+iCSRmat get_el_ed(iCSRmat* el_v,iCSRmat* ed_v);
+void edge_stats_all(REAL *ed_len,REAL *ed_tau,REAL *ed_mid,coordinates *cv,iCSRmat* ed_v,INT dim);
+void get_face_ordering(INT el_order,INT dim,INT f_order,INT *fel_order);
+void match_faces(const INT nf,const INT nvf,const INT nv,INT *fv,INT *fmate);
+void get_face_maps(iCSRmat* el_v,INT el_order,iCSRmat* ed_v,INT nface,INT dim,INT f_order,iCSRmat *el_f,INT *f_bdry,INT *nbface,iCSRmat *f_v,iCSRmat *f_ed,INT *fel_order);
+void find_facenumber(iCSRmat* el_v,INT elm,INT* nd,INT dim,INT *f_num);
+void face_stats(REAL *f_area,REAL *f_mid,REAL *f_norm,iCSRmat *f_v,mesh_struct *mesh);
+void sync_facenode(iCSRmat *f_v,REAL* f_norm,mesh_struct *mesh);
+void get_el_mid(REAL *el_mid,iCSRmat* el_v,coordinates *cv,INT dim);
+void get_el_vol(REAL *el_vol,iCSRmat *el_v,coordinates *cv,INT dim,INT v_per_elm);
+
+/* In file: src/mesh/voronoi.c */
+void compute_Voronoi_nodes(mesh_struct* mesh, coordinates* cv_vor);
+void compute_Voronoi_edges(mesh_struct * mesh, coordinates* cv_vor, dvector* vor_edge_length);
+void neighbor_elm (mesh_struct * mesh, INT n, INT m, INT* ind, INT* f);
+void compute_Voronoi_faces(mesh_struct* mesh,coordinates* cv_vor, REAL* pt_on_face, dvector* vor_face_area);
+void compute_Voronoi_volumes(mesh_struct* mesh, coordinates* cv_vor, dvector* vor_face_area, REAL* pt_on_face, dvector* vor_el_vol);
+
+/* In file: src/nonlinear/newton.c */
+void initialize_newton(newton *n_it,input_param *inparam,INT ndof,INT blksize);
+void free_newton(newton* n_it);
+void update_newtonstep(newton* n_it);
+void update_sol_newton(newton *n_it);
+INT check_newton_convergence(newton *n_it);
+void get_residual_norm(newton *n_it);
+void get_update_norm(newton *n_it,fespace* FE,mesh_struct* mesh, qcoordinates* cq);
+void get_blockupdate_norm(newton *n_it,block_fespace* FE,mesh_struct* mesh, qcoordinates* cq);
+void get_newton_forcing(newton *n_it,linear_itsolver_param *itparam);
+void free_newton_precond(newton *n_it);
+INT solve_newton_linear(newton *n_it,linear_itsolver_param *itparam);
+precond *newton_precond_amg(newton *n_it,void *amgparam);
+void newton_precond_amg_free(precond *pc,void *amgparam);
+
+/* In file: src/solver/amg_setup_ua.c */
+SHORT amg_setup_ua (AMG_data *mgl,
+                    AMG_param *param);
+SHORT amg_setup_sa (AMG_data *mgl,
+                    AMG_param *param);
+SHORT famg_setup_ua (AMG_data *mgl,
+                     AMG_param *param);
+SHORT famg_setup_sa (AMG_data *mgl,
+                     AMG_param *param);
+SHORT amg_setup_ua_bsr(AMG_data_bsr  *mgl,
+                      AMG_param     *param);
+SHORT amg_setup_bdcsr(AMG_data_bdcsr  *mgl,
+                      AMG_param     *param);
+SHORT metric_amg_setup_bdcsr(AMG_data_bdcsr  *mgl,
+                            AMG_param     *param);
+INT amg_solve(AMG_data *mgl,
+              AMG_param *param);
+INT amg_solve_amli (AMG_data *mgl,
+                         AMG_param *param);
+INT amg_solve_nl_amli(AMG_data *mgl,
+                      AMG_param *param);
+
+/* In file: src/solver/direct.c */
+INT directsolve_HAZ(dCSRmat *A,
+                    dvector *f,
+                    dvector *x,
+                    INT print_level);
+void* factorize_HAZ(dCSRmat *A,
+                    INT print_level);
+INT solve_HAZ(dCSRmat *A,
+              dvector *f,
+              dvector *x,
+              void *Numeric,
+              INT print_level);
+INT block_directsolve_HAZ(block_dCSRmat *bA,
+                    dvector *f,
+                    dvector *x,
+                    INT print_level);
+void* block_factorize_HAZ(block_dCSRmat *bA,
+                    INT print_level);
+INT block_solve_HAZ(block_dCSRmat *bA,
+              dvector *f,
+              dvector *x,
+              void *Numeric,
+              INT print_level);
+void* hazmath_factorize (dCSRmat *ptrA,
+                         const SHORT prtlvl);
+INT hazmath_solve (dCSRmat *ptrA,
+                   dvector *b,
+                   dvector *u,
+                   void *Numeric,
+                   const SHORT prtlvl);
+INT hazmath_free_numeric (void **Numeric);
+void* amg_coarse_setup (dCSRmat *A,
+                        const SHORT prtlvl);
+INT amg_coarse_solve (void *Numeric,
+                      dvector *b,
+                      dvector *x);
+void amg_coarse_free (void **Numeric);
+void amg_coarse_cache_free (void);
+INT amg_coarse_cache_size (void);
+
+/* In file: itsolver_util.inl */
+INT famg_solve(AMG_data *mgl,
+               AMG_param *param);
+INT amg_solve_famli (AMG_data *mgl,
+                     AMG_param *param);
+
+/* In file: src/solver/fmgcycle.c */
+void fmgcycle(AMG_data *mgl,
+              AMG_param *param);
+void fmgcycle_add_update(AMG_data *mgl,
+                         AMG_param *param);
+void famli(AMG_data *mgl,
+           AMG_param *param,
+           INT level);
+
+/* In file: src/solver/fsmoother.c */
+void smoother_dcsr_fjacobi(dvector *u,
+                           const INT i_1,
+                           const INT i_n,
+                           const INT s,
+                           dCSRmat *A,
+                           dvector *b,
+                           dCSRmat *M,
+                           const REAL p,
+                           const REAL w,
+                           INT L);
+void smoother_dcsr_fgs(dvector *u,
+                       const INT i_1,
+                       const INT i_n,
+                       const INT s,
+                       dCSRmat *A,
+                       dvector *b,
+                       dCSRmat *M,
+                       const REAL p,
+                       INT L);
+void smoother_dcsr_fsgs(dvector *u,
+                        dCSRmat *A,
+                        dvector *b,
+                        dCSRmat *M,
+                        const REAL p,
+                        INT L);
+void do_permutation(ivector *perm,INT n, INT *ia, INT *ja,	\
+		    const SHORT algorithm);
+void numeric_factor_symm(dCSRmat *AU,dCSRmat *U,		\
+			 dvector *adiag,dvector *dinv);
+void *run_hazmath_factorize(dCSRmat *A, INT print_level,	\
+			     void *more_params);
+INT run_hazmath_solve(dCSRmat *A,dvector *f,dvector *x, \
+		      void* Numeric, INT print_level);
+void hazmath_get_numeric(void *Numeric, dCSRmat **U, dvector **dinv, SHORT **extra,dCSRmat **L,ivector **perm);
+INT chk_symmetry(dCSRmat *A);
+
+/* In file: src/solver/itsolver.c */
+INT solver_dcsr_linear_itsolver(dCSRmat *A,
+                                dvector *b,
+                                dvector *x,
+                                precond *pc,
+                                linear_itsolver_param *itparam);
+INT solver_dbsr_linear_itsolver(dBSRmat *A,
+                                dvector *b,
+                                dvector *x,
+                                precond *pc,
+                                linear_itsolver_param *itparam);
+INT solver_bdcsr_linear_itsolver(block_dCSRmat *A,
+                                 dvector *b,
+                                 dvector *x,
+                                 precond *pc,
+                                 linear_itsolver_param *itparam);
+INT solver_general_linear_itsolver(matvec *mxv,
+                                   dvector *b,
+                                   dvector *x,
+                                   precond *pc,
+                                   linear_itsolver_param *itparam);
+INT linear_solver_amg(dCSRmat *A,
+                      dvector *b,
+                      dvector *x,
+                      AMG_param *param);
+INT linear_solver_frac_rational_approx(dCSRmat *A,
+                                       dvector *b,
+                                       dvector *x,
+                                       dCSRmat *M,
+                                       AMG_param *amgparam,
+                                       linear_itsolver_param *itparam,
+                                       dvector *poles_r,
+                                       dvector *poles_i,
+                                       dvector *residues_r,
+                                       dvector *residues_i);
+INT linear_solver_dcsr_krylov(dCSRmat *A,
+                             dvector *b,
+                             dvector *x,
+                             linear_itsolver_param *itparam);
+INT linear_solver_dcsr_krylov_diag(dCSRmat *A,
+                                   dvector *b,
+                                   dvector *x,
+                                   linear_itsolver_param *itparam);
+INT linear_solver_dcsr_krylov_amg(dCSRmat *A,
+                                  dvector *b,
+                                  dvector *x,
+                                  linear_itsolver_param *itparam,
+                                  AMG_param *amgparam);
+INT linear_solver_dcsr_krylov_famg(dCSRmat *A_frac,
+                                   dvector *bb,
+                                   dvector *x,
+                                   dCSRmat *M,
+                                   dCSRmat *A,
+                                   linear_itsolver_param *itparam,
+                                   AMG_param *amgparam);
+INT linear_solver_dcsr_krylov_famg2(dCSRmat *A_frac,
+                                    dvector *bb,
+                                    dvector *x,
+                                    dCSRmat *M,
+                                    dCSRmat *A,
+                                    dCSRmat *Grad,
+                                    linear_itsolver_param *itparam,
+                                    AMG_param *amgparam);
+INT linear_solver_dcsr_krylov_famg_sum(dCSRmat *A_frac,
+                                       dvector *bb,
+                                       dvector *x,
+                                       dCSRmat *M,
+                                       dCSRmat *A,
+                                       const REAL falpha,
+                                       const REAL fbeta,
+                                       linear_itsolver_param *itparam,
+                                       AMG_param *amgparam,
+                                       AMG_param *famgparam);
+INT linear_solver_dcsr_krylov_famg_sum2(dCSRmat *A_frac,
+                                        dvector *bb,
+                                        dvector *x,
+                                        dCSRmat *MS,
+                                        dCSRmat *AS,
+                                        dCSRmat *Mdiv,
+                                        dCSRmat *Adiv,
+                                        dCSRmat *Adivfrac,
+                                        dCSRmat *Grad,
+                                        const REAL falpha,
+                                        const REAL fbeta,
+                                        linear_itsolver_param *itparam,
+                                        AMG_param *amgparam,
+                                        AMG_param *famgparam);
+INT linear_solver_dcsr_krylov_hx_curl(dCSRmat *A,
+                                      dvector *b,
+                                      dvector *x,
+                                      linear_itsolver_param *itparam,
+                                      AMG_param *amgparam,
+                                      dCSRmat *P_curl,
+                                      dCSRmat *Grad);
+INT linear_solver_dcsr_krylov_hx_div(dCSRmat *A,
+                                     dvector *b,
+                                     dvector *x,
+                                     linear_itsolver_param *itparam,
+                                     AMG_param *amgparam,
+                                     dCSRmat *P_curl,
+                                     dCSRmat *P_div,
+                                     dCSRmat *Curl);
+INT linear_solver_dbsr_krylov(dBSRmat *A,
+                              dvector *b,
+                              dvector *x,
+                              linear_itsolver_param *itparam);
+INT linear_solver_dbsr_krylov_diag (dBSRmat    *A,
+                                    dvector    *b,
+                                    dvector    *x,
+                                    linear_itsolver_param  *itparam);
+INT linear_solver_dbsr_krylov_amg(dBSRmat    *A,
+                                  dvector    *b,
+                                  dvector    *x,
+                                  linear_itsolver_param  *itparam,
+                                  AMG_param  *amgparam);
+INT linear_solver_dcsr_krylov_amg_bsr(dCSRmat    *A,
+                                      dvector    *b,
+                                      dvector    *x,
+                                      linear_itsolver_param  *itparam,
+                                      AMG_param  *amgparam,
+                                      const INT   nb);
+INT linear_solver_bdcsr_krylov(block_dCSRmat *A,
+                               dvector *b,
+                               dvector *x,
+                               linear_itsolver_param *itparam);
+INT linear_solver_bdcsr_krylov_amg(block_dCSRmat    *A,
+                                    dvector    *b,
+                                    dvector    *x,
+                                    linear_itsolver_param  *itparam,
+                                    AMG_param  *amgparam,
+                                    dCSRmat *A_diag);
+INT linear_solver_bdcsr_krylov_block_2(block_dCSRmat *A,
+                                       dvector *b,
+                                       dvector *x,
+                                       linear_itsolver_param *itparam,
+                                       AMG_param *amgparam,
+                                       dCSRmat *A_diag);
+INT linear_solver_bdcsr_krylov_block_3(block_dCSRmat *A,
+                                       dvector *b,
+                                       dvector *x,
+                                       linear_itsolver_param *itparam,
+                                       AMG_param *amgparam,
+                                       dCSRmat *A_diag);
+INT linear_solver_bdcsr_krylov_block_4(block_dCSRmat *A,
+                                       dvector *b,
+                                       dvector *x,
+                                       linear_itsolver_param *itparam,
+                                       AMG_param *amgparam,
+                                       dCSRmat *A_diag);
+INT linear_solver_bdcsr_krylov_block_5(block_dCSRmat *A,
+                                       dvector *b,
+                                       dvector *x,
+                                       linear_itsolver_param *itparam,
+                                       AMG_param *amgparam,
+                                       dCSRmat *A_diag);
+INT linear_solver_bdcsr_krylov_block(block_dCSRmat *A,
+                                       dvector *b,
+                                       dvector *x,
+                                       linear_itsolver_param *itparam,
+                                       AMG_param *amgparam,
+                                       dCSRmat *A_diag);
+INT linear_solver_bdcsr_krylov_mixed_darcy(block_dCSRmat *A,
+                                           dvector *b,
+                                           dvector *x,
+                                           linear_itsolver_param *itparam,
+                                           AMG_param *amgparam,
+                                           dCSRmat *P_div,
+                                           dCSRmat *Curl,
+                                           dCSRmat *P_curl,
+                                           dvector *el_vol);
+INT linear_solver_bdcsr_babuska_block_2(block_dCSRmat *A,
+                                        dvector *b,
+                                        dvector *x,
+                                        dCSRmat *AS,
+                                        dCSRmat *MS,
+                                        linear_itsolver_param *itparam,
+                                        AMG_param *amgparam1,
+                                        AMG_param *amgparam2,
+                                        REAL s_frac_power,
+                                        REAL t_frac_power,
+                                        REAL alpha,
+                                        REAL beta,
+                                        REAL scaling_a,
+                                        REAL scaling_m
+                                        );
+INT linear_solver_dcsr_krylov_md_scalar_elliptic(dCSRmat *A,
+                                                 dvector *b,
+                                                 dvector *x,
+                                                 linear_itsolver_param *itparam,
+                                                 AMG_param *amgparam,
+                                                 ivector *pressure_dofs,
+                                                 ivector *mortar_dofs);
+INT linear_solver_bdcsr_krylov_metric_amg(block_dCSRmat    *A,
+                                          dvector    *b,
+                                          dvector    *x,
+                                          linear_itsolver_param  *itparam,
+                                          AMG_param  *amgparam,
+                                          block_dCSRmat *AD,
+                                          block_dCSRmat *M,
+                                          dCSRmat *interface_dof);
+INT linear_solver_bdcsr_krylov_metric_amg_minimal(block_dCSRmat *AA,
+                                                  dvector *b,
+                                                  dvector *x,
+                                                  ivector *interface_dofs,
+                                                  linear_itsolver_param *itparam,
+                                                  AMG_param *amgparam);
+INT linear_solver_dcsr_krylov_metric_amg(dCSRmat *A,
+                                         dvector *b,
+                                         dvector *x,
+                                         ivector *interface_dofs,
+                                         linear_itsolver_param *itparam,
+                                         AMG_param *amgparam);
+
+/* In file: src/solver/krylov.c */
+INT dcsr_pcg (dCSRmat *A,
+              dvector *b,
+              dvector *u,
+              precond *pc,
+              const REAL tol,
+              const INT MaxIt,
+              const SHORT stop_type,
+              const SHORT prtlvl);
+INT dcsr_pcg_w_cond_est(dCSRmat *A,
+                        dvector *b,
+                        dvector *u,
+                        precond *pc,
+                        const REAL tol,
+                        const INT MaxIt,
+                        const SHORT stop_type,
+                        const SHORT prtlvl,
+                        REAL *condest);
+INT dbsr_pcg (dBSRmat     *A,
+              dvector     *b,
+              dvector     *u,
+              precond     *pc,
+              const REAL   tol,
+              const INT    MaxIt,
+              const SHORT  StopType,
+              const SHORT  PrtLvl);
+INT dbsr_pcg_w_cond_est(dBSRmat     *A,
+                         dvector     *b,
+                         dvector     *u,
+                         precond     *pc,
+                         const REAL   tol,
+                         const INT    MaxIt,
+                         const SHORT  StopType,
+                         const SHORT  PrtLvl,
+                         REAL *condest);
+INT bdcsr_pcg (block_dCSRmat *A,
+               dvector *b,
+               dvector *u,
+               precond *pc,
+               const REAL tol,
+               const INT MaxIt,
+               const SHORT stop_type,
+               const SHORT prtlvl);
+INT bdcsr_pcg_w_cond_est(block_dCSRmat *A,
+                         dvector *b,
+                         dvector *u,
+                         precond *pc,
+                         const REAL tol,
+                         const INT MaxIt,
+                         const SHORT stop_type,
+                         const SHORT prtlvl,
+                         REAL *condest);
+INT general_pcg (matvec *mxv,
+                 dvector *b,
+                 dvector *u,
+                 precond *pc,
+                 const REAL tol,
+                 const INT MaxIt,
+                 const SHORT stop_type,
+                 const SHORT prtlvl);
+INT dcsr_pgcg(dCSRmat *A,
+              dvector *b,
+              dvector *u,
+              precond *pc,
+              const REAL tol,
+              const INT MaxIt,
+              const SHORT stop_type,
+              const SHORT print_level);
+INT dcsr_pminres(dCSRmat *A,
+                 dvector *b,
+                 dvector *u,
+                 precond *pc,
+                 const REAL tol,
+                 const INT MaxIt,
+                 const SHORT stop_type,
+                 const SHORT prtlvl);
+INT bdcsr_pminres(block_dCSRmat *A,
+                  dvector *b,
+                  dvector *u,
+                  precond *pc,
+                  const REAL tol,
+                  const INT MaxIt,
+                  const SHORT stop_type,
+                  const SHORT prtlvl);
+INT general_pminres(matvec *mxv,
+                    dvector *b,
+                  dvector *u,
+                  precond *pc,
+                  const REAL tol,
+                  const INT MaxIt,
+                  const SHORT stop_type,
+                  const SHORT prtlvl);
+INT dcsr_pvgmres (dCSRmat *A,
+                  dvector *b,
+                  dvector *x,
+                  precond *pc,
+                  const REAL tol,
+                  const INT MaxIt,
+                  const SHORT restart,
+                  const SHORT stop_type,
+                  const SHORT prtlvl);
+INT dbsr_pvgmres (dBSRmat      *A,
+                  dvector      *b,
+                  dvector      *x,
+                  precond      *pc,
+                  const REAL    tol,
+                  const INT     MaxIt,
+                  const SHORT   restart,
+                  const SHORT   StopType,
+                  const SHORT   PrtLvl);
+INT bdcsr_pvgmres (block_dCSRmat *A,
+                               dvector *b,
+                               dvector *x,
+                               precond *pc,
+                               const REAL tol,
+                               const INT MaxIt,
+                               const SHORT restart,
+                               const SHORT stop_type,
+                               const SHORT prtlvl);
+INT general_pvgmres (matvec *mxv,
+                  dvector *b,
+                  dvector *x,
+                  precond *pc,
+                  const REAL tol,
+                  const INT MaxIt,
+                  const SHORT restart,
+                  const SHORT stop_type,
+                  const SHORT prtlvl);
+INT dcsr_pvfgmres(dCSRmat *A,
+                  dvector *b,
+                  dvector *x,
+                  precond *pc,
+                  const REAL tol,
+                  const INT MaxIt,
+                  const SHORT restart,
+                  const SHORT stop_type,
+                  const SHORT prtlvl);
+INT dbsr_pvfgmres (dBSRmat      *A,
+                   dvector      *b,
+                   dvector      *x,
+                   precond      *pc,
+                   const REAL    tol,
+                   const INT     MaxIt,
+                   const SHORT   restart,
+                   const SHORT   StopType,
+                   const SHORT   PrtLvl);
+INT bdcsr_pvfgmres(block_dCSRmat *A,
+                   dvector *b,
+                   dvector *x,
+                   precond *pc,
+                   const REAL tol,
+                   const INT MaxIt,
+                   const SHORT restart,
+                   const SHORT stop_type,
+                   const SHORT prtlvl);
+INT general_pvfgmres(matvec *mxv,
+                     dvector *b,
+                     dvector *x,
+                     precond *pc,
+                     const REAL tol,
+                     const INT MaxIt,
+                     const SHORT restart,
+                     const SHORT stop_type,
+                     const SHORT prtlvl);
+
+/* In file: src/solver/mgcycle.c */
+void mgcycle(AMG_data *mgl,
+             AMG_param *param);
+void amli(AMG_data *mgl,
+          AMG_param *param,
+          INT level);
+void nl_amli (AMG_data *mgl,
+              AMG_param *param,
+              INT level,
+              INT num_levels);
+void mgcycle_add(AMG_data *mgl,
+                 AMG_param *param);
+void mgcycle_add_update(AMG_data *mgl,
+                 AMG_param *param);
+void mgcycle_bsr (AMG_data_bsr  *mgl,
+                              AMG_param     *param);
+void mgcycle_bdcsr (AMG_data_bdcsr  *mgl,
+                    AMG_param     *param);
+void mgcycle_bdcsr_metric(AMG_data_bdcsr  *mgl,
+                          AMG_param     *param);
+void cascadic_eigen(AMG_data *mgl,
+                    AMG_param *param,
+                    INT level,
+                    const INT num_eigen);
+
+/* In file: src/solver/precond.c */
+
+/* In file: itsolver_util.inl */
+void precond_diag (REAL *r,
+                        REAL *z,
+                        void *data);
+void precond_amg(REAL *r,
+                 REAL *z,
+                 void *data);
+void precond_famg(REAL *r,
+                  REAL *z,
+                  void *data);
+void precond_amli(REAL *r,
+                  REAL *z,
+                  void *data);
+void precond_famli(REAL *r,
+                   REAL *z,
+                   void *data);
+void precond_nl_amli(REAL *r,
+                     REAL *z,
+                     void *data);
+void precond_amg_add(REAL *r,
+                 REAL *z,
+                 void *data);
+void precond_famg_add(REAL *r,
+                      REAL *z,
+                      void *data);
+void precond_famg_add2(REAL *r,
+                       REAL *z,
+                       void *data);
+void precond_sum_famg_add(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_sum_famg_add2(REAL *r,
+                           REAL *z,
+                           void *data);
+void precond_hx_curl_additive(REAL *r,
+                              REAL *z,
+                              void *data);
+void precond_hx_curl_multiplicative(REAL *r,
+                                    REAL *z,
+                                    void *data);
+void precond_hx_div_additive_2D(REAL *r,
+                                REAL *z,
+                                void *data);
+void precond_hx_div_multiplicative_2D(REAL *r,
+                                      REAL *z,
+                                      void *data);
+void precond_hx_div_additive(REAL *r,
+                              REAL *z,
+                              void *data);
+void precond_hx_div_multiplicative(REAL *r,
+                              REAL *z,
+                              void *data);
+void precond_dbsr_diag (REAL *r,
+                        REAL *z,
+                        void *data);
+void precond_dbsr_amg(REAL *r,
+                      REAL *z,
+                      void *data);
+void precond_bdcsr_amg(REAL *r,
+                       REAL *z,
+                       void *data);
+void precond_block_diag_2(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag_2_amg(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag_2_amg_krylov(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_lower_2(REAL *r,
+                           REAL *z,
+                           void *data);
+void precond_block_lower_2_amg(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_lower_2_amg_krylov(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_upper_2(REAL *r,
+                           REAL *z,
+                           void *data);
+void precond_block_upper_2_amg(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_upper_2_amg_krylov(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag_3(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag_3_amg(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag_3_amg_krylov(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_lower_3(REAL *r,
+                           REAL *z,
+                           void *data);
+void precond_block_lower_3_amg(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_lower_3_amg_krylov(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_upper_3(REAL *r,
+                           REAL *z,
+                           void *data);
+void precond_block_upper_3_amg(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_upper_3_amg_krylov(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag_4(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag_4_amg(REAL *r,
+                              REAL *z,
+                              void *data);
+void precond_block_diag_4_amg_krylov(REAL *r,
+                                     REAL *z,
+                                     void *data);
+void precond_block_lower_4(REAL *r,
+                           REAL *z,
+                           void *data);
+void precond_block_lower_4_amg(REAL *r,
+                               REAL *z,
+                               void *data);
+void precond_block_lower_4_amg_krylov(REAL *r,
+                                      REAL *z,
+                                      void *data);
+void precond_block_upper_4(REAL *r,
+                           REAL *z,
+                           void *data);
+void precond_block_upper_4_amg(REAL *r,
+                               REAL *z,
+                               void *data);
+void precond_block_upper_4_amg_krylov(REAL *r,
+                                      REAL *z,
+                                      void *data);
+void precond_block_diag_5_amg_krylov(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_diag(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_lower(REAL *r,
+                          REAL *z,
+                          void *data);
+void precond_block_upper(REAL *r,
+                         REAL *z,
+                         void *data);
+void precond_block_diag_mixed_darcy(REAL *r,
+                                    REAL *z,
+                                    void *data);
+void precond_block_lower_mixed_darcy(REAL *r,
+                                    REAL *z,
+                                    void *data);
+void precond_block_upper_mixed_darcy(REAL *r,
+                                     REAL *z,
+                                     void *data);
+void precond_block_diag_mixed_darcy_krylov(REAL *r,
+                                           REAL *z,
+                                           void *data);
+void precond_block_lower_mixed_darcy_krylov(REAL *r,
+                                            REAL *z,
+                                            void *data);
+void precond_block_upper_mixed_darcy_krylov(REAL *r,
+                                            REAL *z,
+                                            void *data);
+void precond_block_diag_mixed_darcy_lap(REAL *r,
+                                    REAL *z,
+                                    void *data);
+void precond_block_diag_mixed_darcy_krylov_HX(REAL *r,
+                                              REAL *z,
+                                              void *data);
+void precond_block_lower_mixed_darcy_krylov_HX(REAL *r,
+                                               REAL *z,
+                                               void *data);
+void precond_block_upper_mixed_darcy_krylov_HX(REAL *r,
+                                               REAL *z,
+                                               void *data);
+void precond_block_lower_mixed_darcy_lap(REAL *r,
+                                    REAL *z,
+                                    void *data);
+void precond_block_upper_mixed_darcy_lap(REAL *r,
+                                     REAL *z,
+                                     void *data);
+void precond_block_ilu_mixed_darcy_lap(REAL *r,
+                                       REAL *z,
+                                       void *data);
+void precond_block_diag_mixed_darcy_lap_krylov(REAL *r,
+                                           REAL *z,
+                                           void *data);
+void precond_block_lower_mixed_darcy_lap_krylov(REAL *r,
+                                            REAL *z,
+                                            void *data);
+void precond_block_upper_mixed_darcy_lap_krylov(REAL *r,
+                                            REAL *z,
+                                            void *data);
+void precond_block_ilu_mixed_darcy_lap_krylov(REAL *r,
+                                            REAL *z,
+                                            void *data);
+void precond_block_ilu_mixed_darcy_graph_lap_krylov(REAL *r,
+                                            REAL *z,
+                                            void *data);
+void precond_block_diag_3d1d(REAL *r,
+                             REAL *z,
+                             void *data);
+void precond_block2_babuska_diag(REAL *r,
+                                 REAL *z,
+                                 void *data);
+void precond_block2_babuska_lower(REAL *r,
+                                  REAL *z,
+                                  void *data);
+void precond_block2_babuska_upper(REAL *r,
+                                  REAL *z,
+                                  void *data);
+void precond_ra_fenics(REAL *r, REAL *z, void *data);
+void precond_bdcsr_metric_amg_exact(REAL *r,
+                       REAL *z,
+                       void *data);
+void precond_bdcsr_metric_amg_exact_additive(REAL *r,
+                       REAL *z,
+                       void *data);
+void precond_bdcsr_metric_amg(REAL *r,
+                       REAL *z,
+                       void *data);
+void precond_bdcsr_metric_amg_additive(REAL *r,
+                       REAL *z,
+                       void *data);
+void precond_bdcsr_metric_amg_symmetric(REAL *r,
+                       REAL *z,
+                       void *data);
+
+/* In file: src/solver/Schwarz_setup.c */
+INT Schwarz_setup(Schwarz_data *Schwarz,
+		  Schwarz_param *param,
+		  ivector *seeds_in);
+
+/* In file: src/solver/smoother.c */
+void smoother_dcsr_jacobi(dvector *u,
+                          const INT i_1,
+                          const INT i_n,
+                          const INT s,
+                          dCSRmat *A,
+                          dvector *b,
+                          INT L);
+void smoother_dcsr_gs(dvector *u,
+                      const INT i_1,
+                      const INT i_n,
+                      const INT s,
+                      dCSRmat *A,
+                      dvector *b,
+                      INT L);
+void smoother_dcsr_sgs(dvector *u,
+                       dCSRmat *A,
+                       dvector *b,
+                       INT L);
+void smoother_dcsr_sor(dvector *u,
+                       const INT i_1,
+                       const INT i_n,
+                       const INT s,
+                       dCSRmat *A,
+                       dvector *b,
+                       INT L,
+                       const REAL w);
+void smoother_dcsr_L1diag(dvector *u,
+                          const INT i_1,
+                          const INT i_n,
+                          const INT s,
+                          dCSRmat *A,
+                          dvector *b,
+                          INT L);
+void smoother_dcsr_Schwarz_forward (Schwarz_data  *Schwarz,
+                                    Schwarz_param *param,
+                                    dvector       *x,
+                                    dvector       *b);
+void smoother_dcsr_Schwarz_forward_additive (Schwarz_data  *Schwarz,
+                                    Schwarz_param *param,
+                                    dvector       *x,
+                                    dvector       *b,
+                                    REAL       w);
+void smoother_dcsr_Schwarz_backward (Schwarz_data *Schwarz,
+                                     Schwarz_param *param,
+                                     dvector *x,
+                                     dvector *b);
+void smoother_dcsr_Schwarz_backward_additive (Schwarz_data *Schwarz,
+                                     Schwarz_param *param,
+                                     dvector *x,
+                                     dvector *b,
+                                     REAL w);
+void smoother_dbsr_jacobi(dBSRmat *A,
+                          dvector *b,
+                          dvector *u,
+                          REAL    *diaginv);
+void smoother_dbsr_gs_ascend(dBSRmat *A,
+                             dvector *b,
+                             dvector *u,
+                             REAL    *diaginv);
+void smoother_dbsr_gs_descend(dBSRmat *A,
+                              dvector *b,
+                              dvector *u,
+                              REAL    *diaginv );
+void smoother_bdcsr_jacobi_jacobi(dvector *u,
+                                  block_dCSRmat *A,
+                                  dvector *b,
+                                  dCSRmat *A_diag);
+void smoother_bdcsr_jacobi_fgs(dvector *u,
+                               block_dCSRmat *A,
+                               dvector *b,
+                               dCSRmat *A_diag);
+void smoother_bdcsr_jacobi_bgs(dvector *u,
+                               block_dCSRmat *A,
+                               dvector *b,
+                               dCSRmat *A_diag);
+void smoother_bdcsr_jacobi_sgs(dvector *u,
+                               block_dCSRmat *A,
+                               dvector *b,
+                               dCSRmat *A_diag);
+void smoother_bdcsr_fgs_fgs(dvector *u,
+                            block_dCSRmat *A,
+                            dvector *b,
+                            dCSRmat *A_diag,
+                            REAL *work);
+void smoother_bdcsr_fgs_sgs(dvector *u,
+                            block_dCSRmat *A,
+                            dvector *b,
+                            dCSRmat *A_diag,
+                            REAL *work);
+void smoother_bdcsr_bgs_bgs(dvector *u,
+                            block_dCSRmat *A,
+                            dvector *b,
+                            dCSRmat *A_diag,
+                            REAL *work);
+void smoother_bdcsr_bgs_sgs(dvector *u,
+                            block_dCSRmat *A,
+                            dvector *b,
+                            dCSRmat *A_diag,
+                            REAL *work);
+void smoother_bdcsr_metric_additive(dvector *u,
+                                    block_dCSRmat *A,
+                                    dvector *b,
+                                    dCSRmat *A_diag,
+                                    REAL *work,
+                                    dCSRmat *interface_dof,
+                                    block_dCSRmat * A_gamma);
+void smoother_bdcsr_metric_additive_bsr(dvector *u,
+                                        block_dCSRmat *A,
+                                        dvector *b,
+                                        dCSRmat *A_diag,
+                                        REAL *work,
+                                        dCSRmat *interface_dof,
+                                        dBSRmat * A_gamma,
+                                        REAL    *diaginv);
+void smoother_bdcsr_metric_multiplicative_omega_gamma(dvector *u,
+                                                      block_dCSRmat *A,
+                                                      dvector *b,
+                                                      dCSRmat *A_diag,
+                                                      REAL *work,
+                                                      dCSRmat *interface_dof,
+                                                      block_dCSRmat * A_gamma);
+void smoother_bdcsr_metric_multiplicative_omega_gamma_bsr(dvector *u,
+                                                          block_dCSRmat *A,
+                                                          dvector *b,
+                                                          dCSRmat *A_diag,
+                                                          REAL *work,
+                                                          dCSRmat *interface_dof,
+                                                          dBSRmat * A_gamma,
+                                                          REAL *diaginv);
+void smoother_bdcsr_metric_multiplicative_gamma_omega(dvector *u,
+                                        block_dCSRmat *A,
+                                          dvector *b,
+                                          dCSRmat *A_diag,
+                                          REAL *work,
+                                          dCSRmat *interface_dof,
+                                          block_dCSRmat * A_gamma);
+void smoother_bdcsr_metric_multiplicative_gamma_omega_bsr(dvector *u,
+                                                          block_dCSRmat *A,
+                                                          dvector *b,
+                                                          dCSRmat *A_diag,
+                                                          REAL *work,
+                                                          dCSRmat *interface_dof,
+                                                          dBSRmat * A_gamma,
+                                                          REAL    *diaginv);
+void smoother_dcsr_gs_graph_eigen(dvector *u,
+                                  dCSRmat *A,
+                                  dvector *b,
+                                  const INT i_1,
+                                  const INT i_n,
+                                  const INT s,
+                                  const INT nsmooth,
+                                  const INT num_eigen);
+void smoother_dcsr_sgs_graph_eigen(dvector *u, dCSRmat *A, dvector *b, const INT nsmooth, const INT num_eigen);
+void smoother_dcsr_Schwarz(const Schwarz_data *Schwarz,		\
+			   dvector *x_in,			\
+			   const dvector *b_in,			\
+			   const INT maxiter);
+
+/* In file: src/solver/Schwarz_setup.c */
+INT ySchwarz_setup(Schwarz_data *Schwarz,
+		   Schwarz_param *param);
+INT ySchwarz_setup_with_seeds(Schwarz_data *Schwarz,
+			      Schwarz_param *param,
+			      ivector *seeds);
+
+/* In file: src/utilities/array.c */
+INT darray_max(INT n, const REAL *u);
+INT darray_min(INT n, const REAL *u);
+INT iarray_max(INT n, const INT *u);
+INT iarray_min(INT n, const INT *u);
+INT locate0(INT needle, const INT *haystack, INT n);
+INT iarray_locate (INT needle,
+                   const INT *a,
+                   INT n);
+void array_set (const INT n,
+                REAL *x,
+                const REAL val);
+void iarray_set (const INT n,
+                 INT *x,
+                 const INT val);
+void array_cp (const INT n,
+               REAL *x,
+               REAL *y);
+void iarray_cp (const INT n,
+                INT *x,
+                INT *y);
+void array_shuffle(const INT n,
+                   REAL *x);
+void iarray_shuffle(const INT n,
+                   INT *x);
+void array_ax (const INT n,
+               const REAL a,
+               REAL *x);
+void array_axpy (const INT n,
+                 const REAL a,
+                 REAL *x,
+                 REAL *y);
+void array_axpyz (const INT n,
+                  const REAL a,
+                  REAL *x,
+                  REAL *y,
+                  REAL *z);
+void array_axpby (const INT n,
+                  const REAL a,
+                  REAL *x,
+                  const REAL b,
+                  REAL *y);
+REAL array_dotprod (const INT n,
+                    const REAL * x,
+                    const REAL * y);
+REAL array_norm1 (const INT n,
+                  const REAL * x);
+REAL array_norm2 (const INT n,
+                  const REAL * x);
+REAL array_norminf (const INT n,
+                    const REAL * x);
+REAL array_normp(const INT n,
+                 const REAL * x,
+                 const INT p);
+void det3D(REAL *mydet,
+           REAL* vec1,
+           REAL* vec2,
+           REAL* vec3);
+void cross_product(REAL* u, REAL* v, REAL* cross, REAL* mag);
+void ld2d(REAL *dest,REAL16 *src, const INT n);
+void d2ld(REAL16 *dest,REAL *src, const INT n);
+INT array_uniq(const INT n,INT *a);
+INT array_cap(const INT n1i,const INT *a1i,	\
+	       const INT n2i, const INT *a2i,		\
+	       INT *acap, INT *wrk);
+
+/* In file: src/utilities/coefficient.c */
+void constant_coeff_scal(REAL *val,
+                         REAL *x,
+                         REAL constval,
+                         void *param);
+void constant_coeff_vec2D(REAL *val,
+                          REAL *x,
+                          REAL constval,
+                          void *param);
+void constant_coeff_vec3D(REAL *val,
+                          REAL *x,
+                          REAL constval,
+                          void *param);
+void zero_coeff_scal(REAL *val,
+                     REAL *x,
+                     REAL time,
+                     void *param);
+void zero_coeff_vec2D(REAL *val,
+                      REAL *x,
+                      REAL time,
+                      void *param);
+void zero_coeff_vec3D(REAL *val,
+                      REAL *x,
+                      REAL time,
+                      void *param);
+void one_coeff_scal(REAL *val,
+                    REAL *x,
+                    REAL time,
+                    void *param);
+void one_coeff_vec2D(REAL *val,
+                     REAL *x,
+                     REAL time,
+                     void *param);
+void one_coeff_vec3D(REAL *val,
+                     REAL *x,
+                     REAL time,
+                     void *param);
+
+/* In file: src/utilities/data.c */
+void precond_data_null (precond_data *pcdata);
+AMG_data *amg_data_create(SHORT max_levels);
+void amg_data_free(AMG_data *mgl,
+                   AMG_param *param);
+AMG_data_bsr * amg_data_bsr_create (SHORT max_levels);
+void amg_data_bsr_free (AMG_data_bsr *mgl);
+AMG_data_bdcsr *amg_data_bdcsr_create(SHORT max_levels);
+void amg_data_bdcsr_free (AMG_data_bdcsr *mgl,
+                          AMG_param *param);
+void HX_curl_data_null (HX_curl_data *hxcurldata);
+void HX_curl_data_free (HX_curl_data *hxcurldata,
+                        SHORT flag);
+void HX_div_data_null (HX_div_data *hxdivdata);
+void HX_div_data_free (HX_div_data *hxdivdata,
+                        SHORT flag);
+void schwarz_data_init(Schwarz_data *Schwarz);
+void schwarz_data_free(Schwarz_data *schwarzdata);
+void precond_null(precond *pcdata);
+void precond_block_data_null(precond_block_data *precdata);
+void precond_block_data_free(precond_block_data *precdata,
+                             const INT nb,
+                             SHORT flag);
+void amli_coef_free(AMG_param *param);
+void precond_ra_data_free(precond_ra_data *precdata);
+void precond_data_free(precond_data *precdata);
+void precond_data_bdcsr_free(precond_data_bdcsr *precdata);
+
+/* In file: src/utilities/dense.c */
+dDENSEmat ddense_create(const INT n,
+                        const INT m);
+void ddense_alloc(const INT n,
+                  const INT m,
+                  dDENSEmat *A);
+void ddense_set(dDENSEmat *A,
+                REAL val);
+void ddense_free(dDENSEmat *A);
+void ddense_cp(dDENSEmat *A,
+               dDENSEmat *B);
+dDENSEmat ddense_random_JL(const INT k,
+                           const INT d);
+void find_det_4( REAL* A, REAL* deta);
+void ddense_gemm(const INT m,
+		 const INT n,
+		 const INT k,
+		 const REAL alpha,
+		 const REAL *A,
+		 const INT lda,
+		 const REAL *B,
+		 const INT ldb,
+		 REAL *C,
+		 const INT ldc);
+INT ddense_solve_pivot(INT dopivot, INT n, REAL *A, REAL *b, INT *p,REAL *piv);
+SHORT ddense_lu(INT dopivot, INT n, REAL *deta, REAL *A,INT *p,REAL *piv);
+void ddense_inv(REAL *Ainv,INT n, REAL *A, void *wrk);
+void ddense_inv_l(REAL16 *Ainv,INT n, REAL16 *A, void *wrk);
+void abybfull(const INT m, const INT p, REAL *c,	\
+	      REAL *a, REAL *b, const INT n);
+void ddense_abyv(const INT m, REAL *y,REAL *a, REAL *x, const INT n);
+void ddense_atbyv(const INT m, REAL *y,REAL *a, REAL *x, const INT n);
+void ddense_qr(const INT m, const INT n, REAL *A, REAL *Q, REAL *R);
+INT ddense_svd(INT m, INT n, REAL *A, REAL *U, REAL *VT, REAL* S,INT computeUV);
+INT ddense_qr_lapack(INT m,INT n, REAL *A,REAL * Q,REAL *R,INT computeR);
+void col_2_row(const INT n, const INT m, const size_t sizeel, void *x);
+void row_2_col(const INT n, const INT m, const size_t sizeel, void *x);
+INT ddense_solve_pivot_l(INT dopivot,			\
+			 INT n,				\
+			 REAL16 *A,			\
+			 REAL16 *b,			\
+			 INT *p,			\
+			 REAL16 *piv);
+INT zdense_solve_pivot_l(INT n,				\
+			 REAL16 *Ar,			\
+			 REAL16 *Ai,			\
+			 REAL16 *br,			\
+			 REAL16 *bi);
+void ddense_axm (REAL       *a,
+                 const INT   n,
+                 const REAL  alpha);
+void ddense_add (const REAL  *a,
+                 const REAL  *b,
+                 const INT    n,
+                 const REAL   alpha,
+                 const REAL   beta,
+                 REAL        *c);
+void ddense_mxv (const REAL  *a,
+                 const REAL  *b,
+                 REAL        *c,
+                 const INT    n);
+void ddense_mul (const REAL  *a,
+                 const REAL  *b,
+                 REAL        *c,
+                 const INT    n);
+void ddense_ypAx (const REAL  *A,
+                  const REAL  *x,
+                  REAL        *y,
+                  const INT    n);
+void ddense_ymAx (const REAL  *A,
+                  const REAL  *x,
+                  REAL        *y,
+                  const INT    n);
+void ddense_aAxpby (const REAL   alpha,
+                    const REAL  *A,
+                    const REAL  *x,
+                    const REAL   beta,
+                    REAL        *y,
+                    const INT    n);
+void ddense_inv_inplace (REAL      *a,
+                         const INT  n);
+REAL ddense_Linf (const REAL  *A,
+                     const INT    n);
+void ddense_identity (REAL      *a,
+                      const INT  n,
+                      const INT  n2);
+
+/* In file: src/utilities/format.c */
+dCSRmat bdcsr_2_dcsr (block_dCSRmat *Ab);
+dCSRmat bdcsr_subblk_2_dcsr (block_dCSRmat *Ab, INT brow_start, INT brow_end, INT bcol_start, INT bcol_end);
+dBSRmat bdcsr_2_dbsr(block_dCSRmat *Ab);
+block_dCSRmat dcsr_2_bdcsr (dCSRmat *A,
+                            INT bnum,
+                            INT *bsize);
+SHORT dcoo_2_dcsr (dCOOmat *A,
+                   dCSRmat *B);
+SHORT dcsr_2_dcoo (dCSRmat *A,
+		   dCOOmat *B);
+SHORT dcsr_unique (dCSRmat *A);
+coordinates* array_2_coord ( REAL* xyz, INT ndof, INT dim);
+dCSRmat dbsr_2_dcsr (const dBSRmat *B);
+dBSRmat dcsr_2_dbsr(const dCSRmat  *A,
+                    const INT       nb);
+dSELLmat dcsr_2_dsell(const dCSRmat *A,
+                      const INT C,
+                      const INT sigma);
+INT dcsr_detect_block(const dCSRmat *A,
+                      const INT nb_in,
+                      ivector *perm);
+dCSRmat *dcoo_2_dcsr_p (dCOOmat *A);
+
+/* In file: src/utilities/graph_utils.c */
+void push_in(stack* s, INT item);
+INT pop_out(stack* s);
+INT get_top(stack *s);
+void topo_sort(dCSRmat *a);
+
+/* In file: src/utilities/input.c */
+void param_input (const char *filenm,		\
+                  input_param *inparam);
+
+/* In file: src/utilities/io.c */
+INT chkn(INT n, const INT nmin, const INT nmax);
+void iarray_print(INT *vec,
+                  INT n);
+void array_print(REAL *vec,
+                 INT n);
+void ivector_write(const char *filename,
+                   ivector *vec);
+void dvector_print(FILE* fid,
+                   dvector *b);
+void dvector_write (const char *filename,
+                    dvector *vec);
+void dvector_read (const char *filename,
+                   dvector *b);
+void ivector_print(FILE* fid,
+                   ivector *b);
+void print_full_mat(const  INT n, const INT m, REAL *A,const char *varname);
+void print_full_mat_l(const  INT n, const INT m, REAL16 *A,const char *varname);
+void print_full_mat_int(const  INT n, const INT m, INT *A,const char *varname);
+void csr_print_matlab(FILE* fid,
+                      dCSRmat *A);
+void bdcsr_print_matlab(FILE* fid,
+                        block_dCSRmat *A);
+void scomplex_print_matlab(const char *fname,scomplex *sc);
+void csr_print_native(FILE* fid,
+                      dCSRmat *A, dvector *rhs);
+void icsr_print_matlab(FILE* fid,
+                       iCSRmat *A);
+void icsr_print_rows(FILE* fid,
+		     iCSRmat *A,const char *sname);
+void icsr_print_matlab_val(FILE* fid,
+			   iCSRmat *A);
+void dvec_write (const char *filename,
+                 dvector *vec);
+void ivec_write (const char *filename,
+                 ivector *vec);
+void ddense_write(const char *filename,
+                  dDENSEmat *A);
+void dcsr_write_dcoo (const char *filename,
+                      dCSRmat *A);
+void icsr_write_icoo (const char *filename,
+                      iCSRmat *A);
+void bdcsr_write_dcoo(const char *filename,
+                      block_dCSRmat *A);
+void dcoo_read_dcsr (const char *filename,
+                     dCSRmat *A);
+void dbsr_read (const char  *filename,
+                dBSRmat     *A);
+void read_eof(const char *fname, void **data, INT *ndata, const char dtype,const SHORT print_level);
+void rveci_(FILE *fp,INT *vec,INT *nn);
+void rvecd_(FILE *fp,
+            REAL *vec,
+            INT *nn);
+FILE* HAZ_fopen(char *fname, char *mode );
+void vtu_set_format(const SHORT format,
+                    const SHORT compress);
+vtu_writer *vtu_open(const char *namevtk);
+void vtu_darray(vtu_writer *w,
+                const char *name,
+                const INT ncomp,
+                const REAL *x,
+                const INT n);
+void vtu_iarray(vtu_writer *w,
+                const char *name,
+                const INT *ix,
+                const INT n);
+void vtu_close(vtu_writer *w);
+void dump_sol_onV_vtk(char *namevtk,
+                      mesh_struct *mesh,
+                      REAL *sol,
+                      INT ncomp);
+void dump_sol_vtk(char *namevtk,char *varname,mesh_struct *mesh,fespace *FE,REAL *sol);
+void dump_blocksol_vtk(char *namevtk,char **varname,mesh_struct *mesh,block_fespace *FE,REAL *sol);
+void create_pvd(char *namepvd, INT nfiles,char *vtkfilename,char *filetype);
+void debug_print(char* string, INT kill);
+scomplex *hazr(char *namein);
+void hazw(char *nameout,scomplex *sc, const INT shift);
+void mshw(char *namemsh,scomplex *sc, const INT shift0);
+void matlw(scomplex *sc, char *namematl);
+void print_matlab_vector_field(dvector* ux, dvector* uy, dvector* uz, fespace* FE );
+dCSRmat *dcoo_read_eof_dcsr_p(const char *fname,const INT *size,const unsigned char format);
+dvector *dvector_read_eof_p(const char *fname, const unsigned char format);
+ivector *ivector_read_eof_p(const char *fname, const unsigned char format);
+dCSRmat *dcoo_read_dcsr_p(FILE *fp);
+dCSRmat *dcoo_read_dcsr_p_1(FILE *fp);
+dvector *dvector_read_p(FILE *fp);
+INT features_r(features *feat,scomplex *sc, const INT do_map, const REAL scale);
+void read_npy_eof(const char *fname, void **data, INT *ndata, const char dtype,const SHORT print_level);
+
+/* In file: src/utilities/message.c */
+void print_itsolver_info(const INT  print_lvl,
+                         const INT  stop_type,
+                         const INT  iter,
+                         const REAL rel_res,
+                         const REAL abs_res,
+                         const REAL factor);
+void print_cputime(const char *message,
+                   const REAL cputime);
+void print_message(const INT print_lvl,
+                   const char *message);
+void print_amg_complexity(AMG_data *mgl,
+                          const SHORT print_lvl);
+void print_amgcomplexity_bsr(const AMG_data_bsr  *mgl,
+                             const SHORT          prtlvl);
+void check_error(const SHORT status,
+                 const char *func_name);
+void error_extlib(const SHORT status, const char *func_name, \
+		  const char *lib_name);
+
+/* In file: src/utilities/parameters.c */
+void param_input_init (input_param *inparam);
+void param_amg_init (AMG_param *amgparam);
+void param_Schwarz_init (Schwarz_param *schparam);
+void param_linear_solver_init (linear_itsolver_param *itsparam);
+void param_linear_solver_set (linear_itsolver_param *itsparam,
+                       input_param *inparam);
+void param_amg_set (AMG_param *amgparam,
+                    input_param *inparam);
+void param_amg_cp (AMG_param *amgparam1,
+                   AMG_param *amgparam2);
+void param_Schwarz_set (Schwarz_param *schparam,
+                             input_param *inparam);
+void param_linear_solver_print (linear_itsolver_param *itsparam);
+void param_amg_print (AMG_param *amgparam);
+void param_Schwarz_print (Schwarz_param *schparam);
+void param_amg_to_prec (precond_data *pcdata,
+                        AMG_param *amgparam);
+void param_prec_to_amg (AMG_param *amgparam,
+                        precond_data *pcdata);
+void param_amg_to_schwarz (Schwarz_param *schparam,
+                           AMG_param *amgparam);
+void amg_amli_coef (const REAL lambda_max,
+                    const REAL lambda_min,
+                    const INT degree,
+                    REAL *coef);
+
+/* In file: src/utilities/sorting.c */
+void dlexsort(const INT nr, const INT nc,REAL *a,INT *p);
+void ilexsort(const INT nr, const INT nc,INT *a,INT *p);
+void isi_sort(INT n, INT *a);
+void dsi_sort(INT n, REAL *a);
+void qsi_sort(INT n, REAL16 *a);
+void isi_sortp(const INT n, INT *a, INT *p, INT *invp);
+void dsi_sortp(const INT n, REAL *a, INT *p, INT *invp);
+
+/* In file: src/utilities/sparse.c */
+dCSRmat dcsr_create (const INT m,
+                     const INT n,
+                     const INT nnz);
+dCSRmat dcsr_create_zeromatrix(const INT m,
+                               const INT n,
+                               const INT index_start);
+dCSRmat dcsr_create_fullmatrix(const INT m,
+                               const INT n);
+void dcsr_set_zeromatrix(dCSRmat *A,
+                         const INT m,
+                         const INT n,
+                         const INT index_start);
+dCSRmat dcsr_create_single_nnz_matrix(const INT m,
+                                      const INT n,
+                                      const INT row,
+                                      const INT col,
+                                      const REAL val,
+                                      const INT index_start);
+dCSRmat dcsr_create_identity_matrix(const INT m,
+                                    const INT index_start);
+void dcsr_alloc(const INT m,
+                const INT n,
+                const INT nnz,
+                dCSRmat *A);
+void dcsr_realloc(const INT m,
+		  const INT n,
+		  const INT nnz,
+		  dCSRmat *A);
+void icsr_realloc(const INT m,
+		  const INT n,
+		  const INT nnz,
+		  iCSRmat *A);
+dCOOmat dcoo_create (INT m,
+                     INT n,
+                     INT nnz);
+void dcoo_alloc (const INT m,
+                 const INT n,
+                 const INT nnz,
+                 dCOOmat *A);
+void dcoo_free (dCOOmat *A);
+void icoo_free (iCOOmat *A);
+iCSRmat icsr_create(const INT m,
+                    const INT n,
+                    const INT nnz);
+iCSRmat icsr_create_identity(const INT m,
+                             const INT index_start);
+void dcsr_free(dCSRmat *A);
+void icsr_free(iCSRmat *A);
+void dcsr_null(dCSRmat *A);
+void icsr_null(iCSRmat *A);
+dCSRmat dcsr_perm(dCSRmat *A,
+                  INT *P);
+void icsr_cp(iCSRmat *A,
+             iCSRmat *B);
+void dcsr_cp(dCSRmat *A,
+             dCSRmat *B);
+INT dcsr_trans(dCSRmat *A,
+               dCSRmat *AT);
+void dcsr_transz (dCSRmat *A,
+                  INT *p,
+                  dCSRmat *AT);
+void icsr_trans(iCSRmat *A,
+                iCSRmat *AT);
+void icsr_concat(iCSRmat* A,
+                 iCSRmat* B,
+                 iCSRmat* C);
+void dcsr_compress(dCSRmat *A,
+                   dCSRmat *B,
+                   REAL dtol);
+SHORT dcsr_compress_inplace(dCSRmat *A,
+                            REAL dtol);
+void dcsr_shift(dCSRmat *A,
+                INT offset);
+void icsr_shift(iCSRmat *A,
+                INT offset);
+INT dcsr_add(dCSRmat *A,
+             const REAL alpha,
+             dCSRmat *B,
+             const REAL beta,
+             dCSRmat *C);
+void dcsr_axm(dCSRmat *A,
+              const REAL alpha);
+void dcsr_mxv(dCSRmat *A,
+              REAL *x,
+              REAL *y);
+void dcsr_mxv_forts(void *At,
+                      REAL *x,
+                      REAL *y);
+void dcsr_mxv_agg(dCSRmat *A,
+                  REAL *x,
+                  REAL *y);
+void dcsr_aAxpy(const REAL alpha,
+                dCSRmat *A,
+                REAL *x,
+                REAL *y);
+void dcsr_aAxpy_agg(const REAL alpha,
+                    dCSRmat *A,
+                    REAL *x,
+                    REAL *y);
+REAL dcsr_vmv(dCSRmat *A,
+              REAL *x,
+              REAL *y);
+void dcsr_mxm(dCSRmat *A,
+              dCSRmat *B,
+              dCSRmat *C);
+void icsr_mxm_symb(iCSRmat *A,iCSRmat *B,iCSRmat *C);
+void icsr_mxm (iCSRmat *A,iCSRmat *B,iCSRmat *C);
+void icsr_mxm_symb_max(iCSRmat *A,iCSRmat *B,iCSRmat *C,	\
+			INT multmax);
+dCSRmat dcsr_create_diagonal_matrix(dvector *diag);
+dCSRmat dcsr_diag_lump(dCSRmat *A);
+void dcsr_getdiag(INT n,
+                  dCSRmat *A,
+                  dvector *diag);
+void dcsr_diag_extremal(INT n,
+                        dCSRmat *A,
+                        REAL *amin,
+                        REAL *amax);
+void dcsr_getdiag_pow(INT n,
+                      REAL p,
+                      dCSRmat *A,
+                      dvector *diag);
+void dcsr_shiftdiag(INT n,
+                    dCSRmat *A,
+                    dvector *shifts);
+void dcsr_row_scale(dCSRmat *A,
+                    dvector *row_scale);
+void dcsr_diagpref(dCSRmat *A);
+void dcsr_rap(dCSRmat *R,
+              dCSRmat *A,
+              dCSRmat *P,
+              dCSRmat *RAP);
+void dcsr_rap_agg(dCSRmat *R,
+                  dCSRmat *A,
+                  dCSRmat *P,
+                  dCSRmat *RAP);
+SHORT dcsr_getblk(dCSRmat *A,
+                  INT *Is,
+                  INT *Js,
+                  const INT m,
+                  const INT n,
+                  dCSRmat *B);
+SHORT dcsr_delete_rowcol(dCSRmat *A,
+                         INT *delete_row,
+                         INT *delete_col,
+                         dCSRmat *B);
+void dcsr_bandwith(dCSRmat *A,
+                   INT *bndwith);
+dCSRmat dcsr_sympat (dCSRmat *A);
+dCSRmat dcsr_sym(dCSRmat *A);
+dCSRmat dcsr_reorder(dCSRmat *A,
+                      INT *order);
+void icsr_nodiag(iCSRmat *a);
+void icsr_tri(iCSRmat *a,const char loup);
+void icsr_rm_value(iCSRmat *a,const INT value);
+void icsr_keep_value(iCSRmat *a,const INT value);
+void bdcsr_alloc_minimal(const INT brow,
+                         const INT bcol,
+                         block_dCSRmat *A);
+void bdcsr_alloc(const INT brow,
+                 const INT bcol,
+                 block_dCSRmat *A);
+void bdcsr_free_minimal(block_dCSRmat *A);
+void bdcsr_free(block_dCSRmat *A);
+void bdcsr_cp(block_dCSRmat *A,
+              block_dCSRmat *B);
+void bdcsr_trans(block_dCSRmat *A,
+                 block_dCSRmat *AT);
+INT bdcsr_add(block_dCSRmat *A,
+              const REAL alpha,
+              block_dCSRmat *B,
+              const REAL beta,
+              block_dCSRmat *C);
+void bdcsr_add_overwrite(block_dCSRmat *A,
+              const REAL alpha,
+              block_dCSRmat *B,
+              const REAL beta);
+void bdcsr_axm(block_dCSRmat *A,
+               const REAL alpha);
+void bdcsr_aAxpy(const REAL alpha,
+                 block_dCSRmat *A,
+                 REAL *x,
+                 REAL *y);
+void bdcsr_mxv(block_dCSRmat *A,
+               REAL *x,
+               REAL *y);
+void bdcsr_shift(block_dCSRmat *A,INT shift);
+void bdcsr_mxv_forts(void *At,
+                     REAL *x,
+                     REAL *y);
+SHORT bdcsr_delete_rowcol(block_dCSRmat *A,
+                         INT *delete_row,
+                         INT *delete_col,
+                         block_dCSRmat *B);
+void bdcsr_extend(block_dCSRmat *A,				\
+			 REAL *vcol, REAL *vrow,			\
+			 const INT iblock,				\
+			 const REAL c1, const REAL c2);
+dCSRmat *dcsr_create_p (const INT m,		\
+			const INT n,		\
+			const INT nnz);
+dCOOmat *dcoo_create_p(INT m,			\
+		       INT n,			\
+		       INT nnz);
+dvector *dvec_create_p(const INT m);
+iCSRmat *icsr_create_p(const INT m,		\
+		       const INT n,		\
+		       const INT nnz);
+ivector *ivec_create_p(const INT m);
+void dcsr_alloc_p (const INT m,			\
+		   const INT n,			\
+		   const INT nnz,		\
+		   dCSRmat **A);
+void dvec_alloc_p(const INT m, dvector **u);
+void ivec_alloc_p(const INT m,ivector **u);
+dCSRmat *dcsr_create_plus(INT m,		\
+			  INT n,		\
+			  INT nnz,		\
+			  void *ia,		\
+			  void *ja,		\
+			  void *aij);
+void dcsr_alloc_plus(INT m, INT n, INT nnz, void *ia, void *ja, void *aij, dCSRmat *A);
+dvector *dvec_create_plus(INT n,		\
+			 void *vi);
+void dcsr2full(dCSRmat *A,REAL *Afull);
+void bdcsr_get_total_size(block_dCSRmat *A, INT *total_row, INT *total_col, INT *total_nnz);
+void bdcsr_getdiagblk(block_dCSRmat *A, dCSRmat *A_diag);
+dvector *bdcsr_getdiag(block_dCSRmat *Ab,
+                              const INT n1,
+                              const INT n2);
+INT bdcsr_getdiagblk_dcsr(block_dCSRmat *Ab,
+                                 const INT n10,
+                                 const INT n20,
+                                 dCSRmat *A);
+SHORT dcsr_sparse (dCSRmat *A, ivector *ii, ivector *jj, dvector *kk, INT m, INT n);
+void icsr_uniqueij(iCSRmat *U, ivector *ii, ivector *jj);
+dBSRmat dbsr_create (const INT  ROW,
+                     const INT  COL,
+                     const INT  NNZ,
+                     const INT  nb,
+                     const INT  storage_manner);
+void dbsr_alloc (const INT  ROW,
+                 const INT  COL,
+                 const INT  NNZ,
+                 const INT  nb,
+                 const INT  storage_manner,
+                 dBSRmat   *A);
+void dbsr_free (dBSRmat *A);
+void dbsr_cp (const dBSRmat *A,
+              dBSRmat       *B);
+INT dbsr_trans (const dBSRmat *A,
+                dBSRmat       *AT);
+void dbsr_axm (dBSRmat     *A,
+               const REAL   alpha);
+void dbsr_aAxpby (const REAL   alpha,
+                  dBSRmat     *A,
+                  REAL        *x,
+                  const REAL   beta,
+                  REAL        *y );
+void dbsr_aAxpy (const REAL      alpha,
+                 const dBSRmat  *A,
+                 const REAL     *x,
+                 REAL           *y);
+void dbsr_aAxpy_agg (const REAL      alpha,
+                     const dBSRmat  *A,
+                     REAL     *x,
+                     REAL           *y);
+void dbsr_mxv (const dBSRmat  *A,
+               const REAL     *x,
+               REAL           *y);
+void dbsr_mxv_agg (const dBSRmat  *A,
+                   REAL     *x,
+                   REAL           *y);
+void dbsr_mxm (const dBSRmat  *A,
+               const dBSRmat  *B,
+               dBSRmat        *C);
+void dbsr_rap (const dBSRmat  *R,
+               const dBSRmat  *A,
+               const dBSRmat  *P,
+               dBSRmat        *B);
+void dbsr_rap_agg (const dBSRmat  *R,
+                   const dBSRmat  *A,
+                   const dBSRmat  *P,
+                   dBSRmat        *B);
+dvector dbsr_getdiaginv(const dBSRmat *A);
+dCSRmat condenseBSR (const dBSRmat *A);
+dCSRmat condenseBSRLinf (const dBSRmat *A);
+void dsell_free(dSELLmat *A);
+void dsell_mxv(const dSELLmat *A,
+               const REAL *x,
+               REAL *y);
+void dsell_aAxpy(const REAL alpha,
+                 const dSELLmat *A,
+                 const REAL *x,
+                 REAL *y);
+void dsell_matvec(void *A,
+                  REAL *x,
+                  REAL *y);
+
+/* In file: src/utilities/string_utils.c */
+void print_ascii(const char *s);
+void trim_str(char **str, INT nstrings);
+void dos2unix(char **str, INT nstrings);
+
+/* In file: src/utilities/timing.c */
+void get_time (REAL *time);
+
+/* In file: src/utilities/vec.c */
+INT dvec_isnan (dvector *u);
+INT ivec_isnan (ivector *u);
+dvector dvec_create (const INT m);
+ivector ivec_create (const INT m);
+void dvec_alloc (const INT m,
+                 dvector *u);
+void ivec_alloc (const INT m,
+                 ivector *u);
+void dvec_free (dvector *u);
+void ivec_free (ivector *u);
+void dvec_null (dvector *u);
+void ivec_null (ivector *u);
+void dvec_rand (const INT n,
+                dvector *u);
+void dvec_rand_true (const INT n,
+                     dvector *u);
+void dvec_set (INT n,
+               dvector *u,
+               REAL val);
+void ivec_set (INT n,
+               ivector *u,
+               const INT val);
+void dvec_cp (dvector *x,
+              dvector *y);
+void dvec_perm (dvector *x,
+                const INT *P,
+                const SHORT inv);
+void ivec_cp (ivector *x,
+              ivector *y);
+REAL dvec_maxdiff (dvector *x,
+                   dvector *y);
+void dvec_ax (const REAL a,
+              dvector *x);
+void dvec_axpy (const REAL a,
+                dvector *x,
+                dvector *y);
+void dvec_axpyz(const REAL a,
+                dvector *x,
+                dvector *y,
+                dvector *z);
+REAL dvec_auv(dCSRmat *A, dvector *u_in, dvector *v_in);
+REAL residual_norm(dCSRmat *A, dvector *x_in, dvector *b_in);
+REAL dvec_dotprod (dvector *x,
+                   dvector *y);
+REAL dvec_relerr (dvector *x,
+                  dvector *y);
+REAL dvec_norm1 (dvector *x);
+REAL dvec_norm2 (dvector *x);
+REAL dvec_normp (dvector *x,  INT p);
+REAL dvec_norminf (dvector *x);
+void dvec_orthog_const(dvector *x);
+void dvec_orthog(dvector *x, dvector *y);
+void dvec_inv(dvector *x);
+
+/* In file: src/utilities/wrapper.c */
+void python_wrapper_krylov_amg(INT *n,
+                               INT *nnz,
+                               INT *ia,
+                               INT *ja,
+                               REAL *a,
+                               REAL *b,
+                               REAL *u,
+                               REAL *tol,
+                               INT *maxit,
+                               INT *print_lvl);
+void python_wrapper_direct(INT *n,
+                           INT *nnz,
+                           INT *ia,
+                           INT *ja,
+                           REAL *a,
+                           REAL *b,
+                           REAL *u,
+                           INT *print_lvl);
+void python_wrapper_krylov_block_2(INT *n,
+                               INT *nnz,
+                               INT *ia,
+                               INT *ja,
+                               REAL *a,
+                               REAL *b,
+                               REAL *u,
+                               REAL *tol,
+                               INT *maxit,
+                               INT *print_lvl);
+void python_wrapper_krylov_block_2by2(INT *n00,
+                                   INT *nnz00,
+                                   INT *ia00,
+                                   INT *ja00,
+                                   REAL *a00,
+                                   INT *n01,
+                                   INT *nnz01,
+                                   INT *ia01,
+                                   INT *ja01,
+                                   REAL *a01,
+                                   INT *n10,
+                                   INT *nnz10,
+                                   INT *ia10,
+                                   INT *ja10,
+                                   REAL *a10,
+                                   INT *n11,
+                                   INT *nnz11,
+                                   INT *ia11,
+                                   INT *ja11,
+                                   REAL *a11,
+                                   REAL *b,
+                                   REAL *u,
+                                   REAL *tol,
+                                   INT *maxit,
+                                   INT *print_lvl);
+void python_wrapper_cascadic_eigen(INT *n,
+                                   INT *nnz,
+                                   INT *ia,
+                                   INT *ja,
+                                   REAL *a,
+                                   REAL *u,
+                                   INT *num_eigen,
+                                   INT *print_lvl);
+
+/* In file: src/timestepping/async_output.c */
+async_writer *async_writer_create(const INT nbuf);
+void async_writer_flush(async_writer *aw);
+void async_writer_free(async_writer *aw);
+void async_dvec_write(async_writer *aw,
+                      const char *filename,
+                      dvector *vec);
+void async_dump_sol_vtk(async_writer *aw,
+                        char *namevtk,
+                        char *varname,
+                        mesh_struct *mesh,
+                        fespace *FE,
+                        REAL *sol);
+void async_dump_blocksol_vtk(async_writer *aw,
+                             char *namevtk,
+                             char **varname,
+                             mesh_struct *mesh,
+                             block_fespace *FE,
+                             REAL *sol);
+
+/* In file: src/timestepping/timestep.c */
+void initialize_timestepper(timestepper *tstepper,input_param *inparam,INT rhs_timedep,INT ndof);
+void free_timestepper(timestepper* ts);
+void update_timestep(timestepper *tstepper);
+void get_timeoperator(timestepper* ts,INT first_visit,INT cpyNoBC);
+void update_time_rhs(timestepper *ts);
+void update_timeoperator(timestepper *ts,REAL c);
+void eliminate_timeoperator_DirichletBC(timestepper *ts,INT *dirichlet);
+INT adaptive_timestep(timestepper *ts,REAL tol,void (*rhs_fun)(timestepper *,void *),
+                      INT (*solve)(timestepper *,void *),void *data);
+void initialize_blktimestepper(block_timestepper *tstepper,input_param *inparam,INT rhs_timedep,INT ndof,INT blksize);
+void free_blktimestepper(block_timestepper* ts, INT flag);
+void update_blktimestep(block_timestepper *tstepper);
+void get_blktimeoperator(block_timestepper* ts,INT first_visit,INT cpyNoBC);
+void update_blktimeoperator(block_timestepper *ts,REAL c);
+void eliminate_blktimeoperator_DirichletBC(block_timestepper *ts,INT *dirichlet);
+void update_blktime_rhs(block_timestepper *ts);
+void fixrhs_time(dvector* b,dvector* b_old,dCSRmat* M,dCSRmat* A,dvector* uprev,INT time_scheme,REAL dt,dvector* b_update);
+void get_timeoperator_old(dCSRmat* M,dCSRmat* A,INT time_scheme,REAL dt,dCSRmat* Atime);
+void csrreb(INT *nrow, INT *ncol, INT *nnzluo, \
+	    INT *ia, INT *ja, REAL *a,       \
+	    INT **jareb, REAL **areb);
+
+/* In file: src/amr/amr_coords.c */
+REAL deg2rad(REAL alpha_deg);
+REAL zero_twopi(REAL alpha);
+REAL zero_twopi_deg(REAL alpha_deg);
+void polar2cart(INT dim, REAL *px, REAL *cx);
+INT cart2polar(INT dim, REAL *c,REAL *p);
+void map2mac(scomplex *sc,cube2simp *c2s, input_grid *g);
+
+/* In file: src/utilities/amr_utils.c */
+INT aresame(INT *a, INT *b, INT n);
+INT aresamep(INT *a, INT *b, INT n, INT *p);
+INT xins(INT n, INT *nodes, REAL *xs, REAL *xstar);
+void marks(scomplex *sc,dvector *errors);
+unsigned INT reflect2(INT n, INT is, INT it,				\
+		      INT* sv1, INT *sv2, INT* stos1, INT* stos2,	\
+		      INT visited, INT *wrk);
+void abfstree(const INT it0, scomplex *sc,INT *wrk,const INT print_level);
+scomplex *scfinest(scomplex *sc);
+void scfinalize_nofree(scomplex *sc,const INT set_bndry_codes);
+void scfinalize(scomplex *sc,const INT set_bndry_codes);
+void cube2simp_free(cube2simp *c2s);
+void reverse(void *arr,INT length, size_t elsize);
+cube2simp *cube2simplex(INT dim);
+INT dvec_set_amr(const REAL value, scomplex *sc, INT npts, REAL *pts, REAL *toset);
+void find_cc_bndry_cc(scomplex *sc,const INT set_bndry_codes);
+void mapit(scomplex *sc,REAL *vc);
+void vtu_data_init(scomplex *sc, vtu_data *vdata);
+void vtu_data_free(vtu_data *vdata);
+void vtkw(const char *namevtk, vtu_data *vdata);
+
+/* In file: src/amr/input_grid.c */
+void input_grid_arrays(input_grid *g);
+void input_grid_free(input_grid *g);
+void input_grid_print(input_grid *g);
+void input_grid_example_file(FILE *fp,input_grid *g);
+void *read_mixed_data(INT nrec, INT ni, INT nr, char *the_string);
+void x_out(const char *pattern, size_t le);
+input_grid *parse_input_grid(FILE *the_file);
+void set_input_grid(INT *nd,input_grid *g,cube2simp *c2s);
+void set_edges(input_grid *g0,cube2simp *c2s);
+INT set_ndiv_edges(input_grid *g, input_grid *g0,		\
+		   cube2simp *c2s, INT **nd, const INT iter);
+
+/* In file: src/amr/interpolate.c */
+REAL interp4(cube2simp *c2s, REAL *u, REAL *xhat);
+REAL interp8(cube2simp *c2s, REAL *u, REAL *ue, REAL *xhat);
+void data_transform(const INT nv, const INT m,			\
+		    REAL *data, REAL *xodst, REAL *xndst);
+void interp1(const INT dimbig, REAL *fi, unigrid *ug,	\
+	     REAL *x, const INT nvert, INT *mask);
+
+/* In file: src/amr/macroelements.c */
+void align_lattice(INT *pd, const INT nkj,	\
+		   INT *nodes0,			\
+		   INT *nodes1,	\
+		   cube2simp *c2s);
+macrocomplex *set_mmesh(input_grid *g0,cube2simp *c2s,INT *wrk);
+INT locate1(INT *b,INT *a,INT n,INT *a2,INT n2,INT m2);
+void macrocomplex_free(macrocomplex *mc);
+void fix_grid(macrocomplex *mc,		\
+	       scomplex **scin,			\
+	       cube2simp *c2s,			\
+	       input_grid *g0);
+scomplex **generate_initial_grid(input_grid *g0);
+
+/* In file: src/amr/marking.c */
+ivector amr_maximal_mark(scomplex *sc, REAL *estimator, REAL gamma) ;
+
+/* In file: examples/elliptic_p1/mesh_cube_init.c */
+scomplex **mesh_cube_init(const INT dim, const INT ndiv, const INT ref_type);
+
+/* In file: src/amr/nested_iteration.c */
+void initialize_ni(nested_it* ni);
+void get_initial_mesh_ni(nested_it* ni,INT dim,INT init_ref_levels);
+void ni_refine_mesh(nested_it* ni);
+void next_update_sol(nested_it* ni,INT dim);
+void free_ni(nested_it* ni);
+
+/* In file: src/amr/scomplex.c */
+void haz_scomplex_realloc(scomplex *sc);
+REAL chk_sign(const INT it, const INT nbrit);
+REAL volume_compute(INT dim, REAL factorial, REAL *xs,void *wrk);
+void sc_vols(scomplex *sc);
+scomplex *haz_scomplex_init(const INT n,INT ns, INT nv,const INT nbig);
+scomplex haz_scomplex_null(const INT n,const INT nbig);
+void haz_scomplex_init_part(scomplex *sc);
+void vol_simplex(INT dim, REAL fact, REAL *xf, REAL *volt, void *wrk);
+scomplex *haz_scomplex_read(FILE *fp,INT print_level);
+void haz_scomplex_print(scomplex *sc, const INT ns0,const char *infor);
+void haz_scomplex_free(scomplex *sc);
+void find_nbr(INT ns,INT nv,INT n,INT *sv,INT *stos);
+void haz_scomplex_reserve(scomplex *sc, INT ns_max, INT nv_max);
+INT haz_add_simplex(INT is, scomplex *sc,REAL *xnew,	\
+		    INT *pv,INT ibnew,INT csysnew,	\
+		    INT nsnew, INT nvnew);
+INT haz_refine_simplex(scomplex *sc, const INT is, const INT it);
+void refine(const INT ref_levels, scomplex *sc,ivector *marked);
+void refine_par(const INT ref_levels, scomplex *sc,ivector *marked);
+mesh_struct sc2mesh(scomplex *sc);
+scomplex sc_bndry(scomplex *sc);
+
+/* In file: src/amr/uniform_refinement.c */
+void get_edge2d(iCSRmat *e2v, iCSRmat *el2e, scomplex *sc);
+void get_edge3d(iCSRmat *e2v, iCSRmat *el2e, scomplex *sc);
+void uniformrefine2d(scomplex *sc);
+void uniformrefine3d(scomplex *sc);
+
+/* In file: src/amr/unigrid.c */
+void coord_lattice(INT *m,const INT dim,const INT kf, \
+		   const INT nall, const INT *nd);
+INT num_lattice(INT *m,const INT dim,INT *nd);
+void binary1(const INT dim, unsigned INT *bits, INT *nvloc);
+scomplex *umesh(const INT dim,					\
+		INT *nd, cube2simp *c2s,			\
+		INT *labelf,INT *isbndf, INT *codef,INT elflag, \
+		const INT intype);
+void unirefine(INT *nd,scomplex *sc);
+unigrid *ugrid_init(INT n, INT *nd, REAL *xo, REAL *xn);
+void ugrid_free(unigrid *ug);
+void ugrid_transform(const INT n,unigrid *ug,REAL *xodst, REAL *xndst);
+
+/* In file: src/graphs/basic.c */
+ivector *sparse_MIS(dCSRmat *A, INT *iord);
+dCSRmat get_adjacency_from_transition(dCSRmat *P,
+                                      dvector *weighted_degree);
+dCSRmat get_graphLaplacian_from_adjacency(dCSRmat *A,
+                                          dvector *weighted_degree);
+dCSRmat get_normalizedgraphLaplacian_from_L_wdeg_inv(dCSRmat *L,
+                                                     dvector *weighted_degree_half_inv);
+dvector pairwise_distance(dDENSEmat *X,
+                           const INT norm_type);
+
+/* In file: src/graphs/dfs.c */
+iCSRmat **lex_bfs(INT n,INT *ia, INT *ja,ivector *inv_ord,ivector *anc, const REAL *guide);
+iCSRmat *run_bfs(INT n,INT *ia, INT *ja,	\
+		 ivector *roots,		\
+		 ivector *anc,			\
+		 const INT lvlmax);
+iCSRmat *bfs_di(void *a, const char c,		\
+		ivector *roots,			\
+		ivector *anc,			\
+		const INT lvlmax);
+iCSRmat *run_dfs(INT n, INT *ia, INT *ja);
+iCSRmat *dfs_di(void *a, const char c);
+int check0(weights *elem1, weights *elem2);
+INT check1(iweights *elem1, iweights *elem2);
+void getp(INT *ie, INT *je, REAL *w, INT ne, INT *p);
+void getpz(REAL *z, INT nv, INT *p);
+void getpi(INT *iz, INT *maskv, INT nv, INT *p);
+
+/* In file: src/graphs/coloring.c */
+INT graph_color_jp(const INT n,
+                   const INT *ia,
+                   const INT *ja,
+                   const SHORT distance,
+                   const INT seed,
+                   INT *color);
+ivector *graph_mis_luby_weights(const INT n,
+                                const INT *ia,
+                                const INT *ja,
+                                const SHORT distance,
+                                const unsigned long long *w);
+ivector *graph_mis_luby(const INT n,
+                        const INT *ia,
+                        const INT *ja,
+                        const SHORT distance,
+                        const INT seed);
+iCSRmat *graph_color_classes(const INT n,
+                             const INT *color,
+                             const INT ncolors);
+
+/* In file: src/graphs/knn.c */
+dCSRmat knn_graph(dDENSEmat *X,
+                  const INT k,
+                  const INT norm_type,
+                  const SHORT symm);
+dCSRmat radius_graph(dDENSEmat *X,
+                     const REAL r,
+                     const INT norm_type);
+
+/* In file: src/graphs/reorder.c */
+iCSRmat *run_bfs_par(const INT n,
+                     const INT *ia,
+                     const INT *ja,
+                     ivector *roots,
+                     ivector *anc,
+                     const SHORT cm);
+ivector *graph_rcm(const INT n,
+                   const INT *ia,
+                   const INT *ja);
+
+/* In file: src/eigen/eigen_drivers.c */
+INT eigsymm(dCSRmat *A,dCSRmat *B,REAL *evalues, REAL *evectors);
+INT eiggeneral(INT n,REAL *a,REAL *wr, REAL *wi);
+INT svdgeneral(INT nrow, INT ncol, REAL *a,REAL *smin, REAL *w);
+
+/* In file: src/eigen/lobpcg.c */
+INT eig_lobpcg(dCSRmat *A,
+               dCSRmat *B,
+               const INT nev,
+               REAL *evalues,
+               REAL *evectors,
+               precond *pc,
+               const REAL tol,
+               const INT MaxIt,
+               const SHORT prtlvl);
+INT eig_lobpcg_amg(dCSRmat *A,
+                   dCSRmat *B,
+                   const INT nev,
+                   REAL *evalues,
+                   REAL *evectors,
+                   const REAL shift,
+                   const REAL tol,
+                   const INT MaxIt,
+                   AMG_param *amgparam,
+                   const SHORT prtlvl);
+
+/* In file: src/fem/qz.c.c */
+void xdivy(const REAL16 xr,const REAL16 xi,	\
+	   const REAL16 yr,const REAL16 yi,	\
+	   REAL16 *zr,REAL16 *zi);
+void qzhes(INT nd,INT n,REAL16 *a,REAL16 *b,const INT wantx, REAL16 *x);
+void qzit(INT nd,INT n,			\
+	  REAL16 **a_io,REAL16 **b_io,			\
+	  const REAL16 eps,				\
+	  REAL16 *epsa,REAL16 *epsb,		\
+	  INT **iter_io,				\
+	  INT wantx,				\
+	  REAL16 **x_io);
+void qzval(INT nd,INT n,
+	   REAL16 **a_io,REAL16 **b_io,
+	   REAL16 epsa,REAL16 epsb,
+	   REAL16 **alphar_io,REAL16 **alphai_io,REAL16 **beta_io,
+	   INT wantx,REAL16 **x_io);
+void qzvec(INT nd, INT n,					\
+	   REAL16 **a_io, REAL16 **b_io,			\
+	   REAL16 epsa,REAL16 epsb,				\
+	   REAL16 **alphar_io,REAL16 **alphai_io,		\
+	   REAL16 **beta_io,					\
+	   REAL16 **x_io);
+
+/* In file: src/approximation/haz_aaa.c */
+INT residues_poles(INT m,				\
+		   REAL *zd,				\
+		   REAL *wd,				\
+		   REAL *fd,				\
+		   REAL *resdr,				\
+		   REAL *resdi,				\
+		   REAL *poldr,				\
+		   REAL *poldi);
+REAL get_rpzwf(INT numval,REAL16 *z, REAL16 *f,		\
+	       REAL **rpzwf,				\
+	       INT *mmax_in,				\
+	       INT *m_out,				\
+	       REAL tolaaa,
+	       INT print_level);
+REAL16 **set_f_values(REAL16 (*func)(REAL16 , REAL16 , REAL16 , REAL16 , REAL16 ), \
+		      REAL16 s,REAL16 t,REAL16 alpha,REAL16 beta,	\
+		      INT *numval_in,					\
+		      REAL xmin_in,					\
+		      REAL xmax_in,					\
+		      INT print_level);
+
+/* In file: src/approximation/haz_brasil.c */
+REAL get_rpzwf_brasil(
+    REAL16 (*f)(REAL16, void*), // function to approximate
+    void *param,                // user parameter for f
+    REAL **rpzwf,               // output - see haz_aaa.c
+    REAL a,                     // start point of interval
+    REAL b,                     // end point of interval
+    INT deg,                    // desired degree of rational approximation
+    INT init_steps,             // how many steps of the initialization alg
+    INT maxiter,                // maximum number of iterations
+    REAL step_factor,           // step factor
+    REAL max_step_size,         // maximum allowed step size
+    REAL tol,                   // maximum allowed deviation from equioscillation
+    INT *iter_brasil,
+    INT print_level             // level of verbosity
+);
+
+/* In file: src/approximation/ra_cache.c */
+void ra_cache_file(const char *filename);
+void ra_cache_free(void);
+REAL get_rpzwf_cached(const char *fname,
+                      REAL16 (*func)(REAL16, REAL16, REAL16, REAL16, REAL16),
+                      REAL16 s,
+                      REAL16 t,
+                      REAL16 alpha,
+                      REAL16 beta,
+                      INT numval,
+                      REAL xmin,
+                      REAL xmax,
+                      REAL **rpzwf,
+                      INT *mmax_in,
+                      INT *m_out,
+                      REAL tolaaa,
+                      INT print_level);
+REAL get_rpzwf_brasil_cached(const char *fname,
+                             REAL16 (*f)(REAL16, void*),
+                             REAL16 *param,
+                             INT nparam,
+                             REAL **rpzwf,
+                             REAL a,
+                             REAL b,
+                             INT deg,
+                             INT init_steps,
+                             INT maxiter,
+                             REAL step_factor,
+                             REAL max_step_size,
+                             REAL tol,
+                             INT *iter_brasil,
+                             INT print_level);
+
+/* End of header file */
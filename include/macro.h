@@ -28,9 +28,32 @@
 #define MIN_CDOF         1    /**< Minimal number of coarsest variables */
 #define MIN_CRATE        0.9   /**< Minimal coarsening ratio */
 #define MAX_CRATE        100.0  /**< Maximal coarsening ratio */
+#define MAX_DENSE_CDOF   512   /**< Max coarsest size for dense LU (automatic coarse solver) */
+#define MAX_DIRECT_CDOF  50000 /**< Max coarsest size for sparse direct (automatic coarse solver) */
+#define COARSE_CACHE_SIZE 4    /**< Number of cached coarsest level factorizations */
+#define MAX_BLOCK_NB     8     /**< Largest block size tried by dcsr_detect_block */
+#define MAX_BLOCK_FILL   1.5   /**< Max fill ratio of the BSR form accepted by dcsr_detect_block */
+#if defined(__AVX512F__)
+#define SELL_CHUNK       8     /**< SELL-C-sigma chunk height: doubles per SIMD register */
+#else
+#define SELL_CHUNK       4     /**< SELL-C-sigma chunk height: doubles per SIMD register (AVX) */
+#endif
+#define SELL_MAX_CHUNK   32    /**< Largest SELL-C-sigma chunk height */
+#define SELL_SIGMA       256   /**< SELL-C-sigma sorting window (rows) */
+#define VTU_BLOCK        32768 /**< Uncompressed block size of zlib compressed vtu arrays */
+#define ASYNC_NBUF       2     /**< Default number of buffers of an async_writer */
+#define DENSE_MR         4     /**< Rows of the register tile of the dense GEMM micro-kernel */
+#define DENSE_NR         8     /**< Columns of the register tile of the dense GEMM micro-kernel */
+#define DENSE_MC         128   /**< Rows of the L2 cache block of the dense GEMM */
+#define DENSE_KC         256   /**< Depth of the cache blocks of the dense GEMM */
+#define DENSE_NC         1024  /**< Columns of the L3 cache block of the dense GEMM */
+#define DENSE_LU_NB      64    /**< Panel width of the blocked dense LU */
+#define DENSE_SMALL      32768 /**< m*n*k below which dense products use plain loops */
+#define KDTREE_LEAF      16    /**< Largest number of points in a leaf of the k-d tree of knn_graph */
 #define STAG_RATIO       1e-4  /**< Stagnation tolerance = tol*STAGRATIO */
 #define MAX_STAG         20    /**< Maximal number of stagnation times */
 #define MAX_RESTART      20    /**< Maximal number of restarting for Krylov method */
+#define P1_BATCH         8     /**< Number of simplices in a batch for the P1 local kernels */
 
 /**
  * \brief Definition of return status and error messages
@@ -43,6 +66,7 @@
 #define ERROR_QUAD_DIM         -4  /**< unsupported quadrature dim */
 #define ERROR_MAT_DOF          -5 /**< stiffness matrix size and dof not consistent */
 #define ERROR_TS_TYPE          -6 /**< unknown time-stepping scheme */
+#define ERROR_TS_STEP          -7 /**< time step size below the minimum */
 //---------------------------------------------------------------------------------
 #define ERROR_OPEN_FILE       -10  /**< fail to open a file */
 #define ERROR_WRONG_FILE      -11  /**< input contains wrong format */
@@ -110,6 +134,19 @@
 #endif
 
 
+/**
+ * \brief Definition of output formats for vtu files
+ */
+#define VTU_ASCII               0  /**< ASCII DataArrays */
+#define VTU_RAW                 1  /**< Appended binary data, raw encoding */
+#define VTU_BASE64              2  /**< Appended binary data, base64 encoding */
+
+/**
+ * \brief Definition of space filling curves for mesh renumbering
+ */
+#define SFC_MORTON              0  /**< Morton (Z-order) curve */
+#define SFC_HILBERT             1  /**< Hilbert curve */
+
 /**
  * \brief Definition of solver types for nonlinear methods
  */
@@ -130,6 +167,7 @@
 //---------------------------------------------------------------------------------
 #define SOLVER_AMG             21  /**< AMG as an iterative solver */
 //---------------------------------------------------------------------------------
+#define SOLVER_AUTO            30  /**< Coarse solver chosen from size: dense LU, direct or iterative */
 #define SOLVER_UMFPACK         32  /**< UMFPack Direct Solver */
 
 /**
@@ -168,5 +168,39 @@ typedef struct mesh_struct{
 
 } mesh_struct;
 
+/**
+ * \struct vtu_writer
+ * \brief Output stream for a VTK unstructured grid (.vtu) file. The XML
+ *        is written to fp; with appended output the DataArrays are kept
+ *        (encoded) until vtu_close writes the AppendedData section.
+ */
+typedef struct vtu_writer {
+
+  //! file the XML is written to
+  FILE *fp;
+
+  //! VTU_ASCII, VTU_RAW or VTU_BASE64
+  SHORT format;
+
+  //! 1: zlib compressed appended data
+  SHORT compress;
+
+  //! number of appended arrays
+  INT narrays;
+
+  //! allocated number of appended arrays
+  INT nalloc;
+
+  //! offset of the next appended array
+  size_t offset;
+
+  //! encoded appended arrays
+  unsigned char **block;
+
+  //! size in bytes of each encoded appended array
+  size_t *nbytes;
+
+} vtu_writer;
+
 
 #endif
@@ -65,6 +65,49 @@ typedef struct newton{
   //! Norm of update (combined total if in block form)
   REAL update_norm;
 
+  //! Norm of nonlinear residual at the previous Newton step
+  REAL res_norm_prev;
+
+  //! Forcing Type: 0 - fixed linear tolerance | 1,2 - Eisenstat-Walker choice 1,2
+  INT forcing_type;
+
+  //! Forcing term: ||Jacobian*update - rhs|| <= eta*||rhs||
+  REAL eta;
+
+  //! Largest forcing term
+  REAL eta_max;
+
+  //! Eisenstat-Walker parameters: eta = gamma*(||rhs_k||/||rhs_{k-1}||)^alpha (choice 2)
+  REAL eta_gamma;
+  REAL eta_alpha;
+
+  //! Norm of the linear residual ||Jacobian*update - rhs|| of the last solve
+  REAL linres_norm;
+
+  //! Preconditioner for the Jacobian (can be kept over several Newton steps)
+  precond* pc;
+
+  //! Builds pc for the current Jacobian (NULL: no preconditioner)
+  precond* (*pc_setup)(struct newton *,void *);
+
+  //! Frees pc (NULL: free(pc))
+  void (*pc_free)(precond *,void *);
+
+  //! Data for pc_setup and pc_free (e.g. AMG_param)
+  void *pc_data;
+
+  //! Max number of Newton steps a preconditioner is used (1 - rebuild every step)
+  INT pc_max_age;
+
+  //! Number of Newton steps the current preconditioner has been used
+  INT pc_age;
+
+  //! Linear iterations of the first solve with the current preconditioner
+  INT pc_iter0;
+
+  //! Rebuild the preconditioner when the linear iterations exceed pc_degrade*pc_iter0
+  REAL pc_degrade;
+
 } newton;
 
 typedef struct nested_it {
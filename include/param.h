@@ -71,6 +71,8 @@ typedef struct {
     INT  nonlinear_itsolver_maxit;   /**< maximal iterations of nonlinear solver*/
     REAL nonlinear_itsolver_tol;    /**< tolerance for nonlinear solver */
     INT  nonlinear_itsolver_toltype; /**< type of stopping tolerance for nonlinear solver */
+    INT  nonlinear_itsolver_forcing; /**< forcing term of inexact Newton: 0 fixed, 1,2 Eisenstat-Walker */
+    INT  nonlinear_itsolver_pc_lag;  /**< max number of Newton steps a preconditioner is reused */
     INT fas_presmoothers; /* Number of presmoothing steps for FAS */
     INT fas_postsmoothers; /* Number of postsmoothing steps for FAS */
     INT fas_smooth_tol; /* Stopping tolerance for nonlinear smoother */
@@ -108,6 +110,7 @@ typedef struct {
     INT   AMG_maxit;                 /**< number of iterations for AMG used as preconditioner */
     SHORT AMG_coarse_solver;       /**< coarse solver type */
     SHORT AMG_coarse_scaling;      /**< switch of scaling of the coarse grid correction */
+    INT   AMG_sell_chunk;            /**< chunk height of SELL-C-sigma level operators (0: CSR) */
     SHORT AMG_amli_degree;         /**< degree of the polynomial used by AMLI cycle */
     SHORT AMG_nl_amli_krylov_type; /**< type of Krylov method used by nonlinear AMLI cycle */
     INT AMG_Schwarz_levels;        /**< number of levels use Schwarz smoother */
@@ -117,10 +120,12 @@ typedef struct {
     SHORT AMG_aggregation_type;    /**< aggregation type */
     REAL  AMG_strong_coupled;       /**< strong coupled threshold for aggregate */
     INT   AMG_max_aggregation;       /**< max size of each aggregate */
+    INT   AMG_aggressive_levels;     /**< number of levels with aggressive coarsening */
 
     // Smoothed Aggregation AMG (SA AMG)
     SHORT AMG_smooth_filter;       /**< use filter for smoothing the tentative */
     REAL AMG_tentative_smooth;     /**< relaxation factor for smoothing the tentative prolongation */
+    REAL AMG_smooth_drop_tol;      /**< relative drop tolerance for the smoothed prolongation */
 
     // HX preconditioner
     SHORT HX_smooth_iter;            /**< number of smoothing */
@@ -204,6 +209,10 @@ typedef struct {
     //! switch of scaling of the coarse grid correction
     SHORT coarse_scaling;
 
+    //! chunk height C of the SELL-C-sigma copies of the level matrices used
+    //! for residuals in the cycle (0: use the CSR matrices)
+    INT sell_chunk;
+
     //! degree of the polynomial used by AMLI cycle
     SHORT amli_degree;
 
@@ -222,12 +231,18 @@ typedef struct {
     //! max size of each aggregate
     INT max_aggregation;
 
+    //! number of levels with aggressive coarsening (aggregates of aggregates)
+    INT aggressive_levels;
+
     //! switch for filtered matrix used for smoothing the tentative prolongation
     SHORT smooth_filter;
 
     //! relaxation parameter for smoothing the tentative prolongation
     REAL tentative_smooth;
 
+    //! relative drop tolerance for the smoothed prolongation (0: no dropping)
+    REAL smooth_drop_tol;
+
     //! number of levels use Schwarz smoother
     INT Schwarz_levels;
 
@@ -127,6 +127,9 @@ typedef struct {
     //! prolongation operator at level level_num
     dCSRmat P;
 
+    //! SELL-C-sigma copy of A used for residuals in the cycle (As.row=0: not used)
+    dSELLmat As;
+
     //! pointer to the right-hand side at level level_num
     dvector b;
 
@@ -1032,8 +1035,7 @@ typedef struct {
     void *data;
 
     //! action for Matrix-vector, should be a pointer to a function
-    //void (*fct)(void *, REAL *, REAL *);
-    void (*fct)(REAL *, REAL *, void *);
+    void (*fct)(void *, REAL *, REAL *);
 
 } matvec; /**< Data for general Matrix-vector multiplication */
 
@@ -212,5 +212,57 @@ typedef struct dBSRmat {
 
 } dBSRmat; /**< Matrix of REAL type in BSR format */
 
+/**
+ * \struct dSELLmat
+ * \brief Sparse matrix of REAL type in SELL-C-sigma format
+ *
+ * Rows are grouped in chunks of C consecutive slots. Within each window of
+ * sigma rows the rows are sorted by decreasing length, so the rows sharing
+ * a chunk have similar length. Each chunk is stored column-wise and padded
+ * to its longest row: entry j of slot r of chunk c is at cs[c]+j*C+r.
+ * Padding entries have val = 0 and a valid column index.
+ *
+ * \note Refer to M. Kreutzer, G. Hager, G. Wellein, H. Fehske, A. R. Bishop,
+ *       "A unified sparse matrix data format for efficient general sparse
+ *       matrix-vector multiplication on modern processors with wide SIMD
+ *       units", SIAM J. Sci. Comput., 36(5), 2014.
+ */
+typedef struct dSELLmat {
+
+    //! row number of matrix A, m
+    INT row;
+
+    //! column of matrix A, n
+    INT col;
+
+    //! number of nonzeros (without padding)
+    INT nnz;
+
+    //! chunk height
+    INT C;
+
+    //! sorting window
+    INT sigma;
+
+    //! number of chunks, ceil(row/C)
+    INT nchunks;
+
+    //! start of each chunk in JA and val, the size is nchunks+1
+    INT *cs;
+
+    //! width (longest row) of each chunk, the size is nchunks
+    INT *cl;
+
+    //! original row of each slot (-1 for empty slots), the size is nchunks*C
+    INT *perm;
+
+    //! column indices, the size is cs[nchunks]
+    INT *JA;
+
+    //! nonzero entries, the size is cs[nchunks]
+    REAL *val;
+
+} dSELLmat; /**< Matrix of REAL type in SELL-C-sigma format */
+
 
 #endif
@@ -66,9 +66,11 @@ typedef struct timestepper{
   void *Ldata;
 
   //! Time-propagator matrix (A_time)
+  //! (shares IA and JA with At_noBC: free only with free_timestepper, not dcsr_free)
   dCSRmat* At;
 
   //! Time-propagator matrix with no BC
+  //! (IA and JA are those of At, only val is its own: free only with free_timestepper)
   dCSRmat* At_noBC;
 
   //! Solution at previous time step (eventually this should be array of solutions)
@@ -86,6 +88,27 @@ typedef struct timestepper{
   //! RHS of Time Propagator
   dvector* rhs_time;
 
+  //! Positions of the entries of M in At (cached union pattern of M and A)
+  ivector* M_to_At;
+
+  //! Positions of the entries of A in At
+  ivector* A_to_At;
+
+  //! Entries of At set to 0 by the Dirichlet elimination
+  ivector* bc_zero;
+
+  //! Entries of At set to 1 by the Dirichlet elimination
+  ivector* bc_one;
+
+  //! Smallest time step allowed in adaptive timestepping
+  REAL dt_min;
+
+  //! Largest time step allowed in adaptive timestepping
+  REAL dt_max;
+
+  //! Error estimate of the last adaptive time step (relative to the tolerance)
+  REAL err_est;
+
 } timestepper;
 
 /**
@@ -142,9 +165,11 @@ typedef struct block_timestepper{
   void *Ldata;
 
   //! Time-propagator matrix (A_time)
+  //! (blocks share IA and JA with At_noBC: free only with free_blktimestepper, not bdcsr_free)
   block_dCSRmat* At;
 
   //! Time-propagator matrix with no BC
+  //! (IA and JA of the blocks are those of At: free only with free_blktimestepper)
   block_dCSRmat* At_noBC;
 
   //! Solution at previous time step (eventually this should be array of solutions)
@@ -162,7 +187,32 @@ typedef struct block_timestepper{
   //! RHS of Time Propagator
   dvector* rhs_time;
 
+  //! Positions of the entries of the blocks of M in the blocks of At (brow*bcol)
+  ivector* M_to_At;
+
+  //! Positions of the entries of the blocks of A in the blocks of At (brow*bcol)
+  ivector* A_to_At;
+
+  //! Entries of the blocks of At set to 0 by the Dirichlet elimination (brow*bcol)
+  ivector* bc_zero;
+
+  //! Entries of the blocks of At set to 1 by the Dirichlet elimination (brow*bcol)
+  ivector* bc_one;
+
 } block_timestepper;
 
+/**
+ * \struct async_writer
+ * \brief Background writer for time-series output
+ *
+ * \note The solution is copied into one of nbuf buffers (a ring) and a
+ *       background thread writes it to disk, so the output of a time step
+ *       overlaps with the next time step. If all buffers are in use the
+ *       caller waits for the oldest one to be written. Without
+ *       WITH_PTHREADS the writes are done at once by the caller. The
+ *       members are private to src/timestepping/async_output.c.
+ */
+typedef struct async_writer async_writer;
+
 
 #endif
@@ -573,6 +573,7 @@ void scfinalize_nofree(scomplex *sc,const INT set_bndry_codes)
   sc->childn=realloc(sc->childn,sc->ns*sizeof(INT));
   sc->gen=realloc(sc->gen,sc->ns*sizeof(INT));
   sc->flags=realloc(sc->flags,sc->ns*sizeof(INT));
+  sc->ns_max=sc->ns;
   find_nbr(sc->ns,sc->nv,sc->n,sc->nodes,sc->nbr);
   // this also can be called separately
   // set_bndry_codes should always be set to 1.
@@ -648,6 +649,7 @@ void scfinalize(scomplex *sc,const INT set_bndry_codes)
   sc->childn=realloc(sc->childn,sc->ns*sizeof(INT));
   sc->gen=realloc(sc->gen,sc->ns*sizeof(INT));
   sc->flags=realloc(sc->flags,sc->ns*sizeof(INT));
+  sc->ns_max=sc->ns;
   find_nbr(sc->ns,sc->nv,sc->n,sc->nodes,sc->nbr);
   // this also can be called separately
   // set_bndry_codes should always be set to 1.
@@ -1404,6 +1406,9 @@ void vtu_data_free(vtu_data *vdata)
  * \param sc        Pointer to a simplicial complex
  * \param shift    integer added to the elements of arrays (here always=1).
  *
+ * \note The format (ascii or appended binary, optionally zlib
+ *       compressed) is the one set by vtu_set_format().
+ *
  */
 /**********************************************************************************/
 void vtkw(const char *namevtk, vtu_data *vdata)
@@ -1414,29 +1419,12 @@ void vtkw(const char *namevtk, vtu_data *vdata)
   if((sc->n!=3)&&(sc->n!=2)&&(sc->n!=1))
     fprintf(stderr,"\n*** ERR(%s; dim=%lld): No vtk files for dim .gt. 3.\n",__FUNCTION__,(long long )sc->n);
   FILE *fvtk;
+  vtu_writer *w;
   INT nv=sc->nv,ns=sc->ns, n=sc->n,n1=n+1,nbig=sc->nbig;
   INT *nodes = sc->nodes;
   REAL *x = sc->x;
   INT tcell=-10;
   INT k=-10,j=-10;
-  char *tfloat=strndup("Float64",8);
-  char *tinto=strndup("Int64",6);
-  char *endian=strndup("LittleEndian",13);
-  /*
-    what endian?:
-
-    Intel x86; OS=MAC OS X: little-endian
-    Intel x86; OS=Windows: little-endian
-    Intel x86; OS=Linux: little-endian
-    Intel x86; OS=Solaris: little-endian
-    Dec Alpha; OS=Digital Unix: little-endian
-    Dec Alpha; OS=VMS: little-endian
-    Hewlett Packard PA-RISC; OS=HP-UX: big-endian
-    IBM RS/6000; OS=AIX: big-endian
-    Motorola PowerPC; OS=Mac OS X:  big-endian
-    SGI R4000 and up; OS=IRIX: big-endian
-    Sun SPARC; OS=Solaris: big-endian
-  */
   /*
     Types of cells for VTK
 
@@ -1465,23 +1453,19 @@ void vtkw(const char *namevtk, vtu_data *vdata)
   else
     tcell=TET; /* tet */
 
-  /* VTK format writing the mesh for plot */
-  fvtk=fopen((const char *)namevtk,"w");
-  fprintf(fvtk,"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"%s\">\n",endian);
+  /* VTK format writing the mesh for plot (format set by vtu_set_format) */
+  w=vtu_open(namevtk);
+  fvtk=w->fp;
   fprintf(fvtk,"<UnstructuredGrid>\n");
   fprintf(fvtk,"<Piece NumberOfPoints=\"%lld\" NumberOfCells=\"%lld\">\n",(long long )nv,(long long )ns);
+  REAL *xyz=(REAL *)calloc(3*nv,sizeof(REAL));
+  for (j=0;j<nv;j++)
+    for (k=0;k<nbig && k<3;k++)
+      xyz[3*j+k]=x[j*nbig+k];
   fprintf(fvtk,"<Points>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" NumberOfComponents=\"3\" Format=\"ascii\">",tfloat);
-  for (j=0;j<nv;j++){
-    for (k=0;k<nbig;k++) {
-      fprintf(fvtk,"%.8f ",x[j*nbig+k]);
-    }
-    for (k=0;k<(3-nbig);k++) {
-      fprintf(fvtk,"%.8f ",0.);
-    }
-  }
-  fprintf(fvtk,"</DataArray>\n");
+  vtu_darray(w,NULL,3,xyz,3*nv);
   fprintf(fvtk,"</Points>\n");
+  free(xyz);
   /*NOT USED: if(sc->fval){ */
   /*   fprintf(fvtk,"<DataArray type=\"%s\" Name=\"ele\" Format=\"ascii\">",tfloat); */
   /*   for(k=0;k<nv;k++) fprintf(fvtk," %e ",sc->fval[k]); */
@@ -1513,70 +1497,42 @@ void vtkw(const char *namevtk, vtu_data *vdata)
   /*   fprintf(fvtk,"</DataArray>\n"); */
   /* } */
   /* fprintf(fvtk,"</PointData>\n"); */
+  INT *iwork=(INT *)calloc(ns*n1,sizeof(INT));
   fprintf(fvtk,"<Cells>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"offsets\" Format=\"ascii\">",tinto);
-  for(k=1;k<=ns;k++) fprintf(fvtk," %lld ",(long long )(k*n1));
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"connectivity\" Format=\"ascii\">\n",tinto);
-  /* for(k=0;k<ns;k++){ */
-  /*   kn1=k*n1; */
-  /*   for(j=0;j<n1;j++) fprintf(fvtk," %lld ",nodes[kn1 + j]); */
-  /* } */
-  for (j=0;j<ns;j++){
-    /*  for (j=0;j<ns;j++){*/
-    for (k=0;k<n1;k++) {
-      fprintf(fvtk,"%lld ",(long long )(nodes[j*n1+k]+shift));
-    }
-  }
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"types\" Format=\"ascii\">",tinto);
-  for(k=1;k<=ns;k++)
-    fprintf(fvtk," %lld ",(long long )tcell);
-  fprintf(fvtk,"</DataArray>\n");
+  for(k=0;k<ns;k++) iwork[k]=(k+1)*n1;
+  vtu_iarray(w,"offsets",iwork,ns);
+  for (j=0;j<ns*n1;j++) iwork[j]=nodes[j]+shift;
+  vtu_iarray(w,"connectivity",iwork,ns*n1);
+  for(k=0;k<ns;k++) iwork[k]=tcell;
+  vtu_iarray(w,"types",iwork,ns);
   fprintf(fvtk,"</Cells>\n");
+  free(iwork);
   //
   INT arrays;
+  fprintf(fvtk,"<PointData Scalars=\"scalars\">\n");
   for(arrays=0;arrays<vdata->nipt;++arrays){
     /* dump integer point data:*/
-    fprintf(fvtk,"<PointData Scalars=\"scalars\">\n");
-    fprintf(fvtk,"<DataArray type=\"%s\" Name=\"%s\" Format=\"ascii\">",tinto,vdata->names_ipt[arrays]);
-    for(k=0;k<nv;k++)
-      fprintf(fvtk," %lld ",(long long )vdata->ipt[arrays][k]);
-    fprintf(fvtk,"</DataArray>\n");
+    vtu_iarray(w,vdata->names_ipt[arrays],vdata->ipt[arrays],nv);
   }
   for(arrays=0;arrays<vdata->ndpt;++arrays){
     /* dump double point data:*/
-    fprintf(fvtk,"<PointData Scalars=\"scalars\">\n");
-    fprintf(fvtk,"<DataArray type=\"%s\" Name=\"%s\" Format=\"ascii\">",tfloat,vdata->names_dpt[arrays]);
-    for(k=0;k<nv;k++)
-      fprintf(fvtk," %.8f ",vdata->dpt[arrays][k]);
-    fprintf(fvtk,"</DataArray>\n");
+    vtu_darray(w,vdata->names_dpt[arrays],1,vdata->dpt[arrays],nv);
   }
   fprintf(fvtk,"</PointData>\n");
   /**/
   fprintf(fvtk,"<CellData Scalars=\"scalars\">\n");
   for(arrays=0;arrays<vdata->nicell;++arrays){
-    fprintf(fvtk,"<DataArray type=\"%s\" Name=\"%s\" Format=\"ascii\">",tinto,vdata->names_icell[arrays]);
-    for(k=0;k<ns;k++)
-      fprintf(fvtk," %lld ",(long long)vdata->icell[arrays][k]);
-    fprintf(fvtk,"</DataArray>\n");
+    vtu_iarray(w,vdata->names_icell[arrays],vdata->icell[arrays],ns);
   }
   for(arrays=0;arrays<vdata->ndcell;++arrays){
-    fprintf(fvtk,"<DataArray type=\"%s\" Name=\"%s\" Format=\"ascii\">",tfloat,vdata->names_dcell[arrays]);
-    for(k=0;k<ns;k++)
-      fprintf(fvtk," %.8f ",vdata->dcell[arrays][k]);
-    fprintf(fvtk,"</DataArray>\n");
+    vtu_darray(w,vdata->names_dcell[arrays],1,vdata->dcell[arrays],ns);
   }
   fprintf(fvtk,"</CellData>\n");
   //
   fprintf(fvtk,"</Piece>\n");
   fprintf(fvtk,"</UnstructuredGrid>\n");
-  fprintf(fvtk,"</VTKFile>\n");
+  vtu_close(w);
   fprintf(stdout,"%%Output (vtk) written on:%s\n",namevtk);
-  fclose(fvtk);
-  free(tfloat);
-  free(tinto);
-  free(endian);
   return;
 }
 /**/
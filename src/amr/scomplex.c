@@ -37,6 +37,8 @@ void haz_scomplex_realloc(scomplex *sc)
   sc->csys=realloc(sc->csys,nv*sizeof(INT));
   sc->flags=realloc(sc->flags,ns*sizeof(INT)); // element flags
   sc->vols=realloc(sc->vols,ns*sizeof(REAL)); // element volumes
+  sc->ns_max=ns;
+  sc->nv_max=nv;
   for (i = 0;i<sc->ns;i++) {
     sc->marked[i] = FALSE; // because first this array is used as working array.
     sc->gen[i] = 0;
@@ -221,6 +223,8 @@ scomplex *haz_scomplex_init(const INT n,INT ns, INT nv,const INT nbig)
   //////////////////////////////////////
   sc->nv=nv;
   sc->ns=ns;
+  sc->nv_max=nv;
+  sc->ns_max=ns;
   sc->bndry_cc=1; // one connected component on the boundary for now.
   sc->cc=1; // one connected component in the bulk for now.
   // NULL pointers for the rest
@@ -284,6 +288,8 @@ scomplex haz_scomplex_null(const INT n,const INT nbig)
   sc.flags=NULL;
   sc.x=NULL;
   sc.vols=NULL;
+  sc.ns_max=0;
+  sc.nv_max=0;
   sc.bndry_cc=1; // one connected component on the boundary for now.
   sc.cc=1; // one connected component in the bulk for now.
   // NULL pointers for the rest
@@ -328,6 +334,8 @@ void haz_scomplex_init_part(scomplex *sc)
 					    is cyl and so on */
   sc->flags=(INT *)calloc(ns,sizeof(INT)); // element flags
   //  sc->vols=(REAL *)calloc(ns,sizeof(REAL));// simplex volumes
+  sc->ns_max=ns;
+  sc->nv_max=nv;
   for (i = 0;i<ns;i++) {
     sc->marked[i] = FALSE; // because first is used for something else.
     sc->gen[i] = 0;
@@ -541,347 +549,178 @@ void haz_scomplex_free(scomplex *sc)
 }
 /**********************************************************************/
 /*!
- * \fn static unsigned int cmp_simplex(INT n, INT sim1, INT sim2, INT
- *			 *sv1, INT *sv2, INT *stos1, INT *stos2)
+ * \fn void find_nbr(INT ns,INT nv,INT n,INT *sv,INT *stos)
  *
- * \brief
+ * \brief Finds the neighbors of all simplices: stos[k*(n+1)+i] is the
+ *        simplex sharing with k the face opposite to the vertex
+ *        sv[k*(n+1)+i] (or -1 if this face is on the boundary).
  *
- * \param
+ * \param ns   number of simplices
+ * \param nv   number of vertices
+ * \param n    dimension (n+1 vertices per simplex)
+ * \param sv   simplex-vertex incidence (ns x (n+1))
+ * \param stos simplex-simplex incidence (ns x (n+1)), OUTPUT
  *
  * \return
  *
- * \note
+ * \note The faces are matched by sorting their vertex tuples (see
+ *       match_faces()), so the cost does not depend on the number of
+ *       simplices around a vertex squared.
  *
  */
-static unsigned INT cmp_simplex(INT n, INT sim1, INT sim2,		\
-				INT *sv1, INT *sv2, INT *stos1, INT *stos2)
+void find_nbr(INT ns,INT nv,INT n,INT *sv,INT *stos)
 {
-  //sim1 and sim2 are pointers to the neighboring lists of two
-  //simplices stos1 and stos2 are pointers to rows in
-  //simplex-to-simplex incidence; sv1 and sv2 are pointers to rows in
-  //simplex-vertex incidence for two neighboring simplices.
-  //
-  //rearrange to meet the structural condition.  compare two sets of
-  //length n. they should overlap at exactly n-1 members.  If they do
-  //not, 0 is returned, otherwise 1. no check if the members of the
-  //sets are distinct (they should be for the purpose of comparing two
-  //simplices.
-  unsigned INT fnd;
-  unsigned INT nf=0;
-  INT i1,k1=-10,i2,k2=-10;
-  INT i,j;
-  for (i=0;i<n;i++){
-    fnd=0;
-    i1=sv1[i];
-    for (j = 0;j < n;j++){
-      if(i1 == sv2[j]){
-	fnd=1;
-	break;
+  INT i,j,l,k,kn1;
+  INT n1 = n+1,nsv=ns*n1;
+  /* the face i of simplex k is row k*n1+i and is opposite to vertex i */
+  INT *fv=(INT *) calloc(nsv*n,sizeof(INT));
+  INT *fmate=(INT *) calloc(nsv,sizeof(INT));
+#if defined(_OPENMP)
+#pragma omp parallel for private(k,i,j,l,kn1)
+#endif
+  for (k = 0; k < ns; ++k) {
+    kn1=k*n1;
+    for (i = 0; i < n1; i++) {
+      l=0;
+      for (j = 0; j < n1; j++) {
+	if(j==i) continue;
+	fv[(kn1+i)*n+l]=sv[kn1+j];
+	l++;
       }
     }
-    if(fnd) {
-      continue;
-    } else {
-      // not found
-      nf++;
-      if(nf > 1) return 0;
-      k1=i;
-    }
   }
-  // same with sv1 and sv2 swapped.
-  nf=0;
-  for (i=0;i<n;i++){
-    fnd=0;
-    i2=sv2[i];
-    for (j=0;j<n;j++){
-      if(i2 == sv1[j]){
-	fnd=1;
-	break;
-      }
-    }
-    if(fnd) {
-      continue;
-    } else {
-      // not found
-      nf++;
-      if(nf > 1) return 0;
-      k2=i;
-    }
-  }
-  /* NOW put the neightbors at the right places ******* */
-  if(k1<0||k2<0){
-    fprintf(stderr,"\n***ERROR in %s; k1=%lld,k2=%lld\n\n",__FUNCTION__,(long long )k1,(long long )k2);
-    exit(65);
-  } else {
-    stos1[k1]=sim2;
-    stos2[k2]=sim1;
-    return 1;
+  match_faces(nsv,n,nv,fv,fmate);
+#if defined(_OPENMP)
+#pragma omp parallel for private(i)
+#endif
+  for (i = 0; i < nsv; ++i) {
+    if(fmate[i]>=0)
+      stos[i]=fmate[i]/n1;
+    else
+      stos[i]=-1;
   }
+  free(fv);
+  free(fmate);
+  return;
 }
 /**********************************************************************/
 /*!
- * \fn void find_nbr(INT ns,INT nv,INT n,INT *sv,INT *stos)
+ * \fn void haz_scomplex_reserve(scomplex *sc, INT ns_max, INT nv_max)
  *
- * \brief
+ * \brief Makes room in sc for at least ns_max simplices and nv_max
+ *        vertices without changing sc->ns and sc->nv. All arrays
+ *        indexed by simplices or by vertices (including the
+ *        parent_v incidence) are reallocated at most once here, so
+ *        adding simplices one by one with haz_add_simplex() does not
+ *        call realloc every time.
  *
- * \param
+ * \param sc      the simplicial complex
+ * \param ns_max  requested capacity in simplices (if less than
+ *                sc->ns, then sc->ns is used)
+ * \param nv_max  requested capacity in vertices (if less than
+ *                sc->nv, then sc->nv is used)
  *
  * \return
  *
- * \note
+ * \note The arrays are always reallocated to exactly the requested
+ *       size, so this can also be used to shrink them to sc->ns and
+ *       sc->nv.
  *
  */
-void find_nbr(INT ns,INT nv,INT n,INT *sv,INT *stos)
+void haz_scomplex_reserve(scomplex *sc, INT ns_max, INT nv_max)
 {
-  // find neighboring list
-  INT* ivs=NULL, *jvs=NULL, *stosi=NULL, *stosk=NULL, *svi=NULL, *svk=NULL;
-  INT i,j,k,jp,jia,jib,iabeg,iaend,ibbeg,ibend,kn1;
-  INT n1 = n+1,nv1=nv+1,nsv=ns*n1;
-  /* allocate */
-  ivs=(INT *) calloc(nv1,sizeof(INT));
-  jvs=(INT *) calloc(nsv,sizeof(INT));
-  /* transpose to get the vertex--simplex incidence */
-  for (i = 0; i < nv1; ++i)
-    ivs[i] = 0;
-  //
-  for (k = 0; k < ns; ++k) {
-    kn1=k*n1;
-    for (i = 0; i < n1; i++) {
-      j = sv[kn1+i] + 2;
-      if (j < nv1) ivs[j]++;
-    }
-  }
-  ivs[0] = 0;
-  ivs[1] = 0;
-  if (nv != 1) {
-    for (i= 2; i < nv1; ++i) {
-      ivs[i] += ivs[i-1];
-    }
-  }
-  for (i = 0; i < ns; ++i) {
-    iabeg = i*n1;
-    iaend = i*n1+n1;
-    for (jp = iabeg; jp < iaend; ++jp) {
-      j = sv[jp]+1;
-      k = ivs[j];
-      jvs[k] = i;
-      ivs[j] = k+1;
-    }
-  }
-  /**/
-  INT *icp=(INT *) calloc(ns,sizeof(INT));
-  for (i = 0; i < ns; ++i) icp[i] = -1;
-  for (i = 0; i < nsv; ++i) stos[i] = -1;
-  for (i = 0; i < ns; ++i) {
-      iabeg = i*n1;
-      iaend = iabeg + n1;
-      stosi=stos+iabeg; svi=sv+iabeg;
-      for (jia = iabeg; jia < iaend; ++jia) {
-	j = sv[jia]; // vertex number
-	ibbeg = ivs[j];
-	ibend = ivs[j+1];
-	// loop over all simplices with this j as a vertex.
-	for (jib = ibbeg; jib < ibend; ++jib) {
-	  k = jvs[jib];
-	  if(k<=i) continue;
-	  if (icp[k] != i) {
-	    icp[k] = i;
-	    kn1=k*n1;
-	    stosk=stos+kn1; svk=sv+kn1;
-	    if(!cmp_simplex(n1,i,k,svi,svk,stosi,stosk)) continue;
-	  }//if
-	} //for
-      } //for
-    } //for (i...
-    if (icp) free(icp);
-    if (ivs) free(ivs);
-    if (jvs) free(jvs);
-    //  }
-    return;
+  INT n1=sc->n+1,nbig=sc->nbig,nnz_pv;
+  if(ns_max<sc->ns) ns_max=sc->ns;
+  if(nv_max<sc->nv) nv_max=sc->nv;
+  /* simplices */
+  sc->nbr=realloc(sc->nbr,(ns_max*n1)*sizeof(INT));
+  sc->nodes=realloc(sc->nodes,(ns_max*n1)*sizeof(INT));
+  sc->gen=realloc(sc->gen,ns_max*sizeof(INT));
+  sc->marked=realloc(sc->marked,ns_max*sizeof(INT));
+  sc->flags=realloc(sc->flags,ns_max*sizeof(INT));
+  sc->parent=realloc(sc->parent,ns_max*sizeof(INT));
+  sc->child0=realloc(sc->child0,ns_max*sizeof(INT));
+  sc->childn=realloc(sc->childn,ns_max*sizeof(INT));
+  sc->vols=realloc(sc->vols,ns_max*sizeof(REAL));
+  sc->ns_max=ns_max;
+  /* vertices */
+  sc->x=realloc(sc->x,(nv_max*nbig)*sizeof(REAL));
+  sc->bndry=realloc(sc->bndry,nv_max*sizeof(INT));
+  sc->csys=realloc(sc->csys,nv_max*sizeof(INT));
+  /* every added vertex adds two entries in parent_v */
+  nnz_pv=sc->parent_v->nnz+2*(nv_max-sc->nv);
+  sc->parent_v->IA=realloc(sc->parent_v->IA,(nv_max+1)*sizeof(INT));
+  sc->parent_v->JA=realloc(sc->parent_v->JA,nnz_pv*sizeof(INT));
+  sc->parent_v->val=realloc(sc->parent_v->val,nnz_pv*sizeof(INT));
+  sc->nv_max=nv_max;
+  return;
 }
 /**********************************************************************/
 /*!
- * \fn INT haz_add_simplex(INT is, scomplex *sc,REAL *xnew, INT *pv,
- *                         INT ibnew,INT csysnew,INT nsnew, INT nvnew)
+ * \fn static void sc_children_init(scomplex *sc,const INT is,
+ *                                  const INT ks0,const INT ksn)
  *
- * \brief
- *
- * \param
- *
- * \return
- *
- * \note
+ * \brief Initializes the arrays indexed by simplices for the two
+ *        children ks0 and ksn of the simplex is. The storage must
+ *        already be there.
  *
  */
-INT haz_add_simplex(INT is, scomplex *sc,REAL *xnew,	\
-		    INT *pv,INT ibnew,INT csysnew,	\
-		    INT nsnew, INT nvnew)
+static void sc_children_init(scomplex *sc,const INT is,	\
+			     const INT ks0,const INT ksn)
 {
-  /* adds nodes and coords as well */
-  INT n=sc->n, nbig=sc->nbig, n1 = n+1,nv=sc->nv;//ns=sc->ns;
-  INT ks0=sc->child0[is], ksn=sc->childn[is];
+  INT n1=sc->n+1,j;
   INT isc0=ks0*n1, iscn=ksn*n1;
-  //  INT *dsti,*srci;
-  INT j,j0,jn,nnz_pv;
-  REAL *dstr;
+  sc->child0[is]=ks0;
+  sc->childn[is]=ksn;
   /* nodes  AND neighbors */
-  sc->nbr=realloc(sc->nbr,(nsnew*n1)*sizeof(INT));
-  sc->nodes=realloc(sc->nodes,(nsnew*n1)*sizeof(INT));
   for(j=0;j<n1;j++){
-    j0=isc0+j;
-    jn=iscn+j;
-    //
-    sc->nodes[j0]=-1;
-    sc->nbr[j0]=-1;
-    sc->nodes[jn]=-1;
-    sc->nbr[jn]=-1;
-  }
-  //new vertex (if any!!!)
-  if(nvnew != nv) {
-    sc->x=realloc(sc->x,(nvnew*nbig)*sizeof(REAL));
-    dstr=(sc->x+nv*nbig); memcpy(dstr,xnew,n*sizeof(REAL));
-    if(xnew) free(xnew);
-    sc->bndry=realloc(sc->bndry,(nvnew)*sizeof(INT));
-    sc->bndry[nv]=ibnew;
-    sc->csys=realloc(sc->csys,(nvnew)*sizeof(INT));
-    sc->csys[nv]=csysnew;
-    nnz_pv=sc->parent_v->nnz;
-    sc->parent_v->row=nvnew;
-    sc->parent_v->col=nv;
-    sc->parent_v->JA=realloc(sc->parent_v->JA,(nnz_pv+2)*sizeof(REAL));
-    sc->parent_v->JA[nnz_pv]=pv[0];
-    sc->parent_v->JA[nnz_pv+1]=pv[1];
-    sc->parent_v->val=realloc(sc->parent_v->val,(nnz_pv+2)*sizeof(REAL));
-    sc->parent_v->val[nnz_pv]=sc->level+1;
-    sc->parent_v->val[nnz_pv+1]=sc->level+1;
-    sc->parent_v->nnz+=2;
-    sc->parent_v->IA=realloc(sc->parent_v->IA,(nvnew+1)*sizeof(REAL));
-    sc->parent_v->IA[nvnew]=sc->parent_v->nnz;
-    /* fprintf(stdout,"\nnv=%d; nvnew=%d;nnz_pv=%d(pv[0]=%d,pv[1]=%d)",nv,nvnew,sc->parent_v->nnz,pv[0],pv[1]); */
+    sc->nodes[isc0+j]=-1;
+    sc->nbr[isc0+j]=-1;
+    sc->nodes[iscn+j]=-1;
+    sc->nbr[iscn+j]=-1;
   }
   //generation
-  sc->gen=realloc(sc->gen,(nsnew)*sizeof(INT));
   sc->gen[ks0]=sc->gen[is]+1;
   sc->gen[ksn]=sc->gen[is]+1;
   //marked
-  sc->marked=realloc(sc->marked,(nsnew)*sizeof(INT));
   sc->marked[ks0]=sc->marked[is];
   sc->marked[ksn]=sc->marked[is];
   //flags
-  sc->flags=realloc(sc->flags,(nsnew)*sizeof(INT));
   sc->flags[ks0]=sc->flags[is];
   sc->flags[ksn]=sc->flags[is];
   //parents
-  sc->parent=realloc(sc->parent,(nsnew)*sizeof(INT));
   sc->parent[ks0]=is;
   sc->parent[ksn]=is;
   //child0
-  sc->child0=realloc(sc->child0,(nsnew)*sizeof(INT));
   sc->child0[ks0]=-1;
   sc->child0[ksn]=-1;
   //childn
-  sc->childn=realloc(sc->childn,(nsnew)*sizeof(INT));
   sc->childn[ks0]=-1; sc->childn[ksn]=-1;
-  //volumes
-  sc->vols=realloc(sc->vols,(nsnew)*sizeof(REAL));// we can calculate all volumes at the end, so just allocate here.
-  //scalars
-  sc->ns=nsnew;
-  sc->nv=nvnew;
-  return 0;
+  //volumes: we can calculate all volumes at the end.
+  return;
 }
 /**********************************************************************/
 /*!
- * \fn INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
- *
- * \brief
+ * \fn static void sc_bisect_links(scomplex *sc,const INT is,
+ *                                 const INT nodnew,const INT nsmax)
  *
- * \param
+ * \brief Sets the vertices and the neighbors of the children of the
+ *        simplex is bisected with the new vertex nodnew and corrects
+ *        the neighbor pointers of the neighbors. The children must
+ *        be initialized with sc_children_init(). All simplex numbers
+ *        must be less than nsmax.
  *
- * \return
- *
- * \note The algorithm is found in Traxler, C. T. An algorithm for
- *       adaptive mesh refinement in n-dimensions. Computing 59
- *       (1997), no. 2, 115–137 (MR1475530)
+ * \note This touches only is, its children, its neighbors and the
+ *       children of its neighbors.
  *
  */
-INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
+static void sc_bisect_links(scomplex *sc,const INT is,	\
+			    const INT nodnew,const INT nsmax)
 {
-  INT n=sc->n, nbig=sc->nbig,ns=sc->ns,nv=sc->nv;
-  INT nsnew=ns,nvnew=nv;
-  INT itype,nodnew=-10;
-  INT n1=n+1,j,i,p,p0,pn,isn1,snbri,snbrp,snbrn,snbr0;
-  INT jt,jv0,jvn,ks0,ksn,s0nbri,snnbri;//,isn;
-  REAL *xnew;
-  INT pv[2];
-  INT csysnew,ibnew;
-  if(is<0) return 0;
-  if(sc->child0[is] >= 0) return 0;
-  //  isn=is*n;
-  isn1=is*n1;
-  for (i=1;i<n;i++){
-    snbri=sc->nbr[isn1+i] ; // the on-axis neighbor.
-    if(snbri<0) continue; //this is a boundary
-    if (sc->gen[snbri]<sc->gen[is]){//this was wrong in the code in the Traxler's paper
-      haz_refine_simplex(sc,snbri,-1);
-      nsnew=sc->ns;
-      nvnew=sc->nv;
-    }
-  }
-  if (it<0){
-    xnew = (REAL *)calloc(nbig,sizeof(REAL));
-    jv0=sc->nodes[isn1];
-    jvn=sc->nodes[isn1+n];
-    // here we can store the edge the new vertex comes from
-    for(j=0;j<nbig;j++){
-      xnew[j] = 0.5*(sc->x[jv0*nbig+j]+sc->x[jvn*nbig+j]);
-    }
-    // parents of the vertex:
-    pv[0]=jv0;
-    pv[1]=jvn;
-    // boundary codes (these are also fixed later when connected components on the boundary are found.
-    /* if(sc->bndry[jv0] > sc->bndry[jvn]) */
-    /*   ibnew=sc->bndry[jv0]; */
-    /* else */
-    /*   ibnew=sc->bndry[jvn]; */
-    ibnew=0; //added vertex is considered interior vertex by default. ;
-    if(sc->csys[jv0] < sc->csys[jvn])
-      csysnew=sc->csys[jv0];
-    else
-      csysnew=sc->csys[jvn];
-    /* we have added a vertex, let us indicate this */
-    nodnew = nvnew;
-    nvnew++;
-  } else {
-    //    jx=    newvertex=t->child0->vertex[1];
-    jt=sc->child0[it]; // child simplex number
-    jv0 = sc->nodes[jt*n1+1]; // global vertex number of vertex 1.
-    xnew = (sc->x + jv0*nv); /* xnew is the same pointer, the vertex
-				has already been added. */
-    nodnew=jv0;
-    ibnew=sc->bndry[nodnew];
-    csysnew=sc->csys[nodnew];
-  }
-  ks0=nsnew;
-  sc->child0[is]=ks0; // child0 simplex number
-  nsnew++;
-  ksn=nsnew;
-  sc->childn[is]=ksn; // childn simplex number
-  nsnew++;
-  /*
-    Add two new simplices and initialize their parents, etc
-  */
-  haz_add_simplex(is,sc,xnew,pv,ibnew,csysnew,nsnew,nvnew);
-  /*
-    Initialize all vertex pointers of the children according to the
-    scheme. Also initialize all pointers to bring simplices as long
-    as they do not require a recursive call for subdivision.  Always
-    remember: The mesh is supposed to meet the structural condition when
-    this routine is called, and it will meet the structural condition
-    again after this routine has terminated.
-  */
-  INT isc0=-100,iscn=-100;
-  //ks0 = sc->child0[is];
-  //ksn = sc->childn[is];
+  INT n=sc->n,n1=n+1,i,p,p0,pn,itype;
+  INT isn1=is*n1,snbrp,snbrn,snbr0,s0nbri,snnbri;
+  INT ks0=sc->child0[is],ksn=sc->childn[is];
+  INT isc0,iscn;
   isc0=ks0*n1;
   iscn=ksn*n1;
   sc->nodes[isc0+0]=sc->nodes[isn1];   // nodes[is][0]
@@ -973,8 +812,8 @@ INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
     s0nbri=sc->nbr[isc0+i];    /*s->child0->neighbor[i]*/
     snnbri=sc->nbr[iscn+i]; /*s->childn->neighbor[i]*/
     if(s0nbri>=0){
-      if(s0nbri >=sc->ns) {
-	fprintf(stderr,"\n\nSTOPPING: nsnew,s0nbri,snnbri,ns: %lld %lld %lld %lld\n\n",(long long )nsnew,(long long )snnbri,(long long )s0nbri,(long long )sc->ns); fflush(stdout);
+      if(s0nbri >=nsmax) {
+	fprintf(stderr,"\n\nSTOPPING: nsnew,s0nbri,snnbri,ns: %lld %lld %lld %lld\n\n",(long long )nsmax,(long long )snnbri,(long long )s0nbri,(long long )sc->ns); fflush(stdout);
 	exit(32);
       }
       //      if(sc->gen[s0nbri]==s0->gen)
@@ -983,8 +822,8 @@ INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
 	sc->nbr[s0nbri*n1+i]=ks0;
     }
     if(snnbri>=0){
-      if(snnbri >=sc->ns) {
-	fprintf(stderr,"\n\nSTOPPING2: s0nbri,snnbri,ns: %lld %lld %lld %lld\n",(long long )nsnew,(long long )snnbri,(long long )s0nbri,(long long )sc->ns); fflush(stdout);
+      if(snnbri >=nsmax) {
+	fprintf(stderr,"\n\nSTOPPING2: s0nbri,snnbri,ns: %lld %lld %lld %lld\n",(long long )nsmax,(long long )snnbri,(long long )s0nbri,(long long )sc->ns); fflush(stdout);
 	exit(33);
       }
       //      if(sc->gen[snnbri]==sn->gen)
@@ -993,6 +832,156 @@ INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
 	sc->nbr[snnbri*n1+i]=ksn;
     }
   }
+  return;
+}
+/**********************************************************************/
+/*!
+ * \fn INT haz_add_simplex(INT is, scomplex *sc,REAL *xnew, INT *pv,
+ *                         INT ibnew,INT csysnew,INT nsnew, INT nvnew)
+ *
+ * \brief Adds the two children of simplex is (and the new vertex, if
+ *        nvnew > sc->nv) to the simplicial complex.
+ *
+ * \param xnew  coordinates of the new vertex. If NULL, the
+ *              coordinates are assumed to be already stored in
+ *              sc->x at position sc->nv. xnew is not freed here.
+ *
+ * \return
+ *
+ * \note The storage grows geometrically (the capacity is doubled
+ *       when exceeded), so adding many simplices costs amortized
+ *       O(1) per simplex.
+ *
+ */
+INT haz_add_simplex(INT is, scomplex *sc,REAL *xnew,	\
+		    INT *pv,INT ibnew,INT csysnew,	\
+		    INT nsnew, INT nvnew)
+{
+  /* adds nodes and coords as well */
+  INT n=sc->n, nbig=sc->nbig,nv=sc->nv;//ns=sc->ns;
+  INT ks0=sc->child0[is], ksn=sc->childn[is];
+  INT nnz_pv;
+  REAL *dstr;
+  if((nsnew>sc->ns_max)||(nvnew>sc->nv_max))
+    haz_scomplex_reserve(sc,					\
+			 (nsnew>sc->ns_max)?(2*nsnew):sc->ns_max,	\
+			 (nvnew>sc->nv_max)?(2*nvnew):sc->nv_max);
+  //new vertex (if any!!!)
+  if(nvnew != nv) {
+    dstr=(sc->x+nv*nbig);
+    if(xnew) memcpy(dstr,xnew,n*sizeof(REAL));
+    sc->bndry[nv]=ibnew;
+    sc->csys[nv]=csysnew;
+    nnz_pv=sc->parent_v->nnz;
+    sc->parent_v->row=nvnew;
+    sc->parent_v->col=nv;
+    sc->parent_v->JA[nnz_pv]=pv[0];
+    sc->parent_v->JA[nnz_pv+1]=pv[1];
+    sc->parent_v->val[nnz_pv]=sc->level+1;
+    sc->parent_v->val[nnz_pv+1]=sc->level+1;
+    sc->parent_v->nnz+=2;
+    sc->parent_v->IA[nvnew]=sc->parent_v->nnz;
+    /* fprintf(stdout,"\nnv=%d; nvnew=%d;nnz_pv=%d(pv[0]=%d,pv[1]=%d)",nv,nvnew,sc->parent_v->nnz,pv[0],pv[1]); */
+  }
+  sc_children_init(sc,is,ks0,ksn);
+  //scalars
+  sc->ns=nsnew;
+  sc->nv=nvnew;
+  return 0;
+}
+/**********************************************************************/
+/*!
+ * \fn INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
+ *
+ * \brief
+ *
+ * \param
+ *
+ * \return
+ *
+ * \note The algorithm is found in Traxler, C. T. An algorithm for
+ *       adaptive mesh refinement in n-dimensions. Computing 59
+ *       (1997), no. 2, 115–137 (MR1475530)
+ *
+ */
+INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
+{
+  INT n=sc->n, nbig=sc->nbig,ns=sc->ns,nv=sc->nv;
+  INT nsnew=ns,nvnew=nv;
+  INT nodnew=-10;
+  INT n1=n+1,j,i,isn1,snbri;
+  INT jt,jv0,jvn,ks0,ksn;//,isn;
+  REAL *xnew;
+  INT pv[2];
+  INT csysnew,ibnew;
+  if(is<0) return 0;
+  if(sc->child0[is] >= 0) return 0;
+  //  isn=is*n;
+  isn1=is*n1;
+  for (i=1;i<n;i++){
+    snbri=sc->nbr[isn1+i] ; // the on-axis neighbor.
+    if(snbri<0) continue; //this is a boundary
+    if (sc->gen[snbri]<sc->gen[is]){//this was wrong in the code in the Traxler's paper
+      haz_refine_simplex(sc,snbri,-1);
+      nsnew=sc->ns;
+      nvnew=sc->nv;
+    }
+  }
+  if (it<0){
+    // make room for the new vertex and store it directly in sc->x;
+    if((nvnew+1)>sc->nv_max)
+      haz_scomplex_reserve(sc,sc->ns_max,2*(nvnew+1));
+    xnew = NULL;
+    jv0=sc->nodes[isn1];
+    jvn=sc->nodes[isn1+n];
+    // here we can store the edge the new vertex comes from
+    for(j=0;j<nbig;j++){
+      sc->x[nvnew*nbig+j] = 0.5*(sc->x[jv0*nbig+j]+sc->x[jvn*nbig+j]);
+    }
+    // parents of the vertex:
+    pv[0]=jv0;
+    pv[1]=jvn;
+    // boundary codes (these are also fixed later when connected components on the boundary are found.
+    /* if(sc->bndry[jv0] > sc->bndry[jvn]) */
+    /*   ibnew=sc->bndry[jv0]; */
+    /* else */
+    /*   ibnew=sc->bndry[jvn]; */
+    ibnew=0; //added vertex is considered interior vertex by default. ;
+    if(sc->csys[jv0] < sc->csys[jvn])
+      csysnew=sc->csys[jv0];
+    else
+      csysnew=sc->csys[jvn];
+    /* we have added a vertex, let us indicate this */
+    nodnew = nvnew;
+    nvnew++;
+  } else {
+    //    jx=    newvertex=t->child0->vertex[1];
+    jt=sc->child0[it]; // child simplex number
+    jv0 = sc->nodes[jt*n1+1]; // global vertex number of vertex 1.
+    xnew = NULL; /* the vertex has already been added. */
+    nodnew=jv0;
+    ibnew=sc->bndry[nodnew];
+    csysnew=sc->csys[nodnew];
+  }
+  ks0=nsnew;
+  sc->child0[is]=ks0; // child0 simplex number
+  nsnew++;
+  ksn=nsnew;
+  sc->childn[is]=ksn; // childn simplex number
+  nsnew++;
+  /*
+    Add two new simplices and initialize their parents, etc
+  */
+  haz_add_simplex(is,sc,xnew,pv,ibnew,csysnew,nsnew,nvnew);
+  /*
+    Initialize all vertex pointers of the children according to the
+    scheme. Also initialize all pointers to bring simplices as long
+    as they do not require a recursive call for subdivision.  Always
+    remember: The mesh is supposed to meet the structural condition when
+    this routine is called, and it will meet the structural condition
+    again after this routine has terminated.
+  */
+  sc_bisect_links(sc,is,nodnew,sc->ns);
   /*
      NOW call the on-axis nbrs for refinement, passing to them a
      pointer to this simplex S so they find our new vertex.  Skip the
@@ -1004,6 +993,100 @@ INT haz_refine_simplex(scomplex *sc, const INT is, const INT it)
   return 0;
 }
 /******************************************************************/
+/*!
+ * \fn static void refine_init(scomplex *sc)
+ *
+ * \brief On the coarsest level forms the neighboring list and the
+ *        bfs tree of the dual graph.
+ *
+ */
+static void refine_init(scomplex *sc)
+{
+  INT print_level=0;
+  if(!sc->level){
+    /* sc->level this is set to 0 in haz_scomplex_init */
+    /* form neighboring list on the coarsest level */
+    find_nbr(sc->ns,sc->nv,sc->n,sc->nodes,sc->nbr);
+    INT *wrk=calloc(5*(sc->n+2),sizeof(INT));
+    /* construct bfs tree for the dual graph */
+    abfstree(0,sc,wrk,print_level);
+    if(wrk) free(wrk);
+  }
+  return;
+}
+/******************************************************************/
+/*!
+ * \fn static void refine_mark(scomplex *sc,ivector *marked)
+ *
+ * \brief copies the marking from the finest level (marked) to
+ *        sc->marked.
+ *
+ */
+static void refine_mark(scomplex *sc,ivector *marked)
+{
+  INT j,nsfine=-1;
+  if(!sc->level){
+    // we have not refined anything yet and marked is set, so
+    if((marked->row)&&(marked->val))
+      for(j=0;j<sc->ns;j++) sc->marked[j]=marked->val[j];
+    else {
+      //      issue a warning and mark everything for refinement;
+      for(j=0;j<sc->ns;j++) sc->marked[j]=TRUE;
+    }
+  } else {
+    /* we come here if we have refined few times and in such case we
+       need to re-mark our simplices on the finest level using the
+       values of marked at abs(sc->child0[j]+1) which were set from
+       the previous visit here */
+    for(j=0;j<sc->ns;j++) {
+      if(sc->child0[j]<0||sc->childn[j]<0){
+	nsfine=abs(sc->child0[j]+1);
+	sc->marked[j]=marked->val[nsfine];
+      }
+    }
+  }
+  return;
+}
+/******************************************************************/
+/*!
+ * \fn static void refine_vols(scomplex *sc)
+ *
+ * \brief computes the volumes of the simplices on the finest level.
+ *
+ */
+static void refine_vols(scomplex *sc)
+{
+  INT i,j,node,in1;
+  /*
+   *  compute volumes (the volumes on the coarsest grid should be set in
+   * generate_initial_grid, but just in case we are coming here from
+   * some other function we compute these here too.
+   */
+#if defined(_OPENMP)
+#pragma omp parallel private(i,j,node,in1)
+#endif
+  {
+    void *wrk1=malloc((sc->n+1)*(sc->n*sizeof(REAL) + sizeof(INT)));
+    REAL *xs=calloc((sc->n+1)*sc->n,sizeof(REAL));
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for(i=0;i<sc->ns;++i){
+      if(sc->child0[i]<0||sc->childn[i]<0){
+	in1=i*(sc->n+1);
+	for (j = 0;j<=sc->n;++j){
+	  node=sc->nodes[in1+j];
+	  memcpy((xs+j*sc->n),(sc->x+node*sc->n),sc->n*sizeof(REAL));
+	}
+	sc->vols[i]=volume_compute(sc->n,sc->factorial,xs,wrk1);
+      }
+    }
+    free(wrk1);
+    free(xs);
+  }
+  return;
+}
+/******************************************************************/
 /*!
  * \fn void refine(const INT ref_levels, scomplex *sc,ivector *marked)
  *
@@ -1027,20 +1110,20 @@ void refine(const INT ref_levels, scomplex *sc,ivector *marked)
 {
   if(ref_levels<=0) return;
   /*somethind to be done*/
-  INT j=-1,i,nsold,print_level=0,nsfine=-1;
-  if(!sc->level){
-    /* sc->level this is set to 0 in haz_scomplex_init */
-    /* form neighboring list on the coarsest level */
-    find_nbr(sc->ns,sc->nv,sc->n,sc->nodes,sc->nbr);
-    INT *wrk=calloc(5*(sc->n+2),sizeof(INT));
-    /* construct bfs tree for the dual graph */
-    abfstree(0,sc,wrk,print_level);
-    if(wrk) free(wrk);
-  }
+  INT j=-1,i,nsold,nleaf;
+  refine_init(sc);
   if((!marked)){
     // just refine everything that was not refined:
     for (i=0;i<ref_levels;i++){
       nsold=sc->ns;
+      /* every leaf is bisected at least once, so reserve the storage
+	 for this level in advance; */
+      nleaf=0;
+      for(j = 0;j < nsold;j++)
+	if((sc->child0[j]<0||sc->childn[j]<0)) nleaf++;
+      if(((nsold+2*nleaf)>sc->ns_max)||((sc->nv+nleaf)>sc->nv_max))
+	haz_scomplex_reserve(sc,MAX(nsold+2*nleaf,sc->ns_max),	\
+			     MAX(sc->nv+nleaf,sc->nv_max));
       for(j = 0;j < nsold;j++)
 	if((sc->child0[j]<0||sc->childn[j]<0))
 	  haz_refine_simplex(sc, j, -1);
@@ -1049,54 +1132,418 @@ void refine(const INT ref_levels, scomplex *sc,ivector *marked)
     for(j=0;j<sc->ns;j++) sc->marked[j]=TRUE; // not sure we need this.
     // we are done here;
     return;
-  } else if(!sc->level){
-    // we have not refined anything yet and marked is set, so
-    if((marked->row)&&(marked->val))
-      for(j=0;j<sc->ns;j++) sc->marked[j]=marked->val[j];
-    else {
-      //      issue a warning and mark everything for refinement;
-      for(j=0;j<sc->ns;j++) sc->marked[j]=TRUE;
-    }
-  } else {
-    /* we come here if we have refined few times and in such case we
-       need to re-mark our simplices on the finest level using the
-       values of marked at abs(sc->child0[j]+1) which were set from
-       the previous visit here */
-    for(j=0;j<sc->ns;j++) {
-      if(sc->child0[j]<0||sc->childn[j]<0){
-	nsfine=abs(sc->child0[j]+1);
-	sc->marked[j]=marked->val[nsfine];
-      }
-    }
   }
+  refine_mark(sc,marked);
   /*
    * refine everything that is marked on the finest level and is
    * not yet refined: (marked>0 and child<0)
    */
   nsold=sc->ns;
+  /* reserve storage using the number of marked simplices (the
+     conformity closure may need more, then the storage grows
+     geometrically in haz_add_simplex()) */
+  nleaf=0;
+  for(j = 0;j < nsold;j++)
+    if(sc->marked[j] && (sc->child0[j]<0||sc->childn[j]<0)) nleaf++;
+  if(((nsold+2*nleaf)>sc->ns_max)||((sc->nv+nleaf)>sc->nv_max))
+    haz_scomplex_reserve(sc,MAX(nsold+2*nleaf,sc->ns_max),	\
+			 MAX(sc->nv+nleaf,sc->nv_max));
   for(j = 0;j < nsold;j++)
     if(sc->marked[j] && (sc->child0[j]<0||sc->childn[j]<0))
       haz_refine_simplex(sc, j, -1);
-  /*
-   *  compute volumes (the volumes on the coarsest grid should be set in
-   * generate_initial_grid, but just in case we are coming here from
-   * some other function we compute these here too.
-   */
-  INT node,in1;
-  void *wrk1=malloc((sc->n+1)*(sc->n*sizeof(REAL) + sizeof(INT)));
-  REAL *xs=calloc((sc->n+1)*sc->n,sizeof(REAL));
-  for(i=0;i<sc->ns;++i){
-    if(sc->child0[i]<0||sc->childn[i]<0){
-      in1=i*(sc->n+1);
-      for (j = 0;j<=sc->n;++j){
-	node=sc->nodes[in1+j];
-	memcpy((xs+j*sc->n),(sc->x+node*sc->n),sc->n*sizeof(REAL));
+  refine_vols(sc);
+  sc->level++;
+  return;
+}
+/******************************************************************/
+/*!
+ * \fn static INT sc_patch(scomplex *sc,const INT is,INT **pm,INT *cap)
+ *
+ * \brief Collects in (*pm)[0:np-1] the leaf simplices which are
+ *        bisected together with is, i.e. is and (recursively) its
+ *        unrefined on-axis neighbors of the same generation. These
+ *        share the refinement edge of is. (*pm) is reallocated if
+ *        more than *cap entries are needed.
+ *
+ * \return np, the number of simplices in the patch.
+ *
+ */
+static INT sc_patch(scomplex *sc,const INT is,INT **pm,INT *cap)
+{
+  INT n=sc->n,n1=n+1,np=1,k=0,i,j,l,m;
+  (*pm)[0]=is;
+  while(k<np){
+    m=(*pm)[k];
+    k++;
+    for(i=1;i<n;i++){
+      j=sc->nbr[m*n1+i];
+      if(j<0 || sc->child0[j]>=0 || sc->gen[j]!=sc->gen[m]) continue;
+      for(l=0;l<np;l++)
+	if((*pm)[l]==j) break;
+      if(l<np) continue;
+      if(np>=(*cap)){
+	(*cap)*=2;
+	(*pm)=realloc((*pm),(*cap)*sizeof(INT));
       }
-      sc->vols[i]=volume_compute(sc->n,sc->factorial,xs,wrk1);
+      (*pm)[np]=j;
+      np++;
     }
   }
-  free(wrk1);
-  free(xs);
+  return np;
+}
+/******************************************************************/
+/*!
+ * \fn static void sc_claim(unsigned *own,const unsigned v)
+ *
+ * \brief own[0]=min(own[0],v) (atomically when compiled with OpenMP).
+ *
+ */
+static void sc_claim(unsigned *own,const unsigned v)
+{
+#if defined(_OPENMP)
+  unsigned old=own[0];
+  while(v<old){
+    if(__sync_bool_compare_and_swap(own,old,v)) break;
+    old=own[0];
+  }
+#else
+  if(v<own[0]) own[0]=v;
+#endif
+  return;
+}
+/******************************************************************/
+/*!
+ * \fn static INT sc_footprint(scomplex *sc,const INT m,INT *fp)
+ *
+ * \brief Stores in fp all simplices which are read or written when m
+ *        is bisected: m, its neighbors and the children of its
+ *        (already refined) neighbors. fp must have 3*(n+1)+1 entries.
+ *
+ * \return the number of entries in fp.
+ *
+ */
+static INT sc_footprint(scomplex *sc,const INT m,INT *fp)
+{
+  INT n1=sc->n+1,i,x,nfp=0;
+  fp[nfp]=m; nfp++;
+  for(i=0;i<n1;i++){
+    x=sc->nbr[m*n1+i];
+    if(x<0) continue;
+    fp[nfp]=x; nfp++;
+    if(sc->child0[x]>=0){
+      fp[nfp]=sc->child0[x]; nfp++;
+      fp[nfp]=sc->childn[x]; nfp++;
+    }
+  }
+  return nfp;
+}
+/******************************************************************/
+/*!
+ * \fn static void refine_rounds(scomplex *sc,INT *w0,const INT nw0)
+ *
+ * \brief Bisects all leaf simplices in the worklist w0[0:nw0-1] and
+ *        the simplices needed to keep the complex conforming. The
+ *        work is done in rounds. In every round:
+ *
+ *        (1) for every simplex in the worklist the patch of simplices
+ *            sharing its refinement edge is found. A patch is ready
+ *            if none of its on-axis neighbors is an unrefined simplex
+ *            of lower generation (these are refined first by the
+ *            recursion in haz_refine_simplex()); such neighbors are
+ *            added to the worklist for the next round;
+ *
+ *        (2) every ready patch claims the simplices it touches with
+ *            a priority (a scrambled simplex number, so that the
+ *            winners are spread over the whole complex and not only
+ *            at the start of the numbering); a patch whose claims all
+ *            hold is independent from all other winners;
+ *
+ *        (3) the new simplices and vertices are numbered with prefix
+ *            sums over the winners and all winners are bisected
+ *            concurrently.
+ *
+ *        The result does not depend on the number of threads.
+ *
+ */
+static void refine_rounds(scomplex *sc,INT *w0,const INT nw0)
+{
+  INT n=sc->n,n1=n+1,nbig=sc->nbig,nfpmax=3*n1+1;
+  INT k,l,j,m,i,nw,nwin,nsnew,nvnew,ns0,nv0,nnz0,nwnext,nblk;
+  INT capw=nw0,capp=16,capb=0,np,nmax=sc->ns;
+  INT *w=calloc(capw,sizeof(INT));
+  INT *psize=calloc(capw,sizeof(INT));
+  INT *pia=calloc(capw+1,sizeof(INT));
+  INT *ready=calloc(capw,sizeof(INT));
+  INT *wia=calloc(capw+1,sizeof(INT));
+  INT *wiv=calloc(capw+1,sizeof(INT));
+  INT *pja=NULL,*blk=NULL;
+  INT *pm=calloc(capp,sizeof(INT));
+  INT *cand=calloc(nmax,sizeof(INT));
+  unsigned *own=calloc(nmax,sizeof(unsigned));
+  for(j=0;j<nmax;j++) own[j]=UINT_MAX;
+  memcpy(w,w0,nw0*sizeof(INT));
+  nw=nw0;
+  while(nw>0){
+    for(k=0;k<nw;k++) cand[w[k]]=1;
+    /*
+     * (1) patches, owners and readiness; ready[k]=1 if the patch of
+     * w[k] can be bisected, -1 if it waits for a coarser neighbor.
+     */
+#if defined(_OPENMP)
+#pragma omp parallel private(k,l,j,m,i)
+#endif
+    {
+      INT capt=16,npt;
+      INT *pmt=malloc(capt*sizeof(INT));
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,64)
+#endif
+      for(k=0;k<nw;k++){
+	psize[k]=0; ready[k]=0;
+	npt=sc_patch(sc,w[k],&pmt,&capt);
+	// the patch is handled by its smallest simplex in the worklist
+	for(l=0;l<npt;l++)
+	  if(cand[pmt[l]] && pmt[l]<w[k]) break;
+	if(l<npt) continue;
+	ready[k]=1;
+	for(l=0;l<npt;l++){
+	  m=pmt[l];
+	  for(i=1;i<n;i++){
+	    j=sc->nbr[m*n1+i];
+	    if(j<0) continue;
+	    if((sc->gen[j]<sc->gen[m]) && (sc->child0[j]<0)) ready[k]=-1;
+	  }
+	}
+	if(ready[k]>0) psize[k]=npt;
+      }
+      free(pmt);
+    }
+    pia[0]=0;
+    for(k=0;k<nw;k++) pia[k+1]=pia[k]+psize[k];
+    pja=realloc(pja,(pia[nw]+1)*sizeof(INT));
+    /* (2) members of the ready patches and claims */
+#if defined(_OPENMP)
+#pragma omp parallel private(k,l,j)
+#endif
+    {
+      INT capt=16,npt,nfp,iwin;
+      unsigned prio;
+      INT *pmt=malloc(capt*sizeof(INT));
+      INT *fp=malloc(nfpmax*sizeof(INT));
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,64)
+#endif
+      for(k=0;k<nw;k++){
+	if(ready[k]<=0) continue;
+	npt=sc_patch(sc,w[k],&pmt,&capt);
+	memcpy(pja+pia[k],pmt,npt*sizeof(INT));
+	/* multiplication by an odd number is a bijection mod 2^32, so
+	   the priorities are distinct and never equal to UINT_MAX */
+	prio=((unsigned )(w[k]+1))*2654435761u;
+	for(l=0;l<npt;l++){
+	  nfp=sc_footprint(sc,pmt[l],fp);
+	  for(j=0;j<nfp;j++) sc_claim(own+fp[j],prio);
+	}
+      }
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,64)
+#endif
+      for(k=0;k<nw;k++){
+	wiv[k+1]=0;
+	if(ready[k]<=0) continue;
+	iwin=1;
+	prio=((unsigned )(w[k]+1))*2654435761u;
+	for(l=pia[k];l<pia[k+1];l++){
+	  nfp=sc_footprint(sc,pja[l],fp);
+	  for(j=0;j<nfp;j++)
+	    if(own[fp[j]]!=prio) {iwin=0; break;}
+	  if(!iwin) break;
+	}
+	wiv[k+1]=iwin;
+      }
+      // release the claims before anything is bisected.
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,64)
+#endif
+      for(k=0;k<nw;k++){
+	if(ready[k]<=0) continue;
+	for(l=pia[k];l<pia[k+1];l++){
+	  nfp=sc_footprint(sc,pja[l],fp);
+	  for(j=0;j<nfp;j++){
+#if defined(_OPENMP)
+#pragma omp atomic write
+#endif
+	    own[fp[j]]=UINT_MAX;
+	  }
+	}
+      }
+      free(pmt);
+      free(fp);
+    }
+    /* (3) numbering of the new simplices and vertices */
+    ns0=sc->ns; nv0=sc->nv; nnz0=sc->parent_v->nnz;
+    wia[0]=0; wiv[0]=0;
+    for(k=0;k<nw;k++){
+      wia[k+1]=wia[k]+((wiv[k+1])?(2*psize[k]):0);
+      wiv[k+1]+=wiv[k];
+    }
+    nwin=wiv[nw];
+    nsnew=ns0+wia[nw];
+    nvnew=nv0+nwin;
+    if((nsnew>sc->ns_max)||(nvnew>sc->nv_max))
+      haz_scomplex_reserve(sc,					\
+			   (nsnew>sc->ns_max)?(2*nsnew):sc->ns_max,	\
+			   (nvnew>sc->nv_max)?(2*nvnew):sc->nv_max);
+#if defined(_OPENMP)
+#pragma omp parallel for private(k,l,j,m,i) schedule(dynamic,16)
+#endif
+    for(k=0;k<nw;k++){
+      INT jv0,jvn,ks,kv,knnz;
+      if(wiv[k+1]==wiv[k]) continue;
+      m=w[k];
+      /* the new vertex on the refinement edge of m */
+      kv=nv0+wiv[k];
+      jv0=sc->nodes[m*n1];
+      jvn=sc->nodes[m*n1+n];
+      for(j=0;j<nbig;j++)
+	sc->x[kv*nbig+j] = 0.5*(sc->x[jv0*nbig+j]+sc->x[jvn*nbig+j]);
+      sc->bndry[kv]=0; //added vertex is considered interior vertex by default.
+      if(sc->csys[jv0] < sc->csys[jvn])
+	sc->csys[kv]=sc->csys[jv0];
+      else
+	sc->csys[kv]=sc->csys[jvn];
+      knnz=nnz0+2*wiv[k];
+      sc->parent_v->JA[knnz]=jv0;
+      sc->parent_v->JA[knnz+1]=jvn;
+      sc->parent_v->val[knnz]=sc->level+1;
+      sc->parent_v->val[knnz+1]=sc->level+1;
+      sc->parent_v->IA[kv+1]=knnz+2;
+      /* bisect the patch in the same way as haz_refine_simplex() */
+      ks=ns0+wia[k];
+      for(l=pia[k];l<pia[k+1];l++){
+	i=pja[l];
+	sc_children_init(sc,i,ks,ks+1);
+	sc_bisect_links(sc,i,kv,nsnew);
+	ks+=2;
+      }
+    }
+    if(nwin){
+      sc->parent_v->row=nvnew;
+      sc->parent_v->col=nv0;
+      sc->parent_v->nnz=nnz0+2*nwin;
+    }
+    sc->ns=nsnew;
+    sc->nv=nvnew;
+    if(sc->ns>nmax){
+      cand=realloc(cand,sc->ns*sizeof(INT));
+      own=realloc(own,sc->ns*sizeof(unsigned));
+      for(j=nmax;j<sc->ns;j++){
+	cand[j]=0; own[j]=UINT_MAX;
+      }
+      nmax=sc->ns;
+    }
+    /*
+     * next worklist: the simplices from w which are not refined yet
+     * and the coarser neighbors blocking the patches.
+     */
+    for(k=0;k<nw;k++) cand[w[k]]=0;
+    nblk=0;
+    for(k=0;k<nw;k++){
+      if(ready[k]>=0) continue;
+      np=sc_patch(sc,w[k],&pm,&capp);
+      for(l=0;l<np;l++){
+	m=pm[l];
+	for(i=1;i<n;i++){
+	  j=sc->nbr[m*n1+i];
+	  if(j<0 || cand[j]) continue;
+	  if((sc->gen[j]<sc->gen[m]) && (sc->child0[j]<0)){
+	    if(nblk>=capb){
+	      capb=2*capb+16;
+	      blk=realloc(blk,capb*sizeof(INT));
+	    }
+	    blk[nblk]=j; nblk++;
+	    cand[j]=1;
+	  }
+	}
+      }
+    }
+    nwnext=0;
+    for(k=0;k<nw;k++){
+      j=w[k];
+      if(sc->child0[j]>=0 || cand[j]) continue;
+      w[nwnext]=j; nwnext++;
+    }
+    if((nwnext+nblk)>capw){
+      capw=nwnext+nblk;
+      w=realloc(w,capw*sizeof(INT));
+      psize=realloc(psize,capw*sizeof(INT));
+      pia=realloc(pia,(capw+1)*sizeof(INT));
+      ready=realloc(ready,capw*sizeof(INT));
+      wia=realloc(wia,(capw+1)*sizeof(INT));
+      wiv=realloc(wiv,(capw+1)*sizeof(INT));
+    }
+    memcpy(w+nwnext,blk,nblk*sizeof(INT));
+    nw=nwnext+nblk;
+    for(k=0;k<nblk;k++) cand[blk[k]]=0;
+  }
+  free(w); free(psize); free(pia); free(pja); free(ready);
+  free(wia); free(wiv); free(pm); free(blk); free(cand); free(own);
+  return;
+}
+/******************************************************************/
+/*!
+ * \fn void refine_par(const INT ref_levels, scomplex *sc,ivector *marked)
+ *
+ * \brief Refines a simplicial complex. Same as refine(), but the
+ *        marked simplices are bisected in rounds of independent
+ *        patches (see refine_rounds()), which can be done in
+ *        parallel when compiled with OpenMP.
+ *
+ * \param sc: scomplex containing the whole hierarchy of refinements
+ *
+ * \param marked: input ivector containing all simplices from the
+ *               finest level which are marked for refinement; If
+ *               marked is null then uniformly renfines the grid
+ *               ref_levels.
+ *
+ * \param ref_levels number of refinements. If marked is not null,
+ * then this is ignored and only one refinement is done;
+ *
+ * \return void
+ *
+ * \note The refined complex is the same as the one from refine(), but
+ *       the simplices and the vertices are numbered differently.
+ *
+ */
+void refine_par(const INT ref_levels, scomplex *sc,ivector *marked)
+{
+  if(ref_levels<=0) return;
+  INT j,i,nw,nlev=1;
+  INT *w=NULL;
+  refine_init(sc);
+  if(marked) refine_mark(sc,marked);
+  else nlev=ref_levels;
+  for(i=0;i<nlev;i++){
+    w=realloc(w,sc->ns*sizeof(INT));
+    nw=0;
+    for(j=0;j<sc->ns;j++){
+      if(sc->child0[j]>=0 && sc->childn[j]>=0) continue;
+      if(marked && !sc->marked[j]) continue;
+      w[nw]=j; nw++;
+    }
+    /* reserve storage for bisecting every simplex in w once */
+    if(((sc->ns+2*nw)>sc->ns_max)||((sc->nv+nw)>sc->nv_max))
+      haz_scomplex_reserve(sc,MAX(sc->ns+2*nw,sc->ns_max),	\
+			   MAX(sc->nv+nw,sc->nv_max));
+    refine_rounds(sc,w,nw);
+    if(!marked) sc->level++;
+  }
+  free(w);
+  if(!marked){
+    for(j=0;j<sc->ns;j++) sc->marked[j]=TRUE;
+    return;
+  }
+  refine_vols(sc);
   sc->level++;
   return;
 }
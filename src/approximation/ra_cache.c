@@ -0,0 +1,337 @@
+/*! \file src/approximation/ra_cache.c
+ *
+ *  Copyright 2017__HAZMATH__. All rights reserved.
+ *
+ *  \note Cache of rational approximations (residues, poles, nodes,
+ *        weights and function values as returned by get_rpzwf and
+ *        get_rpzwf_brasil). The key is the name of the function, its
+ *        parameters and the parameters of the algorithm; a hit copies the
+ *        stored arrays instead of running AAA or BRASIL (REAL16
+ *        arithmetic and QZ solves) again.
+ *
+ *  \note The cache is kept in memory for the lifetime of the program and,
+ *        after ra_cache_file(filename), also in a text file (hexadecimal
+ *        floats, so the stored values are exact) that is read on the
+ *        first lookup and appended to on every miss.
+ *
+ */
+#include "hazmath.h"
+#include "../utilities/lock.inl"
+
+#define RA_CACHE_AAA     0
+#define RA_CACHE_BRASIL  1
+
+/* one cached approximation */
+struct ra_entry {
+  SHORT method;
+  char *fname;
+  void *func;     // only for entries without a name (not written to disk)
+  INT nkey;
+  REAL16 *key;
+  INT len;        // length of each of the 7 arrays
+  INT iout[2];    // AAA: m, mmax; BRASIL: iterations
+  REAL err;
+  REAL *rpzwf;    // 7*len
+  struct ra_entry *next;
+};
+
+static struct ra_entry *ra_list = NULL;
+static char *ra_file = NULL;
+static SHORT ra_file_read = 0;
+static haz_lock_t ra_lock = HAZ_LOCK_INITIALIZER;
+
+static struct ra_entry *ra_entry_new(const SHORT method,
+                                     const char *fname,
+                                     void *func,
+                                     const INT nkey,
+                                     const REAL16 *key,
+                                     const INT len)
+{
+  struct ra_entry *e=(struct ra_entry *)calloc(1,sizeof(struct ra_entry));
+  e->method=method;
+  e->fname=strdup(fname ? fname : "");
+  e->func=fname ? NULL : func;
+  e->nkey=nkey;
+  e->key=(REAL16 *)calloc(MAX(nkey,1),sizeof(REAL16));
+  memcpy(e->key,key,nkey*sizeof(REAL16));
+  e->len=len;
+  e->rpzwf=(REAL *)calloc(7*MAX(len,1),sizeof(REAL));
+  return e;
+}
+
+static void ra_entry_free(struct ra_entry *e)
+{
+  free(e->fname);
+  free(e->key);
+  free(e->rpzwf);
+  free(e);
+}
+
+/* append an entry to the cache file */
+static void ra_entry_write(FILE *fp,
+                           const struct ra_entry *e)
+{
+  INT i;
+  fprintf(fp,"%lld %s %lld",(long long )e->method,e->fname,(long long )e->nkey);
+  for(i=0;i<e->nkey;i++) fprintf(fp," %La",e->key[i]);
+  fprintf(fp," %lld %lld %lld %a",(long long )e->len,(long long )e->iout[0],(long long )e->iout[1],e->err);
+  for(i=0;i<7*e->len;i++) fprintf(fp," %a",e->rpzwf[i]);
+  fprintf(fp,"\n");
+}
+
+/* read the cache file (called with ra_lock held) */
+static void ra_file_load(void)
+{
+  FILE *fp;
+  char name[1024];
+  long long method,nkey,len,i0,i1,i;
+  struct ra_entry *e;
+  ra_file_read=1;
+  if(!ra_file || !(fp=fopen(ra_file,"r"))) return;
+  while(fscanf(fp,"%lld %1023s %lld",&method,name,&nkey)==3){
+    if(nkey<0) break;
+    REAL16 *key=(REAL16 *)calloc(MAX(nkey,1),sizeof(REAL16));
+    for(i=0;i<nkey;i++) if(fscanf(fp,"%Lg",&key[i])!=1) break;
+    if(i<nkey || fscanf(fp,"%lld %lld %lld",&len,&i0,&i1)!=3 || len<0){
+      free(key);
+      break;
+    }
+    e=ra_entry_new((SHORT )method,name,NULL,(INT )nkey,key,(INT )len);
+    free(key);
+    e->iout[0]=(INT )i0; e->iout[1]=(INT )i1;
+    if(fscanf(fp,"%lg",&e->err)!=1) {ra_entry_free(e); break;}
+    for(i=0;i<7*len;i++) if(fscanf(fp,"%lg",&e->rpzwf[i])!=1) break;
+    if(i<7*len) {ra_entry_free(e); break;}
+    e->next=ra_list;
+    ra_list=e;
+  }
+  fclose(fp);
+}
+
+/* look up a key; on a hit rpzwf[0..6] get a copy of the arrays */
+static struct ra_entry *ra_cache_get(const SHORT method,
+                                     const char *fname,
+                                     void *func,
+                                     const INT nkey,
+                                     const REAL16 *key,
+                                     REAL **rpzwf)
+{
+  struct ra_entry *e;
+  INT k;
+  haz_lock(&ra_lock);
+  if(!ra_file_read) ra_file_load();
+  for(e=ra_list;e;e=e->next){
+    if(e->method!=method || e->nkey!=nkey) continue;
+    if(fname ? (e->func || strcmp(e->fname,fname)) : (e->func!=func)) continue;
+    if(memcmp(e->key,key,nkey*sizeof(REAL16))){
+      // compare the values (the padding of REAL16 may differ)
+      for(k=0;k<nkey;k++) if(e->key[k]!=key[k]) break;
+      if(k<nkey) continue;
+    }
+    break;
+  }
+  if(e){
+    rpzwf[0]=calloc(7*MAX(e->len,1),sizeof(REAL));
+    memcpy(rpzwf[0],e->rpzwf,7*e->len*sizeof(REAL));
+    for(k=1;k<7;k++) rpzwf[k]=rpzwf[k-1]+e->len;
+  }
+  haz_unlock(&ra_lock);
+  return e;
+}
+
+/* store a result; named entries are also appended to the file */
+static void ra_cache_put(struct ra_entry *e,
+                         REAL **rpzwf)
+{
+  INT k;
+  FILE *fp;
+  for(k=0;k<7;k++) memcpy(e->rpzwf+k*e->len,rpzwf[k],e->len*sizeof(REAL));
+  haz_lock(&ra_lock);
+  e->next=ra_list;
+  ra_list=e;
+  if(ra_file && !e->func && e->fname[0] && (fp=fopen(ra_file,"a"))){
+    ra_entry_write(fp,e);
+    fclose(fp);
+  }
+  haz_unlock(&ra_lock);
+}
+
+/**********************************************************************/
+/*!
+ * \fn void ra_cache_file(const char *filename)
+ *
+ * \brief Keeps the cache of rational approximations also in a file
+ *
+ * \param filename  name of the file (read at the next lookup, appended
+ *                  to on every miss); NULL: memory only
+ *
+ */
+void ra_cache_file(const char *filename)
+{
+  haz_lock(&ra_lock);
+  if(ra_file) free(ra_file);
+  ra_file=filename ? strdup(filename) : NULL;
+  ra_file_read=0;
+  haz_unlock(&ra_lock);
+}
+
+/**********************************************************************/
+/*!
+ * \fn void ra_cache_free(void)
+ *
+ * \brief Empties the in-memory cache of rational approximations (the
+ *        file, if any, is kept and read again at the next lookup)
+ *
+ */
+void ra_cache_free(void)
+{
+  struct ra_entry *e;
+  haz_lock(&ra_lock);
+  while(ra_list){
+    e=ra_list;
+    ra_list=e->next;
+    ra_entry_free(e);
+  }
+  ra_file_read=0;
+  haz_unlock(&ra_lock);
+}
+
+/**********************************************************************/
+/*!
+ * \fn REAL get_rpzwf_cached(const char *fname,
+ *                           REAL16 (*func)(REAL16, REAL16, REAL16, REAL16, REAL16),
+ *                           REAL16 s, REAL16 t, REAL16 alpha, REAL16 beta,
+ *                           INT numval, REAL xmin, REAL xmax, REAL **rpzwf,
+ *                           INT *mmax_in, INT *m_out, REAL tolaaa, INT print_level)
+ *
+ * \brief AAA rational approximation of func(x,s,t,alpha,beta) on numval
+ *        points in [xmin,xmax] (set_f_values + get_rpzwf), computed once
+ *        for every set of parameters
+ *
+ * \param fname     name identifying func in the cache (e.g. "frac_inv");
+ *                  NULL: identified by the pointer, memory only
+ * \param func      the function to approximate
+ * \param s,t,alpha,beta  parameters of func
+ * \param numval    number of points in [xmin,xmax]
+ * \param rpzwf     output, as in get_rpzwf (free rpzwf[0] only)
+ * \param mmax_in   as in get_rpzwf
+ * \param m_out     as in get_rpzwf
+ * \param tolaaa    as in get_rpzwf
+ * \param print_level  as in get_rpzwf
+ *
+ * \return          as get_rpzwf: the error at the points
+ *
+ */
+REAL get_rpzwf_cached(const char *fname,
+                      REAL16 (*func)(REAL16, REAL16, REAL16, REAL16, REAL16),
+                      REAL16 s,
+                      REAL16 t,
+                      REAL16 alpha,
+                      REAL16 beta,
+                      INT numval,
+                      REAL xmin,
+                      REAL xmax,
+                      REAL **rpzwf,
+                      INT *mmax_in,
+                      INT *m_out,
+                      REAL tolaaa,
+                      INT print_level)
+{
+  REAL16 key[9]={s,t,alpha,beta,(REAL16 )numval,(REAL16 )xmin,(REAL16 )xmax,
+                 (REAL16 )mmax_in[0],(REAL16 )tolaaa};
+  struct ra_entry *e;
+  REAL err;
+
+  e=ra_cache_get(RA_CACHE_AAA,fname,(void *)func,9,key,rpzwf);
+  if(e){
+    m_out[0]=e->iout[0];
+    mmax_in[0]=e->iout[1];
+    if(print_level>1)
+      fprintf(stdout,"\n%%%% %s: rational approximation (%lld nodes) from the cache\n",
+              __FUNCTION__,(long long )m_out[0]);
+    return e->err;
+  }
+
+  REAL16 **zf=set_f_values(func,s,t,alpha,beta,&numval,xmin,xmax,print_level);
+  err=get_rpzwf(numval,zf[0],zf[1],rpzwf,mmax_in,m_out,tolaaa,print_level);
+  free(zf[0]);
+  free(zf[1]);
+  free(zf);
+
+  e=ra_entry_new(RA_CACHE_AAA,fname,(void *)func,9,key,m_out[0]+1);
+  e->iout[0]=m_out[0];
+  e->iout[1]=mmax_in[0];
+  e->err=err;
+  ra_cache_put(e,rpzwf);
+  return err;
+}
+
+/**********************************************************************/
+/*!
+ * \fn REAL get_rpzwf_brasil_cached(const char *fname, REAL16 (*f)(REAL16, void*),
+ *                                  REAL16 *param, INT nparam, REAL **rpzwf, REAL a,
+ *                                  REAL b, INT deg, INT init_steps, INT maxiter,
+ *                                  REAL step_factor, REAL max_step_size, REAL tol,
+ *                                  INT *iter_brasil, INT print_level)
+ *
+ * \brief get_rpzwf_brasil computed once for every set of parameters
+ *
+ * \param fname     name identifying f in the cache; NULL: identified by
+ *                  the pointer, memory only
+ * \param f         the function to approximate
+ * \param param     the parameters of f (passed to f as void *)
+ * \param nparam    number of parameters; they are part of the key
+ * \param ...       the rest as in get_rpzwf_brasil
+ *
+ * \return          as get_rpzwf_brasil
+ *
+ */
+REAL get_rpzwf_brasil_cached(const char *fname,
+                             REAL16 (*f)(REAL16, void*),
+                             REAL16 *param,
+                             INT nparam,
+                             REAL **rpzwf,
+                             REAL a,
+                             REAL b,
+                             INT deg,
+                             INT init_steps,
+                             INT maxiter,
+                             REAL step_factor,
+                             REAL max_step_size,
+                             REAL tol,
+                             INT *iter_brasil,
+                             INT print_level)
+{
+  INT i,nkey=nparam+8;
+  REAL16 *key=(REAL16 *)calloc(nkey,sizeof(REAL16));
+  struct ra_entry *e;
+  REAL err;
+
+  for(i=0;i<nparam;i++) key[i]=param[i];
+  key[nparam]=(REAL16 )a;
+  key[nparam+1]=(REAL16 )b;
+  key[nparam+2]=(REAL16 )deg;
+  key[nparam+3]=(REAL16 )init_steps;
+  key[nparam+4]=(REAL16 )maxiter;
+  key[nparam+5]=(REAL16 )step_factor;
+  key[nparam+6]=(REAL16 )max_step_size;
+  key[nparam+7]=(REAL16 )tol;
+
+  e=ra_cache_get(RA_CACHE_BRASIL,fname,(void *)f,nkey,key,rpzwf);
+  if(e){
+    iter_brasil[0]=e->iout[0];
+    free(key);
+    return e->err;
+  }
+
+  err=get_rpzwf_brasil(f,(void *)param,rpzwf,a,b,deg,init_steps,maxiter,
+                       step_factor,max_step_size,tol,iter_brasil,print_level);
+
+  e=ra_entry_new(RA_CACHE_BRASIL,fname,(void *)f,nkey,key,deg+1);
+  e->iout[0]=iter_brasil[0];
+  e->err=err;
+  ra_cache_put(e,rpzwf);
+  free(key);
+  return err;
+}
+/*EOF*/
@@ -188,6 +188,207 @@ void local_coords(const INT dim,REAL *xs,INT *nodes, REAL *x)
   return;
 }
 /*************************************************************************/
+/*!
+ * \fn void local_coords_batch(const INT dim,const INT nb,REAL *xsb,
+ *                             INT *nodes,REAL *x)
+ *
+ * \brief grabs the coordinates of the vertices of nb consecutive
+ *        simplices and stores them in structure-of-arrays (SoA)
+ *        layout: coordinate i of vertex j of simplex l is at
+ *        xsb[(j*dim+i)*P1_BATCH+l]. Lanes l=nb..P1_BATCH-1 are filled
+ *        with the coordinates of lane 0 so that the batched kernels
+ *        can always run over all P1_BATCH lanes.
+ *
+ * \param dim     I: The dimension of the problem.
+ * \param nb      I: number of simplices in the batch (1<=nb<=P1_BATCH)
+ * \param xsb     O: (dim+1)*dim*P1_BATCH array with the coordinates.
+ * \param nodes   I: the rows of the element_to_vertex matrix for
+ *                   the simplices in the batch (nb*(dim+1) entries).
+ * \param x       I: coordinates of the vertices of the mesh
+ *
+ * \return
+ *
+ * \note
+ */
+void local_coords_batch(const INT dim,const INT nb,REAL *xsb,	\
+			INT *nodes,REAL *x)
+{
+  INT dim1=dim+1,i,j,l,k,jdim;
+  for(l=0;l<P1_BATCH;l++){
+    for(j=0;j<dim1;j++){
+      // padded lanes copy lane 0.
+      k=(l<nb)?nodes[l*dim1+j]:nodes[j];
+      jdim=j*dim;
+      for(i=0;i<dim;i++)
+	xsb[(jdim+i)*P1_BATCH+l]=x[k*dim+i];
+    }
+  }
+  return;
+}
+/*************************************************************************/
+/*!
+ * \fn SHORT grad_compute_batch(INT dim, REAL factorial, REAL *xsb,
+ *                              REAL *gradb,void *wrk)
+ *
+ * \brief Batched version of grad_compute(): computes the gradients
+ *        of the barycentric coordinates for P1_BATCH simplices at
+ *        once. Input and output are in SoA layout (the simplex index
+ *        runs fastest), so the loops over the lanes vectorize. For
+ *        dim=1,2,3 the inverse of B^T is computed by cofactors
+ *        (no pivoting, no branches); for dim>3 every lane is
+ *        processed with grad_compute().
+ *
+ * \param dim        I: The dimension of the problem.
+ * \param factorial  I: dim! (dim factorial)
+ * \param xsb        I: coordinates, xsb[(j*dim+i)*P1_BATCH+l]
+ * \param gradb      O: gradients, gradb[(j*dim+i)*P1_BATCH+l] is the
+ *                      i-th component of grad(lambda_j) on simplex l.
+ * \param wrk        W: working array of dimension
+ *                      (dim+1)*dim*2*sizeof(REAL)
+ *                      +(dim+1)*(dim*sizeof(REAL) + sizeof(INT)).
+ *                      Only used if dim>3.
+ *
+ * \return number of degenerate simplices in the batch. The gradients
+ *         on a degenerate simplex are set to zero.
+ *
+ * \note
+ */
+SHORT grad_compute_batch(INT dim, REAL factorial, REAL *xsb,	\
+			 REAL *gradb,void *wrk)
+{
+  INT dim1=dim+1,i,l,k,ndeg=0;
+  REAL det[P1_BATCH],dinv[P1_BATCH];
+  REAL *x0=xsb,*x1=xsb+dim*P1_BATCH;
+  REAL a[P1_BATCH],b[P1_BATCH],c[P1_BATCH],d[P1_BATCH];
+  switch(dim){
+  case 1:
+    for(l=0;l<P1_BATCH;l++){
+      det[l]=x1[l]-x0[l];
+      dinv[l]=(det[l]!=0e0)?(1e0/det[l]):0e0;
+      gradb[P1_BATCH+l]=dinv[l];
+      gradb[l]=-dinv[l];
+    }
+    break;
+  case 2:
+    {
+      REAL *x2=xsb+2*dim*P1_BATCH;
+      for(l=0;l<P1_BATCH;l++){
+	// rows of bt are (x1-x0) and (x2-x0);
+	a[l]=x1[l]-x0[l];	b[l]=x1[P1_BATCH+l]-x0[P1_BATCH+l];
+	c[l]=x2[l]-x0[l];	d[l]=x2[P1_BATCH+l]-x0[P1_BATCH+l];
+	det[l]=a[l]*d[l]-b[l]*c[l];
+	dinv[l]=(det[l]!=0e0)?(1e0/det[l]):0e0;
+	gradb[2*P1_BATCH+l]=d[l]*dinv[l];
+	gradb[3*P1_BATCH+l]=-c[l]*dinv[l];
+	gradb[4*P1_BATCH+l]=-b[l]*dinv[l];
+	gradb[5*P1_BATCH+l]=a[l]*dinv[l];
+	gradb[l]=-gradb[2*P1_BATCH+l]-gradb[4*P1_BATCH+l];
+	gradb[P1_BATCH+l]=-gradb[3*P1_BATCH+l]-gradb[5*P1_BATCH+l];
+      }
+    }
+    break;
+  case 3:
+    {
+      REAL *x2=xsb+2*dim*P1_BATCH,*x3=xsb+3*dim*P1_BATCH;
+      REAL r[9],cf[9];
+      for(l=0;l<P1_BATCH;l++){
+	// r=bt (rows x_k-x_0) and cf are the cofactors of bt;
+	for(i=0;i<3;i++){
+	  r[i]=x1[i*P1_BATCH+l]-x0[i*P1_BATCH+l];
+	  r[3+i]=x2[i*P1_BATCH+l]-x0[i*P1_BATCH+l];
+	  r[6+i]=x3[i*P1_BATCH+l]-x0[i*P1_BATCH+l];
+	}
+	// cf0=r1 x r2; cf1=r2 x r0; cf2=r0 x r1;
+	cf[0]=r[4]*r[8]-r[5]*r[7];
+	cf[1]=r[5]*r[6]-r[3]*r[8];
+	cf[2]=r[3]*r[7]-r[4]*r[6];
+	cf[3]=r[7]*r[2]-r[8]*r[1];
+	cf[4]=r[8]*r[0]-r[6]*r[2];
+	cf[5]=r[6]*r[1]-r[7]*r[0];
+	cf[6]=r[1]*r[5]-r[2]*r[4];
+	cf[7]=r[2]*r[3]-r[0]*r[5];
+	cf[8]=r[0]*r[4]-r[1]*r[3];
+	det[l]=r[0]*cf[0]+r[1]*cf[1]+r[2]*cf[2];
+	dinv[l]=(det[l]!=0e0)?(1e0/det[l]):0e0;
+	for(i=0;i<3;i++){
+	  gradb[(3+i)*P1_BATCH+l]=cf[i]*dinv[l];
+	  gradb[(6+i)*P1_BATCH+l]=cf[3+i]*dinv[l];
+	  gradb[(9+i)*P1_BATCH+l]=cf[6+i]*dinv[l];
+	  gradb[i*P1_BATCH+l]=-(cf[i]+cf[3+i]+cf[6+i])*dinv[l];
+	}
+      }
+    }
+    break;
+  default:
+    {
+      // general dimension: one simplex at a time with pivoting.
+      REAL *xs=(REAL *)wrk;
+      REAL *grad=xs+dim1*dim;
+      void *wrk1=(void *)(grad+dim1*dim);
+      for(l=0;l<P1_BATCH;l++){
+	for(k=0;k<dim1*dim;k++)
+	  xs[k]=xsb[k*P1_BATCH+l];
+	if(grad_compute(dim,factorial,xs,grad,wrk1)){
+	  det[l]=0e0;
+	  memset(grad,0,dim1*dim*sizeof(REAL));
+	} else {
+	  det[l]=1e0;
+	}
+	for(k=0;k<dim1*dim;k++)
+	  gradb[k*P1_BATCH+l]=grad[k];
+      }
+    }
+    break;
+  }
+  for(l=0;l<P1_BATCH;l++)
+    if(det[l]==0e0) ndeg++;
+  return ndeg;
+}
+/*************************************************************************/
+/*!
+ * \fn void local_sm_batch(REAL *slocalb,REAL *gradb,const INT dim,
+ *                         const REAL *vols)
+ *
+ * \brief Batched version of local_sm(): computes (grad lambda_i,grad
+ *        lambda_j)*vol for P1_BATCH simplices. All arrays are in SoA
+ *        layout.
+ *
+ * \param slocalb O: (dim+1)*(dim+1)*P1_BATCH local matrices;
+ *                   slocalb[(i*(dim+1)+j)*P1_BATCH+l].
+ * \param gradb   I: gradients from grad_compute_batch().
+ * \param dim     I: The dimension of the problem.
+ * \param vols    I: P1_BATCH volumes of the simplices.
+ *
+ * \return
+ *
+ * \note only the upper triangle is computed; the lower is copied.
+ */
+void local_sm_batch(REAL *slocalb,			\
+		    REAL *gradb,			\
+		    const INT dim,			\
+		    const REAL *vols)
+{
+  INT dim1=dim+1,i,j,k,l;
+  REAL *gi,*gj,*sij;
+  for(i=0;i<dim1;++i){
+    for(j=i;j<dim1;++j){
+      sij=slocalb+(i*dim1+j)*P1_BATCH;
+      for(l=0;l<P1_BATCH;l++) sij[l]=0e0;
+      for(k=0;k<dim;++k){
+	gi=gradb+(i*dim+k)*P1_BATCH;
+	gj=gradb+(j*dim+k)*P1_BATCH;
+	for(l=0;l<P1_BATCH;l++)
+	  sij[l]+=gi[l]*gj[l];
+      }
+      for(l=0;l<P1_BATCH;l++)
+	sij[l]*=vols[l];
+      if(j>i)
+	memcpy(slocalb+(j*dim1+i)*P1_BATCH,sij,P1_BATCH*sizeof(REAL));
+    }
+  }
+  return;
+}
+/*************************************************************************/
 /*!
  * \fn void assemble_p1(scomplex *sc, dCSRmat *A, dCSRmat *M)
  *
@@ -205,7 +406,7 @@ void local_coords(const INT dim,REAL *xs,INT *nodes, REAL *x)
 INT assemble_p1(scomplex *sc, dCSRmat *A, dCSRmat *M)
 {
   // read the mesh on the cube or square:
-  INT i,j,k,idim1,jdim1;  // loop and working
+  INT i,j,k,l,i0,nb,idim1,jdim1;  // loop and working
   INT ns,nv,nnz,nnzp; // num simplices, vertices, num nonzeroes
   REAL volume,fact; //mass matrix entries and dim factorial.  
   // for simplices: number of vertices per simplex. 
@@ -221,13 +422,16 @@ INT assemble_p1(scomplex *sc, dCSRmat *A, dCSRmat *M)
   REAL *mlocal=local_mm(dim);
   //  fprintf(stdout,"\nnum_simplices=%d ; num_vertices=%d",ns,nv);fflush(stdout);
   // to compute the volume and to grab the local coordinates of the vertices in the simplex we need some work space
-  REAL *slocal=calloc(dim1*dim1,sizeof(REAL));// local stiffness matrix.
-  REAL *grad=calloc(dim1*dim,sizeof(REAL));// local matrix with
-					   // gradients from which
-					   // many things can be
-					   // computed.
-  REAL *xs=calloc(dim*dim1,sizeof(REAL));// for the local coordinates of vertices of a simplex;
-  void *wrk=calloc(dim1*dim1,sizeof(REAL));// this is used in every simplex but is allocated only once.
+  // the local computations are done in batches of P1_BATCH
+  // simplices with the simplex number running fastest (SoA layout).
+  REAL *slocal=calloc(dim1*dim1*P1_BATCH,sizeof(REAL));// local stiffness matrices.
+  REAL *grad=calloc(dim1*dim*P1_BATCH,sizeof(REAL));// gradients of
+						    // the barycentric
+						    // coordinates.
+  REAL *xs=calloc(dim*dim1*P1_BATCH,sizeof(REAL));// for the local coordinates of vertices of the simplices;
+  REAL *volb=calloc(P1_BATCH,sizeof(REAL));// volumes of the simplices in a batch.
+  // this is used in every batch but is allocated only once (only needed if dim>3).
+  void *wrk=calloc(dim1*dim*2+dim1*(dim+1),sizeof(REAL));
   ////////////////////// ASSEMBLY BEGINS HERE:
   // create a block diagonal mass and stiffness matrices with the local matrices on the diagonal
   dCSRmat *m_dg=malloc(sizeof(dCSRmat));
@@ -246,30 +450,30 @@ INT assemble_p1(scomplex *sc, dCSRmat *A, dCSRmat *M)
   //
   nnz=0;
   m_dg->IA[0]=nnz;  
-  for(i=0;i<ns;++i){
-    idim1=i*dim1;
-    // grab the vertex coordinates and compute the volume of the simplex.
-    local_coords(dim,xs,&sc->nodes[idim1],sc->x);// sc->nodes[idim1:idim1+dim]
-						 // point to global
-						 // vertex numbers in
-						 // element i
+  for(i0=0;i0<ns;i0+=P1_BATCH){
+    nb=MIN(P1_BATCH,ns-i0);
+    // grab the vertex coordinates of the batch;
+    local_coords_batch(dim,nb,xs,&sc->nodes[i0*dim1],sc->x);
     // compute gradients
-    grad_compute(dim, fact, xs, grad,wrk);
-    //    print_full_mat(dim1,dim,grad,"grad");fflush(stdout);
-    volume=sc->vols[i];
-    //    sc->vols[i]=volume;
-    //    fprintf(stdout,"\nvolume[%d]=%.5e",i,sc->vols[i]);fflush(stdout);
-    // copute local stiffness matrix as grad*transpose(grad);
-    local_sm(slocal,grad,dim,volume);
-    for(j=0;j<dim1;j++){
-      jdim1=j*dim1;
-      for(k=0;k<dim1;k++){
-	m_dg->JA[nnz]=idim1+k;
-	m_dg->val[nnz]=mlocal[jdim1+k]*volume;
-	a_dg->val[nnz]=slocal[jdim1+k];
-	nnz++;
+    grad_compute_batch(dim, fact, xs, grad,wrk);
+    for(l=0;l<P1_BATCH;l++)
+      volb[l]=(l<nb)?sc->vols[i0+l]:0e0;
+    // copute local stiffness matrices as grad*transpose(grad);
+    local_sm_batch(slocal,grad,dim,volb);
+    for(l=0;l<nb;l++){
+      i=i0+l;
+      idim1=i*dim1;
+      volume=volb[l];
+      for(j=0;j<dim1;j++){
+	jdim1=j*dim1;
+	for(k=0;k<dim1;k++){
+	  m_dg->JA[nnz]=idim1+k;
+	  m_dg->val[nnz]=mlocal[jdim1+k]*volume;
+	  a_dg->val[nnz]=slocal[(jdim1+k)*P1_BATCH+l];
+	  nnz++;
+	}
+	m_dg->IA[idim1+j+1]=nnz;
       }
-      m_dg->IA[idim1+j+1]=nnz;
     }
   }
   //
@@ -309,6 +513,7 @@ INT assemble_p1(scomplex *sc, dCSRmat *A, dCSRmat *M)
   free(xs);
   free(slocal);
   free(grad);
+  free(volb);
   free(wrk);
   free(mlocal);
   if(P) {
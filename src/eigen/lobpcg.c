@@ -0,0 +1,537 @@
+/*! \file src/eigen/lobpcg.c
+ *
+ *  Copyright 2015__HAZMATH__. All rights reserved.
+ *
+ * \brief Sparse (preconditioned) LOBPCG eigensolver for the smallest
+ *        eigenpairs of A*x = lambda*B*x
+ *
+ * \note Block LOBPCG of Knyazev with soft locking: converged vectors stay
+ *       in the Ritz block X but get no new search directions. The
+ *       Rayleigh-Ritz step on span[X,W,P] is done with the SVQB
+ *       orthogonalization, so nearly dependent directions are dropped;
+ *       its small dense eigenproblems use LAPACK (dsygv) if available
+ *       and Jacobi otherwise. The Gram matrices and the linear
+ *       combinations of the blocks are done by ddense_gemm. Only A*W
+ *       and B*W are computed in every iteration; A*X, B*X, A*P and B*P
+ *       are updated by the same linear combinations as X and P.
+ *
+ *       Vectors are stored one after another: vector j of a block of
+ *       size n*k starts at j*n. This is also the layout of evectors in
+ *       eigsymm (eigenvector j in row j).
+ */
+
+#include "hazmath.h"
+
+#define LOBPCG_CHUNK  256    /* rows per chunk in the tall-skinny kernels */
+#define LOBPCG_DROP   1e-12  /* relative drop tolerance in SVQB */
+
+/******************************************************************************/
+/* G = S^T*T (m x m, symmetric) for m vectors of length n. The vectors
+   are copied by chunks of rows into buf (2*m*LOBPCG_CHUNK REALs): S^T
+   as m x c and T as c x m, and the product is done by ddense_gemm */
+static void lobpcg_gram(const INT n,
+                        const INT m,
+                        REAL **s,
+                        REAL **t,
+                        REAL *G,
+                        REAL *buf)
+{
+  INT i0,c,a,b,l;
+  REAL *sp = buf, *tp = buf+m*LOBPCG_CHUNK;
+  memset(G,0,m*m*sizeof(REAL));
+  for(i0=0;i0<n;i0+=LOBPCG_CHUNK) {
+    c = MIN(n-i0,LOBPCG_CHUNK);
+    for(a=0;a<m;a++) {
+      memcpy(sp+a*c,s[a]+i0,c*sizeof(REAL));
+      for(l=0;l<c;l++) tp[l*m+a] = t[a][i0+l];
+    }
+    ddense_gemm(m,m,c,1.0,sp,c,tp,m,G,m);
+  }
+  for(a=0;a<m;a++)
+    for(b=a+1;b<m;b++) G[a*m+b] = G[b*m+a] = 0.5*(G[a*m+b]+G[b*m+a]);
+}
+
+/* out[j] (+)= sum_i s[i]*C[i+j*ldc], j<ncol. Row j of the ncol x ns
+   matrix C^T starts at C+j*ldc; the chunks of s and out are copied to
+   buf ((ns+ncol)*LOBPCG_CHUNK REALs) for ddense_gemm */
+static void lobpcg_comb(const INT n,
+                        const INT ns,
+                        REAL **s,
+                        const REAL *C,
+                        const INT ldc,
+                        const INT ncol,
+                        REAL **out,
+                        const SHORT add,
+                        REAL *buf)
+{
+  INT i0,c,i,j;
+  REAL *sp = buf, *yp = buf+ns*LOBPCG_CHUNK;
+  for(i0=0;i0<n;i0+=LOBPCG_CHUNK) {
+    c = MIN(n-i0,LOBPCG_CHUNK);
+    for(i=0;i<ns;i++) memcpy(sp+i*c,s[i]+i0,c*sizeof(REAL));
+    if(add) for(j=0;j<ncol;j++) memcpy(yp+j*c,out[j]+i0,c*sizeof(REAL));
+    else memset(yp,0,ncol*c*sizeof(REAL));
+    ddense_gemm(ncol,c,ns,1.0,C,ldc,sp,c,yp,c);
+    for(j=0;j<ncol;j++) memcpy(out[j]+i0,yp+j*c,c*sizeof(REAL));
+  }
+}
+
+/* eigenvalues d (ascending) and eigenvectors (columns of v, v[i+j*m])
+   of a symmetric m x m matrix a (destroyed). With LAPACK this is dsygv
+   with B = I as in eigsymm; otherwise cyclic Jacobi */
+static void lobpcg_syev(const INT m,
+                        REAL *a,
+                        REAL *d,
+                        REAL *v)
+{
+#if WITH_LAPACK
+  char uplo='U',jobz='V';
+  INT i,nn=m,itype=1,lwork=3*m+6,info=0;
+  REAL *bf = (REAL *)calloc(m*m+lwork,sizeof(REAL));
+  for(i=0;i<m;i++) bf[i+i*m] = 1.0;
+  // a is symmetric, so by rows is by columns; v gets the columns
+  memcpy(v,a,m*m*sizeof(REAL));
+  dsygv_(&itype,&jobz,&uplo,&nn,v,&nn,bf,&nn,d,bf+m*m,&lwork,&info);
+  free(bf);
+  if(info) {
+    fprintf(stderr,"\nXXX: lapack error info during eigenvalue computations=%lld (n=%lld)\n",(long long )info,(long long )m);fflush(stderr);
+    exit(16);
+  }
+#else
+  INT p,q,i,sweep;
+  REAL off,nrm,apq,theta,t,c,s,x,y;
+  memset(v,0,m*m*sizeof(REAL));
+  for(i=0;i<m;i++) v[i+i*m] = 1.0;
+  for(sweep=0;sweep<100;sweep++) {
+    off = 0.0; nrm = 0.0;
+    for(p=0;p<m;p++) {
+      nrm += a[p*m+p]*a[p*m+p];
+      for(q=p+1;q<m;q++) off += a[p*m+q]*a[p*m+q];
+    }
+    if(off<=SMALLREAL2*nrm) break;
+    for(p=0;p<m;p++) {
+      for(q=p+1;q<m;q++) {
+        apq = a[p*m+q];
+        if(apq==0.0) continue;
+        if(fabs(apq)<=1e-18*(fabs(a[p*m+p])+fabs(a[q*m+q]))) { // negligible
+          a[p*m+q] = a[q*m+p] = 0.0;
+          continue;
+        }
+        theta = (a[q*m+q]-a[p*m+p])/(2.0*apq);
+        t = 1.0/(fabs(theta)+sqrt(theta*theta+1.0));
+        if(theta<0.0) t = -t;
+        c = 1.0/sqrt(t*t+1.0); s = t*c;
+        for(i=0;i<m;i++) { // columns p,q
+          x = a[i*m+p]; y = a[i*m+q];
+          a[i*m+p] = c*x-s*y; a[i*m+q] = s*x+c*y;
+        }
+        for(i=0;i<m;i++) { // rows p,q
+          x = a[p*m+i]; y = a[q*m+i];
+          a[p*m+i] = c*x-s*y; a[q*m+i] = s*x+c*y;
+        }
+        a[p*m+q] = a[q*m+p] = 0.0;
+        for(i=0;i<m;i++) {
+          x = v[i+p*m]; y = v[i+q*m];
+          v[i+p*m] = c*x-s*y; v[i+q*m] = s*x+c*y;
+        }
+      }
+    }
+  }
+  for(i=0;i<m;i++) d[i] = a[i*m+i];
+  // selection sort (m is small)
+  for(p=0;p<m;p++) {
+    q = p;
+    for(i=p+1;i<m;i++) if(d[i]<d[q]) q = i;
+    if(q==p) continue;
+    x = d[p]; d[p] = d[q]; d[q] = x;
+    for(i=0;i<m;i++) { x = v[i+p*m]; v[i+p*m] = v[i+q*m]; v[i+q*m] = x; }
+  }
+#endif
+}
+
+/* Rayleigh-Ritz on span(S) given GA = S^T*A*S and GB = S^T*B*S (m x m).
+   Returns the rank r kept by SVQB; on return theta[0..k) are the k
+   smallest Ritz values and C (m x k, C[i+j*m]) the coefficients of the
+   Ritz vectors, which are B-orthonormal. work: 5*m*m+2*m REALs */
+static INT lobpcg_rr(const INT m,
+                     const INT k,
+                     const REAL *GA,
+                     const REAL *GB,
+                     REAL *theta,
+                     REAL *C,
+                     REAL *work)
+{
+  INT i,j,c,q0,r;
+  REAL sum;
+  REAL *d = work, *lam = d+m, *M1 = lam+m, *V = M1+m*m, *T = V+m*m;
+  REAL *U = T+m*m, *Y = U+m*m;
+
+  // SVQB: scaled Gram matrix of S in the B inner product
+  for(i=0;i<m;i++) d[i] = (GB[i*m+i]>0.0) ? 1.0/sqrt(GB[i*m+i]) : 0.0;
+  for(i=0;i<m;i++)
+    for(j=0;j<m;j++) M1[i*m+j] = d[i]*GB[i*m+j]*d[j];
+  lobpcg_syev(m,M1,lam,V);
+  for(q0=0;q0<m;q0++) if(lam[q0]>LOBPCG_DROP*lam[m-1]) break;
+  r = m-q0;
+  if(r<k) return r;
+
+  // T = D*V*Lambda^{-1/2} on the kept directions (m x r)
+  for(c=0;c<r;c++) {
+    sum = 1.0/sqrt(lam[q0+c]);
+    for(i=0;i<m;i++) T[i+c*m] = d[i]*V[i+(q0+c)*m]*sum;
+  }
+  // M1 = T^T*GA*T (r x r)
+  for(c=0;c<r;c++)
+    for(i=0;i<m;i++) {
+      for(sum=0.0,j=0;j<m;j++) sum += GA[i*m+j]*T[j+c*m];
+      U[i+c*m] = sum;
+    }
+  for(i=0;i<r;i++)
+    for(c=i;c<r;c++) {
+      for(sum=0.0,j=0;j<m;j++) sum += T[j+i*m]*U[j+c*m];
+      M1[i*r+c] = M1[c*r+i] = sum;
+    }
+  lobpcg_syev(r,M1,lam,Y);
+
+  // C = T*Y(:,0:k)
+  for(j=0;j<k;j++) {
+    theta[j] = lam[j];
+    for(i=0;i<m;i++) {
+      for(sum=0.0,c=0;c<r;c++) sum += T[i+c*m]*Y[c+j*r];
+      C[i+j*m] = sum;
+    }
+  }
+  return r;
+}
+
+/* blk[1] = A*blk[0], blk[2] = B*blk[0] for the first ncol vectors */
+static void lobpcg_apply(dCSRmat *A,
+                         dCSRmat *B,
+                         const INT n,
+                         const INT ncol,
+                         REAL **blk)
+{
+  INT j;
+  for(j=0;j<ncol;j++) {
+    dcsr_mxv(A,blk[0]+j*n,blk[1]+j*n);
+    if(B) dcsr_mxv(B,blk[0]+j*n,blk[2]+j*n);
+  }
+}
+
+/* max_i sum_j |a_ij| */
+static REAL lobpcg_normi(dCSRmat *A)
+{
+  INT i,k;
+  REAL s,nrm=0.0;
+  for(i=0;i<A->row;i++) {
+    for(s=0.0,k=A->IA[i];k<A->IA[i+1];k++) s += fabs(A->val[k]);
+    nrm = MAX(nrm,s);
+  }
+  return nrm;
+}
+
+/******************************************************************************/
+/*!
+ * \fn INT eig_lobpcg(dCSRmat *A, dCSRmat *B, const INT nev, REAL *evalues,
+ *                    REAL *evectors, precond *pc, const REAL tol,
+ *                    const INT MaxIt, const SHORT prtlvl)
+ *
+ * \brief Preconditioned block LOBPCG for the nev smallest eigenpairs of
+ *        A*x = lambda*B*x, A and B symmetric, B positive definite
+ *
+ * \param A         Pointer to dCSRmat matrix A
+ * \param B         Pointer to dCSRmat matrix B (NULL: identity)
+ * \param nev       Number of eigenpairs
+ * \param evalues   Eigenvalues in ascending order (nev REALs)
+ * \param evectors  On entry the initial block (all zeros: random), on
+ *                  return the B-orthonormal eigenvectors (nev*n REALs,
+ *                  eigenvector j in evectors[j*n..j*n+n-1])
+ * \param pc        Preconditioner applied to the residuals (NULL: none),
+ *                  e.g. an AMG cycle for A (see eig_lobpcg_amg)
+ * \param tol       Tolerance for the backward error
+ *                  ||A*x-lambda*B*x||/((||A||+|lambda|*||B||)*||x||)
+ * \param MaxIt     Maximal number of iterations
+ * \param prtlvl    How much information to print out
+ *
+ * \return          Number of iterations if converged; ERROR otherwise.
+ *
+ * \note Memory: 12*nev vectors (9*nev if B is NULL).
+ *
+ */
+INT eig_lobpcg(dCSRmat *A,
+               dCSRmat *B,
+               const INT nev,
+               REAL *evalues,
+               REAL *evectors,
+               precond *pc,
+               const REAL tol,
+               const INT MaxIt,
+               const SHORT prtlvl)
+{
+  const INT n = A->row, k = nev, mmax = 3*nev;
+  const INT nq = (B) ? 3 : 2;
+  const REAL normA = lobpcg_normi(A), normB = (B) ? lobpcg_normi(B) : 1.0;
+
+  INT i,j,q,it,m,r,na=k,np,status=ERROR_SOLVER_MAXIT;
+  SHORT haveP=0;
+  REAL resmax=0.0, *tmp;
+  REAL solver_start, solver_end;
+  unsigned long seed = 20150819;
+
+  // X, W, P, T blocks; [0] vectors, [1] A*vectors, [2] B*vectors
+  REAL *blk[4][3], *mem, *buf;
+  REAL **s[3], **out[3];
+  INT *act = (INT *)calloc(k,sizeof(INT));
+  REAL *theta = (REAL *)calloc(k+k+k*mmax+2*mmax*mmax+5*mmax*mmax+2*mmax,sizeof(REAL));
+  REAL *res = theta+k, *coef = res+k, *GA = coef+k*mmax, *GB = GA+mmax*mmax;
+  REAL *work = GB+mmax*mmax, *C = coef;
+
+  if(n<mmax) {
+    printf("### ERROR: %s: need at least 3*nev=%lld unknowns!\n",__FUNCTION__,(long long )mmax);
+    free(act); free(theta);
+    return ERROR_INPUT_PAR;
+  }
+
+  get_time(&solver_start);
+
+  mem = (REAL *)calloc((size_t )4*nq*n*k,sizeof(REAL));
+  buf = (REAL *)calloc(2*mmax*LOBPCG_CHUNK,sizeof(REAL));
+  for(i=0;i<4;i++) {
+    for(q=0;q<nq;q++) blk[i][q] = mem+(size_t )(i*nq+q)*n*k;
+    if(!B) blk[i][2] = blk[i][0];
+  }
+  for(q=0;q<3;q++) {
+    s[q] = (REAL **)calloc(mmax,sizeof(REAL *));
+    out[q] = (REAL **)calloc(k,sizeof(REAL *));
+  }
+
+  // initial block
+  memcpy(blk[0][0],evectors,n*k*sizeof(REAL));
+  if(array_norminf(n*k,blk[0][0])==0.0) {
+    for(i=0;i<n*k;i++) {
+      seed = seed*6364136223846793005UL+1442695040888963407UL;
+      blk[0][0][i] = (REAL )(seed>>11)/9007199254740992.0-0.5;
+    }
+  }
+  lobpcg_apply(A,B,n,k,blk[0]);
+
+#define LOBPCG_SWAP(a,b) for(q=0;q<3;q++) { tmp = blk[a][q]; blk[a][q] = blk[b][q]; blk[b][q] = tmp; }
+
+  // Rayleigh-Ritz on the initial block: X = X*C
+  for(q=0;q<3;q++)
+    for(j=0;j<k;j++) { s[q][j] = blk[0][q]+j*n; out[q][j] = blk[1][q]+j*n; }
+  lobpcg_gram(n,k,s[0],s[1],GA,buf);
+  lobpcg_gram(n,k,s[0],s[2],GB,buf);
+  r = lobpcg_rr(k,k,GA,GB,theta,C,work);
+  if(r<k) {
+    printf("### ERROR: %s: initial block is rank deficient!\n",__FUNCTION__);
+    status = ERROR_SOLVER_EXIT;
+    goto FINISHED;
+  }
+  for(q=0;q<nq;q++) lobpcg_comb(n,k,s[q],C,k,k,out[q],0,buf);
+  LOBPCG_SWAP(0,1);
+
+  for(it=1;it<=MaxIt+1;it++) {
+
+    // residuals (in T) and the active set
+    for(j=0,na=0,resmax=0.0;j<k;j++) {
+      REAL *rj = blk[3][0]+j*n;
+      array_axpyz(n,-theta[j],blk[0][2]+j*n,blk[0][1]+j*n,rj);
+      res[j] = array_norm2(n,rj)/((normA+fabs(theta[j])*normB)*array_norm2(n,blk[0][0]+j*n));
+      resmax = MAX(resmax,res[j]);
+      if(res[j]>tol) act[na++] = j;
+    }
+    if(prtlvl>=PRINT_MORE) {
+      for(j=0;j<k;j++) printf("%6lld  lambda[%lld] = %.12e  res = %.4e\n",(long long )it-1,(long long )j,theta[j],res[j]);
+    }
+    else if(prtlvl>=PRINT_SOME) {
+      printf("LOBPCG: it %4lld  converged %4lld/%lld  max res = %.4e\n",(long long )it-1,(long long )(k-na),(long long )k,resmax);
+    }
+    if(na==0) { status = it-1; break; }
+    if(it>MaxIt) break;
+
+    // W = preconditioned active residuals, B-orthogonal to X
+    for(j=0;j<na;j++) {
+      if(pc) pc->fct(blk[3][0]+act[j]*n,blk[1][0]+j*n,pc->data);
+      else array_cp(n,blk[3][0]+act[j]*n,blk[1][0]+j*n);
+    }
+    for(q=0;q<3;q++) {
+      for(j=0;j<k;j++) s[q][j] = blk[0][q]+j*n;
+      for(j=0;j<na;j++) s[q][k+j] = blk[1][q]+j*n;
+    }
+    for(j=0;j<na;j++) {
+      REAL *w = s[0][k+j];
+      for(i=0;i<k;i++) coef[i+j*k] = -array_dotprod(n,s[2][i],w);
+    }
+    lobpcg_comb(n,k,s[0],coef,k,na,s[0]+k,1,buf);
+    lobpcg_apply(A,B,n,na,blk[1]);
+
+    // S = [X W P] with P restricted to the active vectors
+    np = (haveP) ? na : 0;
+    for(q=0;q<3;q++)
+      for(j=0;j<np;j++) s[q][k+na+j] = blk[2][q]+act[j]*n;
+    m = k+na+np;
+    lobpcg_gram(n,m,s[0],s[1],GA,buf);
+    lobpcg_gram(n,m,s[0],s[2],GB,buf);
+    r = lobpcg_rr(m,k,GA,GB,theta,C,work);
+    if(r<k && np>0) { // restart without P
+      m = k+na;
+      lobpcg_gram(n,m,s[0],s[1],GA,buf);
+      lobpcg_gram(n,m,s[0],s[2],GB,buf);
+      r = lobpcg_rr(m,k,GA,GB,theta,C,work);
+    }
+    if(r<k) {
+      printf("### ERROR: %s: basis is rank deficient at iteration %lld!\n",__FUNCTION__,(long long )it);
+      status = ERROR_SOLVER_EXIT;
+      break;
+    }
+
+    // T = [W P]*C(k:m,:), X = X*C(0:k,:) + T (written to W), P = T
+    for(q=0;q<3;q++)
+      for(j=0;j<k;j++) out[q][j] = blk[3][q]+j*n;
+    for(q=0;q<nq;q++) lobpcg_comb(n,m-k,s[q]+k,C+k,m,k,out[q],0,buf);
+    for(q=0;q<3;q++)
+      for(j=0;j<k;j++) out[q][j] = blk[1][q]+j*n;
+    for(q=0;q<nq;q++) {
+      memcpy(blk[1][q],blk[3][q],n*k*sizeof(REAL));
+      lobpcg_comb(n,k,s[q],C,m,k,out[q],1,buf);
+    }
+    LOBPCG_SWAP(0,1);
+    LOBPCG_SWAP(2,3);
+    haveP = 1; // P holds all k vectors; the active ones are picked above
+  }
+#undef LOBPCG_SWAP
+
+  if(status==ERROR_SOLVER_MAXIT && prtlvl>PRINT_NONE) {
+    printf("### WARNING: %s: %lld of %lld eigenpairs not converged, max res = %.4e\n",
+           __FUNCTION__,(long long )na,(long long )k,resmax);
+  }
+  for(j=0;j<k;j++) evalues[j] = theta[j];
+  memcpy(evectors,blk[0][0],n*k*sizeof(REAL));
+
+  if(prtlvl>=PRINT_MIN) {
+    get_time(&solver_end);
+    print_cputime("LOBPCG eigensolver", solver_end-solver_start);
+  }
+
+FINISHED:
+  for(q=0;q<3;q++) { free(s[q]); free(out[q]); }
+  free(mem); free(buf); free(act); free(theta);
+  return status;
+}
+
+/******************************************************************************/
+/*!
+ * \fn INT eig_lobpcg_amg(dCSRmat *A, dCSRmat *B, const INT nev, REAL *evalues,
+ *                        REAL *evectors, const REAL shift, const REAL tol,
+ *                        const INT MaxIt, AMG_param *amgparam, const SHORT prtlvl)
+ *
+ * \brief LOBPCG for the nev smallest eigenpairs of A*x = lambda*B*x
+ *        preconditioned by AMG for A+shift*B
+ *
+ * \param A         Pointer to dCSRmat matrix A
+ * \param B         Pointer to dCSRmat matrix B (NULL: identity)
+ * \param nev       Number of eigenpairs
+ * \param evalues   Eigenvalues in ascending order (nev REALs)
+ * \param evectors  Initial block and eigenvectors (nev*n REALs, see eig_lobpcg)
+ * \param shift     Shift of the preconditioned matrix; use shift>0 if A is
+ *                  singular (e.g. graph Laplacians or pure Neumann problems)
+ * \param tol       Tolerance for the backward error (see eig_lobpcg)
+ * \param MaxIt     Maximal number of iterations
+ * \param amgparam  Pointer to parameters for AMG methods
+ * \param prtlvl    How much information to print out
+ *
+ * \return          Number of iterations if converged; ERROR otherwise.
+ *
+ */
+INT eig_lobpcg_amg(dCSRmat *A,
+                   dCSRmat *B,
+                   const INT nev,
+                   REAL *evalues,
+                   REAL *evectors,
+                   const REAL shift,
+                   const REAL tol,
+                   const INT MaxIt,
+                   AMG_param *amgparam,
+                   const SHORT prtlvl)
+{
+  const SHORT max_levels = amgparam->max_levels;
+  const INT n = A->row;
+
+  INT status = SUCCESS;
+  REAL setup_start, setup_end;
+  dCSRmat I;
+
+  get_time(&setup_start);
+
+  // AMG for A+shift*B
+  AMG_data *mgl=amg_data_create(max_levels);
+  if(shift==0.0) {
+    mgl[0].A=dcsr_create(n,n,A->nnz); dcsr_cp(A,&mgl[0].A);
+  }
+  else if(B) {
+    dcsr_add(A,1.0,B,shift,&mgl[0].A);
+  }
+  else {
+    I = dcsr_create_identity_matrix(n,0);
+    dcsr_add(A,1.0,&I,shift,&mgl[0].A);
+    dcsr_free(&I);
+  }
+  mgl[0].b=dvec_create(n); mgl[0].x=dvec_create(n);
+
+  switch (amgparam->AMG_type) {
+
+    case SA_AMG: // Smoothed Aggregation AMG setup
+      status = amg_setup_sa(mgl, amgparam);
+      break;
+
+    default: // Unsmoothed Aggregation AMG
+      status = amg_setup_ua(mgl, amgparam);
+      break;
+
+  }
+
+  if (status < 0) goto FINISHED;
+
+  precond_data pcdata;
+  precond_data_null(&pcdata);
+  param_amg_to_prec(&pcdata,amgparam);
+  pcdata.max_levels = mgl[0].num_levels;
+  pcdata.mgl_data = mgl;
+
+  precond pc; pc.data = &pcdata;
+
+  switch (amgparam->cycle_type) {
+
+    case AMLI_CYCLE: // AMLI cycle
+      pc.fct = precond_amli;
+      break;
+
+    case NL_AMLI_CYCLE: // Nonlinear AMLI AMG
+      pc.fct = precond_nl_amli;
+      break;
+
+    case ADD_CYCLE: // additive cycle
+      pc.fct = precond_amg_add;
+      break;
+
+    default: // V,W-Cycle AMG
+      pc.fct = precond_amg;
+      break;
+
+  }
+
+  if ( prtlvl >= PRINT_MIN ) {
+    get_time(&setup_end);
+    print_cputime("LOBPCG AMG setup", setup_end-setup_start);
+  }
+
+  status = eig_lobpcg(A,B,nev,evalues,evectors,&pc,tol,MaxIt,prtlvl);
+
+FINISHED:
+  amg_data_free(mgl, amgparam);free(mgl);
+  return status;
+}
+/*---------------------------------*/
+/*--        End of File          --*/
+/*---------------------------------*/
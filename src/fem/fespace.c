@@ -926,6 +926,42 @@ void get_edgelocaldata(simplex_local_data* edge_data,mesh_struct* mesh,INT edge)
 }
 /******************************************************************************/
 
+/*!
+* \fn INT get_blocksize_fespace(block_fespace *FE,mesh_struct *mesh)
+*
+* \brief Natural block size of a system posed on FE: the number of unknowns
+*        per node when all unknowns live on the same scalar space (a vector
+*        P1 space, FEtype 60, counts as dim copies of P1), 1 otherwise.
+*        The dofs of such a system are numbered component-major.
+*
+* \param FE       Struct for BLOCK FE space
+* \param mesh     Mesh struct
+*
+* \return nb      Block size (use with linear_solver_dcsr_krylov_amg_bsr)
+*
+*/
+INT get_blocksize_fespace(block_fespace *FE,mesh_struct *mesh)
+{
+  INT i,type,ndof,ncomp,nb=0,type0=-1,ndof0=-1;
+  fespace *V;
+
+  for(i=0;i<FE->nspaces;i++) {
+    V = FE->var_spaces[i];
+    if(V->FEtype==60) {
+      type = 1; ndof = mesh->nv; ncomp = mesh->dim;
+    } else if(V->scal_or_vec==0) {
+      type = V->FEtype; ndof = V->ndof; ncomp = 1;
+    } else {
+      return 1;
+    }
+    if(i>0 && (type!=type0 || ndof!=ndof0)) return 1;
+    type0 = type; ndof0 = ndof; nb += ncomp;
+  }
+
+  return MAX(nb,1);
+}
+/******************************************************************************/
+
 /*!
 * \fn void free_blockfespace(block_fespace* FE)
 *
@@ -207,6 +207,8 @@ dCSRmat get_normalizedgraphLaplacian_from_L_wdeg_inv(dCSRmat *L,
  *
  * \return distance     pointer to the distance vector with ordering: (0,1),(0,2),... (0,n-1),(1,2),...(1,n),...(n-2,n-1)
  *
+ * \note O(n^2) work and memory; use knn_graph or radius_graph for large n.
+ *
  * \author Xiaozhe Hu
  * \date   01/05/2020
  */
@@ -0,0 +1,335 @@
+/*! \file src/graphs/coloring.c
+ *
+ *  Copyright 2020__HAZMATH__. All rights reserved.
+ *
+ *  \note Parallel (OpenMP) graph coloring (Jones-Plassmann) and maximal
+ *        independent sets (Luby) at distance 1 or 2, on the adjacency
+ *        given by n, ia, ja of a dCSRmat or iCSRmat (the diagonal is
+ *        ignored, the pattern should be symmetric).
+ *
+ *  \note Every vertex gets a pseudo-random weight that depends only on
+ *        the seed and the vertex number, and every round is split in a
+ *        selection and an update phase. The result depends on the seed
+ *        only and not on the number of threads. For a fixed seed the
+ *        MIS is the greedy MIS in the order of decreasing weights.
+ *
+ */
+
+#include "hazmath.h"
+
+/* weight of vertex i (splitmix64 of seed and i) */
+static inline unsigned long long graph_weight(const INT seed,
+                                              const INT i)
+{
+  unsigned long long z = (unsigned long long )seed*0x9E3779B97F4A7C15ULL
+    + (unsigned long long )i + 0x632BE59BD9B4E019ULL;
+  z = (z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+  z = (z^(z>>27))*0x94D049BB133111EBULL;
+  return z^(z>>31);
+}
+
+/* 1 if no vertex j within the given distance from i with
+   flag[j]==undec has a larger (weight,index) than i */
+static SHORT graph_local_max(const INT i,
+                             const INT *ia,
+                             const INT *ja,
+                             const SHORT distance,
+                             const unsigned long long *w,
+                             const INT *flag,
+                             const INT undec)
+{
+  INT jj,kk,j,k;
+  for(jj=ia[i];jj<ia[i+1];jj++){
+    j=ja[jj];
+    if(j==i) continue;
+    if(flag[j]==undec && (w[j]>w[i] || (w[j]==w[i] && j>i))) return 0;
+    if(distance<2) continue;
+    for(kk=ia[j];kk<ia[j+1];kk++){
+      k=ja[kk];
+      if(k==i || k==j) continue;
+      if(flag[k]==undec && (w[k]>w[i] || (w[k]==w[i] && k>i))) return 0;
+    }
+  }
+  return 1;
+}
+
+/* 1 if a vertex j within the given distance from i has flag[j]==value */
+static SHORT graph_nbr_has(const INT i,
+                           const INT *ia,
+                           const INT *ja,
+                           const SHORT distance,
+                           const INT *flag,
+                           const INT value)
+{
+  INT jj,kk,j,k;
+  for(jj=ia[i];jj<ia[i+1];jj++){
+    j=ja[jj];
+    if(j==i) continue;
+    if(flag[j]==value) return 1;
+    if(distance<2) continue;
+    for(kk=ia[j];kk<ia[j+1];kk++){
+      k=ja[kk];
+      if(k!=i && flag[k]==value) return 1;
+    }
+  }
+  return 0;
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn INT graph_color_jp(const INT n, const INT *ia, const INT *ja, const SHORT distance,
+ *                        const INT seed, INT *color)
+ *
+ * \brief Distance-1 or distance-2 coloring by the Jones-Plassmann algorithm
+ *
+ * \param n         number of vertices
+ * \param ia, ja    adjacency in CSR format (e.g. A->IA, A->JA)
+ * \param distance  1: adjacent vertices get different colors;
+ *                  2: vertices with a common neighbor also do
+ * \param seed      seed for the vertex weights
+ * \param color     on return the color of every vertex, 0..ncolors-1
+ *                  (n INTs)
+ *
+ * \return          number of colors
+ *
+ * \note In every round the uncolored vertices with the largest weight in
+ *       their uncolored neighborhood get the smallest color not used in
+ *       their neighborhood. A distance-2 coloring splits the rows of a
+ *       matrix in sets that can be relaxed (or assembled) in parallel.
+ *
+ */
+INT graph_color_jp(const INT n,
+                   const INT *ia,
+                   const INT *ja,
+                   const SHORT distance,
+                   const INT seed,
+                   INT *color)
+{
+  INT i,ii,jj,nu,nk,maxc=0,ncolors=0;
+  unsigned long long *w=(unsigned long long *)calloc(n,sizeof(unsigned long long));
+  INT *list=(INT *)calloc(n,sizeof(INT));
+  SHORT *sel=(SHORT *)calloc(n,sizeof(SHORT));
+
+  // bound for the number of colors: size of the largest neighborhood + 1
+  for(i=0;i<n;i++){
+    nk=ia[i+1]-ia[i];
+    if(distance>1)
+      for(jj=ia[i];jj<ia[i+1];jj++) nk+=ia[ja[jj]+1]-ia[ja[jj]];
+    maxc=MAX(maxc,nk);
+  }
+  maxc++;
+
+#if defined(_OPENMP)
+#pragma omp parallel for private(i)
+#endif
+  for(i=0;i<n;i++){
+    w[i]=graph_weight(seed,i);
+    color[i]=-1;
+    list[i]=i;
+  }
+
+  nu=n;
+  while(nu>0){
+    // select the local maxima among the uncolored vertices
+#if defined(_OPENMP)
+#pragma omp parallel for private(ii)
+#endif
+    for(ii=0;ii<nu;ii++)
+      sel[ii]=graph_local_max(list[ii],ia,ja,distance,w,color,-1);
+
+    // color them; their neighborhoods do not contain other selected vertices
+#if defined(_OPENMP)
+#pragma omp parallel private(i,ii,jj)
+#endif
+    {
+      INT kk,j,k,c;
+      INT *mark=(INT *)malloc(maxc*sizeof(INT));
+      for(c=0;c<maxc;c++) mark[c]=-1;
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+      for(ii=0;ii<nu;ii++){
+        if(!sel[ii]) continue;
+        i=list[ii];
+        for(jj=ia[i];jj<ia[i+1];jj++){
+          j=ja[jj];
+          if(j==i) continue;
+          if(color[j]>=0) mark[color[j]]=i;
+          if(distance<2) continue;
+          for(kk=ia[j];kk<ia[j+1];kk++){
+            k=ja[kk];
+            if(k!=i && color[k]>=0) mark[color[k]]=i;
+          }
+        }
+        for(c=0;mark[c]==i;c++);
+        color[i]=c;
+      }
+      free(mark);
+    }
+
+    // keep the uncolored vertices
+    for(nk=0,ii=0;ii<nu;ii++)
+      if(!sel[ii]) list[nk++]=list[ii];
+    nu=nk;
+  }
+
+  for(i=0;i<n;i++) ncolors=MAX(ncolors,color[i]+1);
+
+  free(w);
+  free(list);
+  free(sel);
+  return ncolors;
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn ivector *graph_mis_luby_weights(const INT n, const INT *ia, const INT *ja,
+ *                                    const SHORT distance, const unsigned long long *w)
+ *
+ * \brief Maximal independent set at distance 1 or 2 by Luby's algorithm
+ *        with given vertex weights
+ *
+ * \param n         number of vertices
+ * \param ia, ja    adjacency in CSR format (e.g. A->IA, A->JA)
+ * \param distance  1: no two vertices in the set are adjacent;
+ *                  2: no two vertices in the set have a common neighbor
+ * \param w         weight of every vertex (n values; ties are broken by
+ *                  the vertex number)
+ *
+ * \return          the vertices in the set in increasing order
+ *
+ * \note The result is the greedy MIS in the order of decreasing weights,
+ *       so the weights control how the set is spread over the graph.
+ *
+ */
+ivector *graph_mis_luby_weights(const INT n,
+                                const INT *ia,
+                                const INT *ja,
+                                const SHORT distance,
+                                const unsigned long long *w)
+{
+  INT i,ii,nu,nk;
+  INT *state=(INT *)calloc(n,sizeof(INT)); // 0: undecided, 1: in the set, -1: out
+  INT *list=(INT *)calloc(n,sizeof(INT));
+  SHORT *sel=(SHORT *)calloc(n,sizeof(SHORT));
+  ivector *mis=malloc(1*sizeof(ivector));
+
+  for(i=0;i<n;i++) list[i]=i;
+
+  nu=n;
+  while(nu>0){
+    // local maxima among the undecided vertices join the set
+#if defined(_OPENMP)
+#pragma omp parallel for private(ii)
+#endif
+    for(ii=0;ii<nu;ii++)
+      sel[ii]=graph_local_max(list[ii],ia,ja,distance,w,state,0);
+#if defined(_OPENMP)
+#pragma omp parallel for private(ii)
+#endif
+    for(ii=0;ii<nu;ii++)
+      if(sel[ii]) state[list[ii]]=1;
+    // their neighborhoods leave
+#if defined(_OPENMP)
+#pragma omp parallel for private(ii,i)
+#endif
+    for(ii=0;ii<nu;ii++){
+      i=list[ii];
+      if(!sel[ii] && graph_nbr_has(i,ia,ja,distance,state,1)) sel[ii]=-1;
+    }
+    for(ii=0;ii<nu;ii++)
+      if(sel[ii]<0) state[list[ii]]=-1;
+    for(nk=0,ii=0;ii<nu;ii++)
+      if(!sel[ii]) list[nk++]=list[ii];
+    nu=nk;
+  }
+
+  for(nk=0,i=0;i<n;i++) if(state[i]>0) nk++;
+  mis->row=nk;
+  mis->val=(INT *)calloc(MAX(nk,1),sizeof(INT));
+  for(nk=0,i=0;i<n;i++) if(state[i]>0) mis->val[nk++]=i;
+
+  free(state);
+  free(list);
+  free(sel);
+  return mis;
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn ivector *graph_mis_luby(const INT n, const INT *ia, const INT *ja, const SHORT distance,
+ *                            const INT seed)
+ *
+ * \brief Maximal independent set at distance 1 or 2 by Luby's algorithm
+ *
+ * \param n         number of vertices
+ * \param ia, ja    adjacency in CSR format (e.g. A->IA, A->JA)
+ * \param distance  1: no two vertices in the set are adjacent;
+ *                  2: no two vertices in the set have a common neighbor
+ * \param seed      seed for the vertex weights
+ *
+ * \return          the vertices in the set in increasing order (same
+ *                  output as sparse_MIS)
+ *
+ * \note A distance-2 MIS gives well separated seeds (e.g. for
+ *       aggregation or Schwarz blocks).
+ *
+ */
+ivector *graph_mis_luby(const INT n,
+                        const INT *ia,
+                        const INT *ja,
+                        const SHORT distance,
+                        const INT seed)
+{
+  INT i;
+  ivector *mis;
+  unsigned long long *w=(unsigned long long *)calloc(n,sizeof(unsigned long long));
+
+#if defined(_OPENMP)
+#pragma omp parallel for private(i)
+#endif
+  for(i=0;i<n;i++) w[i]=graph_weight(seed,i);
+
+  mis=graph_mis_luby_weights(n,ia,ja,distance,w);
+
+  free(w);
+  return mis;
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn iCSRmat *graph_color_classes(const INT n, const INT *color, const INT ncolors)
+ *
+ * \brief Vertices grouped by color
+ *
+ * \param n         number of vertices
+ * \param color     color of every vertex (from graph_color_jp)
+ * \param ncolors   number of colors
+ *
+ * \return          ncolors x n iCSRmat: row c lists the vertices of
+ *                  color c in increasing order (val = c)
+ *
+ */
+iCSRmat *graph_color_classes(const INT n,
+                             const INT *color,
+                             const INT ncolors)
+{
+  INT i,c;
+  iCSRmat *cls=malloc(sizeof(iCSRmat));
+  cls[0]=icsr_create(ncolors,n,n);
+  for(c=0;c<=ncolors;c++) cls->IA[c]=0;
+  for(i=0;i<n;i++) cls->IA[color[i]+1]++;
+  for(c=0;c<ncolors;c++) cls->IA[c+1]+=cls->IA[c];
+  for(i=0;i<n;i++){
+    c=color[i];
+    cls->JA[cls->IA[c]]=i;
+    cls->val[cls->IA[c]]=c;
+    cls->IA[c]++;
+  }
+  for(c=ncolors;c>0;c--) cls->IA[c]=cls->IA[c-1];
+  cls->IA[0]=0;
+  return cls;
+}
+/*---------------------------------*/
+/*--        End of File          --*/
+/*---------------------------------*/
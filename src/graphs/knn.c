@@ -0,0 +1,411 @@
+/*! \file src/graphs/knn.c
+ *
+ *  Copyright 2020__HAZMATH__. All rights reserved.
+ *
+ *  \note k-nearest-neighbor and radius graphs of point data (the rows of
+ *        a dDENSEmat, as in pairwise_distance) with a k-d tree. The
+ *        result is a sparse dCSRmat adjacency whose entries are the
+ *        distances; it can be passed on to
+ *        get_graphLaplacian_from_adjacency (after the weights are set).
+ *
+ *  \note The tree is balanced (split at the median of the coordinate
+ *        with the largest spread) and built one level at a time; the
+ *        queries run in parallel (OpenMP). Ties are broken by the index
+ *        of the point, so the graphs do not depend on the number of
+ *        threads.
+ *
+ */
+
+#include "hazmath.h"
+
+/* k-d tree: node t has children 2t+1, 2t+2; leaves have sdim[t]=-1 */
+typedef struct {
+  INT n;
+  INT d;
+  const REAL *x;
+  REAL *xt;   // coordinates in tree order
+  INT *idx;   // points in tree order
+  INT *nb;    // range of node t: idx[nb[t]..ne[t])
+  INT *ne;
+  INT *sdim;  // splitting coordinate
+  REAL *sval; // splitting value
+} kd_tree;
+
+/* a candidate neighbor */
+typedef struct {
+  REAL dist;
+  INT j;
+} kd_nbr;
+
+/* distance that is monotone in the norm (squared for the 2 norm) */
+static inline REAL kd_dist(const REAL *a,
+                           const REAL *b,
+                           const INT d,
+                           const INT norm_type)
+{
+  INT k;
+  REAL s=0.;
+  if(norm_type==TWONORM) for(k=0;k<d;k++) s+=(a[k]-b[k])*(a[k]-b[k]);
+  else for(k=0;k<d;k++) s+=fabs(a[k]-b[k]);
+  return s;
+}
+
+static inline REAL kd_plane(const REAL t,
+                            const INT norm_type)
+{
+  return (norm_type==TWONORM) ? t*t : fabs(t);
+}
+
+/* (dist,j) < (dist1,j1) */
+static inline SHORT kd_less(const REAL dist,
+                            const INT j,
+                            const REAL dist1,
+                            const INT j1)
+{
+  return (dist<dist1 || (dist==dist1 && j<j1));
+}
+
+/* reorder idx[b..e) so that idx[m] has the m-th coordinate c (with ties
+   by index) and the ones before (after) are not larger (smaller) */
+static void kd_select(INT *idx,
+                      INT b,
+                      INT e,
+                      const INT m,
+                      const REAL *x,
+                      const INT d,
+                      const INT c)
+{
+  INT i,j,t,p;
+  REAL xp;
+  while(e-b>1){
+    // median of three as pivot
+    INT i0=idx[b],i1=idx[(b+e)/2],i2=idx[e-1];
+    if(kd_less(x[i1*d+c],i1,x[i0*d+c],i0)) {t=i0;i0=i1;i1=t;}
+    if(kd_less(x[i2*d+c],i2,x[i1*d+c],i1)) {
+      i1=i2;
+      if(kd_less(x[i1*d+c],i1,x[i0*d+c],i0)) i1=i0;
+    }
+    p=i1; xp=x[p*d+c];
+    // three way partition: [b,i) < pivot, [i,j) == pivot, [j,e) > pivot
+    i=b; j=b;
+    for(t=b;t<e;t++){
+      INT v=idx[t];
+      if(kd_less(x[v*d+c],v,xp,p)){
+        idx[t]=idx[j]; idx[j]=idx[i]; idx[i]=v; i++; j++;
+      } else if(v==p){
+        idx[t]=idx[j]; idx[j]=v; j++;
+      }
+    }
+    if(m<i) e=i;
+    else if(m>=j) b=j;
+    else return;
+  }
+}
+
+static void kd_build(kd_tree *T,
+                     const INT n,
+                     const INT d,
+                     const REAL *x)
+{
+  INT i,t,l,nlev=0,nnodes,first;
+  T->n=n; T->d=d; T->x=x;
+  while(((n>>nlev)+((n&((1<<nlev)-1))?1:0))>KDTREE_LEAF) nlev++;
+  nnodes=(1<<(nlev+1))-1;
+  T->idx=(INT *)calloc(MAX(n,1),sizeof(INT));
+  T->nb=(INT *)calloc(nnodes,sizeof(INT));
+  T->ne=(INT *)calloc(nnodes,sizeof(INT));
+  T->sdim=(INT *)calloc(nnodes,sizeof(INT));
+  T->sval=(REAL *)calloc(nnodes,sizeof(REAL));
+  for(i=0;i<n;i++) T->idx[i]=i;
+  T->nb[0]=0; T->ne[0]=n;
+  for(t=0;t<nnodes;t++) T->sdim[t]=-1;
+
+  // one level at a time; the nodes of a level are independent
+  for(l=0,first=0;l<nlev;l++,first=2*first+1){
+#if defined(_OPENMP)
+#pragma omp parallel for private(t)
+#endif
+    for(t=first;t<2*first+1;t++){
+      INT b=T->nb[t],e=T->ne[t],m=(b+e)/2,k,c=0,jj;
+      REAL lo,hi,spread=-1.;
+      if(e-b<=KDTREE_LEAF) {
+        T->nb[2*t+1]=T->ne[2*t+1]=T->nb[2*t+2]=T->ne[2*t+2]=e;
+        continue;
+      }
+      for(k=0;k<d;k++){
+        lo=hi=x[T->idx[b]*d+k];
+        for(jj=b+1;jj<e;jj++){
+          lo=MIN(lo,x[T->idx[jj]*d+k]);
+          hi=MAX(hi,x[T->idx[jj]*d+k]);
+        }
+        if(hi-lo>spread) {spread=hi-lo; c=k;}
+      }
+      kd_select(T->idx,b,e,m,x,d,c);
+      T->sdim[t]=c;
+      T->sval[t]=x[T->idx[m]*d+c];
+      T->nb[2*t+1]=b; T->ne[2*t+1]=m;
+      T->nb[2*t+2]=m; T->ne[2*t+2]=e;
+    }
+  }
+  // leaves are scanned contiguously
+  T->xt=(REAL *)calloc(MAX(n*d,1),sizeof(REAL));
+#if defined(_OPENMP)
+#pragma omp parallel for private(i)
+#endif
+  for(i=0;i<n;i++) memcpy(T->xt+i*d,x+T->idx[i]*d,d*sizeof(REAL));
+}
+
+static void kd_free(kd_tree *T)
+{
+  free(T->xt);
+  free(T->idx);
+  free(T->nb);
+  free(T->ne);
+  free(T->sdim);
+  free(T->sval);
+}
+
+/* k nearest neighbors of point q (q itself excluded) in the sub-tree t;
+   h is a max heap (by (dist,j)) with *nh<=k entries */
+static void kd_knn(const kd_tree *T,
+                   const INT t,
+                   const INT q,
+                   const INT k,
+                   const INT norm_type,
+                   kd_nbr *h,
+                   INT *nh)
+{
+  INT ii,j,c,p,s;
+  REAL dist;
+  const REAL *xq=T->x+q*T->d;
+  if(T->sdim[t]<0){
+    for(ii=T->nb[t];ii<T->ne[t];ii++){
+      j=T->idx[ii];
+      if(j==q) continue;
+      dist=kd_dist(xq,T->xt+ii*T->d,T->d,norm_type);
+      if(*nh<k){
+        // sift up
+        for(p=(*nh)++;p>0 && kd_less(h[(p-1)/2].dist,h[(p-1)/2].j,dist,j);p=(p-1)/2)
+          h[p]=h[(p-1)/2];
+        h[p].dist=dist; h[p].j=j;
+      } else if(kd_less(dist,j,h[0].dist,h[0].j)){
+        // replace the root and sift down
+        for(p=0;(c=2*p+1)<k;p=c){
+          if(c+1<k && kd_less(h[c].dist,h[c].j,h[c+1].dist,h[c+1].j)) c++;
+          if(!kd_less(dist,j,h[c].dist,h[c].j)) break;
+          h[p]=h[c];
+        }
+        h[p].dist=dist; h[p].j=j;
+      }
+    }
+    return;
+  }
+  c=T->sdim[t];
+  s=(xq[c]<T->sval[t]) ? 1 : 2;
+  kd_knn(T,2*t+s,q,k,norm_type,h,nh);
+  if(*nh<k || kd_plane(xq[c]-T->sval[t],norm_type)<=h[0].dist)
+    kd_knn(T,2*t+3-s,q,k,norm_type,h,nh);
+}
+
+/* points within (monotone) distance r2 of q (q excluded); counts them if
+   list==NULL */
+static INT kd_radius(const kd_tree *T,
+                     const INT t,
+                     const INT q,
+                     const REAL r2,
+                     const INT norm_type,
+                     kd_nbr *list)
+{
+  INT ii,j,c,cnt=0;
+  REAL dist;
+  const REAL *xq=T->x+q*T->d;
+  if(T->sdim[t]<0){
+    for(ii=T->nb[t];ii<T->ne[t];ii++){
+      j=T->idx[ii];
+      if(j==q) continue;
+      dist=kd_dist(xq,T->xt+ii*T->d,T->d,norm_type);
+      if(dist<=r2){
+        if(list) {list[cnt].dist=dist; list[cnt].j=j;}
+        cnt++;
+      }
+    }
+    return cnt;
+  }
+  c=T->sdim[t];
+  if(xq[c]<T->sval[t] || kd_plane(xq[c]-T->sval[t],norm_type)<=r2)
+    cnt+=kd_radius(T,2*t+1,q,r2,norm_type,list);
+  if(xq[c]>=T->sval[t] || kd_plane(xq[c]-T->sval[t],norm_type)<=r2)
+    cnt+=kd_radius(T,2*t+2,q,r2,norm_type,list ? list+cnt : NULL);
+  return cnt;
+}
+
+static int kd_cmp_col(const void *a, const void *b)
+{
+  INT ja=((const kd_nbr *)a)->j, jb=((const kd_nbr *)b)->j;
+  return (ja<jb) ? -1 : (ja>jb);
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn dCSRmat knn_graph(dDENSEmat *X, const INT k, const INT norm_type, const SHORT symm)
+ *
+ * \brief k-nearest-neighbor graph of the nodes
+ *
+ * \param X             pointer to the coordinate matrix of the nodes (each row corresponds to one node)
+ * \param k             number of neighbors of every node
+ * \param norm_type     use what type of norm to compute the distance (TWONORM, otherwise 1 norm)
+ * \param symm          0: row i has the k nearest neighbors of node i;
+ *                      1: symmetric graph, i~j if j is among the k nearest
+ *                      neighbors of i or i among those of j
+ *
+ * \return A            adjacency (no diagonal, column indices sorted),
+ *                      A(i,j)=distance between node i and node j
+ *
+ * \note O(n k log(n)) work for low dimensional data instead of the n^2/2
+ *       distances of pairwise_distance.
+ *
+ */
+dCSRmat knn_graph(dDENSEmat *X,
+                  const INT k,
+                  const INT norm_type,
+                  const SHORT symm)
+{
+  const INT n=X->row, d=X->col, kk=MAX(MIN(k,n-1),0);
+  INT i;
+  kd_tree T;
+  dCSRmat D,Dt,A;
+
+  kd_build(&T,n,d,X->val);
+
+  // directed graph: k neighbors per row
+  D=dcsr_create(n,n,n*kk);
+  for(i=0;i<=n;i++) D.IA[i]=i*kk;
+#if defined(_OPENMP)
+#pragma omp parallel private(i)
+#endif
+  {
+    INT ii,nh,jj;
+    kd_nbr *h=(kd_nbr *)calloc(MAX(kk,1),sizeof(kd_nbr));
+    // queries in tree order: consecutive queries visit the same leaves
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for(ii=0;ii<n;ii++){
+      i=T.idx[ii];
+      nh=0;
+      if(kk>0) kd_knn(&T,0,i,kk,norm_type,h,&nh);
+      qsort(h,nh,sizeof(kd_nbr),kd_cmp_col);
+      for(jj=0;jj<nh;jj++){
+        D.JA[i*kk+jj]=h[jj].j;
+        D.val[i*kk+jj]=(norm_type==TWONORM) ? sqrt(h[jj].dist) : h[jj].dist;
+      }
+    }
+    free(h);
+  }
+  kd_free(&T);
+  if(!symm) return D;
+
+  // union with the transpose (rows of both are sorted)
+  dcsr_trans(&D,&Dt);
+  A.row=n; A.col=n;
+  A.IA=(INT *)calloc(n+1,sizeof(INT));
+  for(i=0;i<2;i++){
+    INT r;
+#if defined(_OPENMP)
+#pragma omp parallel for private(r)
+#endif
+    for(r=0;r<n;r++){
+      INT p=D.IA[r],q=Dt.IA[r],c=(i==0) ? 0 : A.IA[r];
+      while(p<D.IA[r+1] || q<Dt.IA[r+1]){
+        if(q>=Dt.IA[r+1] || (p<D.IA[r+1] && D.JA[p]<=Dt.JA[q])){
+          if(i){A.JA[c]=D.JA[p]; A.val[c]=D.val[p];}
+          if(q<Dt.IA[r+1] && D.JA[p]==Dt.JA[q]) q++;
+          p++;
+        } else {
+          if(i){A.JA[c]=Dt.JA[q]; A.val[c]=Dt.val[q];}
+          q++;
+        }
+        c++;
+      }
+      if(i==0) A.IA[r+1]=c;
+    }
+    if(i==0){
+      for(r=0;r<n;r++) A.IA[r+1]+=A.IA[r];
+      A.nnz=A.IA[n];
+      A.JA=(INT *)calloc(MAX(A.nnz,1),sizeof(INT));
+      A.val=(REAL *)calloc(MAX(A.nnz,1),sizeof(REAL));
+    }
+  }
+  dcsr_free(&D);
+  dcsr_free(&Dt);
+  return A;
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn dCSRmat radius_graph(dDENSEmat *X, const REAL r, const INT norm_type)
+ *
+ * \brief Graph connecting the nodes at distance at most r
+ *
+ * \param X             pointer to the coordinate matrix of the nodes (each row corresponds to one node)
+ * \param r             radius
+ * \param norm_type     use what type of norm to compute the distance (TWONORM, otherwise 1 norm)
+ *
+ * \return A            symmetric adjacency (no diagonal, column indices
+ *                      sorted), A(i,j)=distance between node i and node j
+ *
+ */
+dCSRmat radius_graph(dDENSEmat *X,
+                     const REAL r,
+                     const INT norm_type)
+{
+  const INT n=X->row, d=X->col;
+  const REAL r2=(norm_type==TWONORM) ? r*r : r;
+  INT i;
+  kd_tree T;
+  dCSRmat A;
+
+  kd_build(&T,n,d,X->val);
+
+  A.row=n; A.col=n;
+  A.IA=(INT *)calloc(n+1,sizeof(INT));
+#if defined(_OPENMP)
+#pragma omp parallel for private(i)
+#endif
+  for(i=0;i<n;i++) A.IA[T.idx[i]+1]=kd_radius(&T,0,T.idx[i],r2,norm_type,NULL);
+  for(i=0;i<n;i++) A.IA[i+1]+=A.IA[i];
+  A.nnz=A.IA[n];
+  A.JA=(INT *)calloc(MAX(A.nnz,1),sizeof(INT));
+  A.val=(REAL *)calloc(MAX(A.nnz,1),sizeof(REAL));
+
+#if defined(_OPENMP)
+#pragma omp parallel private(i)
+#endif
+  {
+    INT ii,jj,nl,nmax=0;
+    kd_nbr *list=NULL;
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for(ii=0;ii<n;ii++){
+      i=T.idx[ii];
+      nl=A.IA[i+1]-A.IA[i];
+      if(nl>nmax) {
+        nmax=nl;
+        list=(kd_nbr *)realloc(list,nmax*sizeof(kd_nbr));
+      }
+      kd_radius(&T,0,i,r2,norm_type,list);
+      qsort(list,nl,sizeof(kd_nbr),kd_cmp_col);
+      for(jj=0;jj<nl;jj++){
+        A.JA[A.IA[i]+jj]=list[jj].j;
+        A.val[A.IA[i]+jj]=(norm_type==TWONORM) ? sqrt(list[jj].dist) : list[jj].dist;
+      }
+    }
+    if(list) free(list);
+  }
+  kd_free(&T);
+  return A;
+}
+/*---------------------------------*/
+/*--        End of File          --*/
+/*---------------------------------*/
@@ -0,0 +1,258 @@
+/*! \file src/graphs/reorder.c
+ *
+ *  Copyright 2020__HAZMATH__. All rights reserved.
+ *
+ *  \note Parallel (OpenMP) level synchronous breadth first search and
+ *        Reverse Cuthill-McKee (RCM) ordering on the adjacency given by
+ *        n, ia, ja of a dCSRmat or iCSRmat (the pattern should be
+ *        symmetric).
+ *
+ *  \note Every level is expanded in three phases: the unvisited
+ *        neighbors of the frontier are gathered, every one of them is
+ *        kept only by the first frontier vertex (in BFS order) it is
+ *        adjacent to, and the kept vertices are appended. This gives
+ *        exactly the order of the serial BFS, independent of the number
+ *        of threads.
+ *
+ */
+
+#include "hazmath.h"
+
+/* BFS from the nr vertices in order[0..nr). Unvisited vertices have
+   lev[v]=0, visited ones get lev[v]=level+1 and pos[v]=position in
+   order. The vertices of level l are order[lptr[l]..lptr[l+1]). With
+   cm!=0 the children of each vertex are sorted by increasing degree
+   (Cuthill-McKee). work has ia[n]+3*n+2 INTs. Returns the number of
+   levels; the number of visited vertices is lptr[nlev]. */
+static INT bfs_levels(const INT *ia,
+                      const INT *ja,
+                      const INT nr,
+                      INT *order,
+                      INT *lev,
+                      INT *pos,
+                      INT *anc,
+                      INT *lptr,
+                      const SHORT cm,
+                      INT *work,
+                      const INT n)
+{
+  INT q,qb,qe,nf,l;
+  INT *cand=work, *off=work+ia[n], *nk=off+n+1, *st=nk+n;
+
+  for(q=0;q<nr;q++){
+    lev[order[q]]=1;
+    pos[order[q]]=q;
+    if(anc) anc[order[q]]=-1;
+  }
+  l=0; lptr[0]=0; lptr[1]=nr;
+  while(lptr[l+1]>lptr[l]){
+    qb=lptr[l]; qe=lptr[l+1]; nf=qe-qb;
+
+    // count the unvisited neighbors of the frontier
+#if defined(_OPENMP)
+#pragma omp parallel for private(q)
+#endif
+    for(q=qb;q<qe;q++){
+      INT jj,v=order[q],c=0;
+      for(jj=ia[v];jj<ia[v+1];jj++) if(!lev[ja[jj]]) c++;
+      off[q-qb+1]=c;
+    }
+    off[0]=0;
+    for(q=0;q<nf;q++) off[q+1]+=off[q];
+
+    // gather them; keep each one only in the segment of the first
+    // frontier vertex it is adjacent to
+#if defined(_OPENMP)
+#pragma omp parallel for private(q)
+#endif
+    for(q=qb;q<qe;q++){
+      INT jj,ii,kk,i,w,t,c,v=order[q],p=off[q-qb];
+      SHORT first;
+      for(jj=ia[v];jj<ia[v+1];jj++) if(!lev[ja[jj]]) cand[p++]=ja[jj];
+      for(c=off[q-qb],ii=off[q-qb];ii<p;ii++){
+        i=cand[ii];
+        first=1;
+        for(kk=ia[i];kk<ia[i+1];kk++){
+          w=ja[kk];
+          if(lev[w]==l+1 && pos[w]<q) {first=0; break;}
+        }
+        if(!first) continue;
+        // insertion by (degree, index) for Cuthill-McKee
+        for(kk=c;cm && kk>off[q-qb];kk--){
+          t=cand[kk-1];
+          if(ia[t+1]-ia[t]<ia[i+1]-ia[i] ||
+             (ia[t+1]-ia[t]==ia[i+1]-ia[i] && t<i)) break;
+          cand[kk]=t;
+        }
+        cand[kk]=i;
+        c++;
+      }
+      nk[q-qb]=c-off[q-qb];
+    }
+
+    // append the new level
+    st[0]=qe;
+    for(q=0;q<nf;q++) st[q+1]=st[q]+nk[q];
+    lptr[l+2]=st[nf];
+#if defined(_OPENMP)
+#pragma omp parallel for private(q)
+#endif
+    for(q=qb;q<qe;q++){
+      INT ii,i,p=st[q-qb];
+      for(ii=0;ii<nk[q-qb];ii++){
+        i=cand[off[q-qb]+ii];
+        order[p]=i;
+        lev[i]=l+2;
+        pos[i]=p;
+        if(anc) anc[i]=order[q];
+        p++;
+      }
+    }
+    l++;
+  }
+  return l;
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn iCSRmat *run_bfs_par(const INT n, const INT *ia, const INT *ja, ivector *roots,
+ *                          ivector *anc, const SHORT cm)
+ *
+ * \brief Parallel level synchronous breadth first search
+ *
+ * \param n         number of vertices
+ * \param ia, ja    adjacency in CSR format (e.g. A->IA, A->JA)
+ * \param roots     the roots of the search; if roots->row<=0 the root is
+ *                  vertex 0 (as in run_bfs)
+ * \param anc       on return anc->val[v] is the parent of v in the BFS
+ *                  tree (-1 for roots and unreached vertices)
+ * \param cm        0: the order of run_bfs; 1: the children of every
+ *                  vertex are sorted by increasing degree (Cuthill-McKee)
+ *
+ * \return          as run_bfs: row l lists the vertices of level l (in
+ *                  JA); val[v]=level of v + 1 (0 if v is not reached)
+ *
+ * \note With cm=0 the levels, the order and anc are those of run_bfs.
+ *
+ */
+iCSRmat *run_bfs_par(const INT n,
+                     const INT *ia,
+                     const INT *ja,
+                     ivector *roots,
+                     ivector *anc,
+                     const SHORT cm)
+{
+  INT i,nlev;
+  iCSRmat *blk=malloc(sizeof(iCSRmat));
+  INT *pos=(INT *)calloc(MAX(n,1),sizeof(INT));
+  INT *work=(INT *)calloc(ia[n]+3*n+2,sizeof(INT));
+
+  blk[0]=icsr_create(n,n,n);
+  blk->IA=(INT *)realloc(blk->IA,(n+2)*sizeof(INT));
+  anc->row=n;
+  anc->val=(INT *)calloc(MAX(n,1),sizeof(INT));
+  for(i=0;i<n;++i){
+    blk->val[i]=0;
+    anc->val[i]=-1;
+  }
+  if(roots->row<=0){
+    roots->row=1;
+    roots->val=(INT *)realloc(roots->val,roots->row*sizeof(INT));
+    roots->val[0]=0;
+  }
+  for(i=0;i<roots->row;++i) blk->JA[i]=roots->val[i];
+
+  nlev=bfs_levels(ia,ja,roots->row,blk->JA,blk->val,pos,anc->val,blk->IA,cm,work,n);
+
+  blk->row=nlev;
+  blk->IA=(INT *)realloc(blk->IA,(blk->row+1)*sizeof(INT));
+  free(pos);
+  free(work);
+  return blk;
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn ivector *graph_rcm(const INT n, const INT *ia, const INT *ja)
+ *
+ * \brief Reverse Cuthill-McKee ordering
+ *
+ * \param n         number of vertices
+ * \param ia, ja    adjacency in CSR format (e.g. A->IA, A->JA)
+ *
+ * \return          the permutation p: vertex p[i] becomes vertex i (the
+ *                  convention of dcsr_perm), so dcsr_perm(A,p->val) is
+ *                  the reordered matrix
+ *
+ * \note Every connected component starts at a pseudo-peripheral vertex
+ *       (George-Liu: repeated BFS from a vertex of minimum degree in the
+ *       last level while the number of levels grows). The BFS levels are
+ *       expanded in parallel (run_bfs_par); the result does not depend
+ *       on the number of threads.
+ *
+ */
+ivector *graph_rcm(const INT n,
+                   const INT *ia,
+                   const INT *ja)
+{
+  INT i,k,kk,r,x,nv,nc,nl,nl2,d,dmax=0;
+  INT *lev=(INT *)calloc(MAX(n,1),sizeof(INT));
+  INT *pos=(INT *)calloc(MAX(n,1),sizeof(INT));
+  INT *order=(INT *)calloc(MAX(n,1),sizeof(INT));
+  INT *lptr=(INT *)calloc(n+2,sizeof(INT));
+  INT *byd=(INT *)calloc(MAX(n,1),sizeof(INT));
+  INT *work=(INT *)calloc(ia[n]+3*n+2,sizeof(INT));
+  ivector *p=malloc(sizeof(ivector));
+
+  // vertices by increasing degree (counting sort); starting points
+  for(i=0;i<n;i++) dmax=MAX(dmax,ia[i+1]-ia[i]);
+  INT *cnt=(INT *)calloc(dmax+2,sizeof(INT));
+  for(i=0;i<n;i++) cnt[ia[i+1]-ia[i]+1]++;
+  for(d=0;d<=dmax;d++) cnt[d+1]+=cnt[d];
+  for(i=0;i<n;i++) byd[cnt[ia[i+1]-ia[i]]++]=i;
+  free(cnt);
+
+  nv=0;
+  for(kk=0;kk<n;kk++){
+    r=byd[kk];
+    if(lev[r]) continue;
+    // pseudo-peripheral vertex in the component of r
+    order[nv]=r;
+    nl=bfs_levels(ia,ja,1,order+nv,lev,pos,NULL,lptr,0,work,n);
+    while(1){
+      nc=lptr[nl];
+      x=order[nv+lptr[nl-1]];
+      for(k=nv+lptr[nl-1]+1;k<nv+nc;k++)
+        if(ia[order[k]+1]-ia[order[k]]<ia[x+1]-ia[x]) x=order[k];
+      for(k=nv;k<nv+nc;k++) lev[order[k]]=0;
+      if(x==r) break;
+      order[nv]=x;
+      nl2=bfs_levels(ia,ja,1,order+nv,lev,pos,NULL,lptr,0,work,n);
+      if(nl2<=nl){
+        for(k=nv;k<nv+nc;k++) lev[order[k]]=0;
+        break;
+      }
+      r=x; nl=nl2;
+    }
+    // Cuthill-McKee from r
+    order[nv]=r;
+    nl=bfs_levels(ia,ja,1,order+nv,lev,pos,NULL,lptr,1,work,n);
+    nv+=lptr[nl];
+  }
+
+  // reverse
+  p->row=n;
+  p->val=(INT *)calloc(MAX(n,1),sizeof(INT));
+  for(i=0;i<n;i++) p->val[i]=order[n-1-i];
+
+  free(lev);
+  free(pos);
+  free(order);
+  free(lptr);
+  free(byd);
+  free(work);
+  return p;
+}
+/*---------------------------------*/
+/*--        End of File          --*/
+/*---------------------------------*/
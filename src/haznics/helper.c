@@ -477,8 +477,6 @@ precond* create_precond_ra(dCSRmat *A,
     // get points and function values first
     INT numval = (1<<14)+1;  // initial number of points on the interval [x_min, x_max]
     REAL xmin_in = 0.e0, xmax_in = 1.e0;  // interval for x
-    REAL16 **zf = set_f_values(frac_inv, func_param[0], func_param[1], func_param[2], func_param[3], &numval, \
-                               xmin_in, xmax_in, 0);
 
     /* AAA algorithm for the rational approximation */
     // parameters used in the AAA algorithm
@@ -489,8 +487,9 @@ precond* create_precond_ra(dCSRmat *A,
     // output of the AAA algorithm.  It contains residues (Re + Im), poles (Re + Im), nodes, weights, function values
     REAL **rpnwf = malloc(7 * sizeof(REAL *));
 
-    // compute the rational approximation using AAA algorithms
-    REAL err_max=get_rpzwf(numval, zf[0], zf[1], rpnwf, &mmax_in, &k, AAA_tol, print_level);
+    // compute the rational approximation using AAA algorithms (once for every set of parameters)
+    REAL err_max=get_rpzwf_cached("frac_inv", frac_inv, func_param[0], func_param[1], func_param[2], func_param[3], \
+                                  numval, xmin_in, xmax_in, rpnwf, &mmax_in, &k, AAA_tol, print_level);
     if(rpnwf == NULL) {
       fprintf(stderr,"\nUnsuccessful AAA computation of rational approximation\n");
       fflush(stderr);
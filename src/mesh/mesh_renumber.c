@@ -0,0 +1,371 @@
+/*! \file src/mesh/mesh_renumber.c
+ *
+ *  Copyright 2015__HAZMATH__. All rights reserved.
+ *
+ * \brief Renumbering of the vertices and elements of a mesh for cache
+ *        locality during assembly and solve: Reverse Cuthill-McKee or a
+ *        space filling curve (Hilbert, Morton).
+ *
+ * \note The vertices are renumbered and the edges, faces and their maps
+ *       are rebuilt by build_mesh_all, so they follow the new vertex
+ *       order. Renumber the mesh before the FE spaces are created; then
+ *       el_dof of every space and the assembled matrices are consistent
+ *       with the new numbering. A matrix (and vectors) assembled before
+ *       can be brought to the same numbering with dcsr_perm (and
+ *       dvec_perm) when the DoF are the vertices (P1).
+ *
+ */
+
+#include "hazmath.h"
+
+/* free what build_mesh_all builds from el_v, cv and v_flag */
+static void mesh_free_built(mesh_struct *mesh)
+{
+  iCSRmat **maps[5]={&mesh->el_ed,&mesh->el_f,&mesh->ed_v,&mesh->f_v,&mesh->f_ed};
+  REAL **rarr[9]={&mesh->el_vol,&mesh->el_mid,&mesh->ed_len,&mesh->ed_tau,&mesh->ed_mid,
+                  &mesh->f_area,&mesh->f_norm,&mesh->f_mid,&mesh->dwork};
+  INT **iarr[2]={&mesh->ed_flag,&mesh->f_flag};
+  INT k;
+  for(k=0;k<5;k++){
+    if(*maps[k]){
+      icsr_free(*maps[k]);
+      free(*maps[k]);
+      *maps[k]=NULL;
+    }
+  }
+  for(k=0;k<9;k++){
+    if(*rarr[k]) free(*rarr[k]);
+    *rarr[k]=NULL;
+  }
+  for(k=0;k<2;k++){
+    if(*iarr[k]) free(*iarr[k]);
+    *iarr[k]=NULL;
+  }
+}
+
+/* vertex p[i] becomes vertex i and element ep[i] becomes element i;
+   the rest of the mesh is rebuilt */
+static void mesh_permute(mesh_struct *mesh,
+                         const INT *p,
+                         const INT *ep)
+{
+  INT i,j,k,dim=mesh->dim,nv=mesh->nv,nelm=mesh->nelm;
+  iCSRmat *el_v=mesh->el_v;
+  INT *pinv=(INT *)calloc(nv,sizeof(INT));
+  INT *iw=(INT *)calloc(MAX(nv,nelm)+1,sizeof(INT));
+  REAL *x=(REAL *)calloc(dim*nv,sizeof(REAL));
+
+  for(i=0;i<nv;i++) pinv[p[i]]=i;
+
+  // coordinates (x, y, z are stored one after the other)
+  for(k=0;k<dim;k++)
+    for(i=0;i<nv;i++) x[k*nv+i]=mesh->cv->x[k*nv+p[i]];
+  memcpy(mesh->cv->x,x,dim*nv*sizeof(REAL));
+  free(x);
+
+  // vertex flags
+  if(mesh->v_flag){
+    for(i=0;i<nv;i++) iw[i]=mesh->v_flag[p[i]];
+    memcpy(mesh->v_flag,iw,nv*sizeof(INT));
+  }
+  if(mesh->v_component){
+    for(i=0;i<nv;i++) iw[i]=mesh->v_component[p[i]];
+    memcpy(mesh->v_component,iw,nv*sizeof(INT));
+  }
+
+  // element to vertex map: rows in the new element order, new labels
+  iCSRmat el_v1=icsr_create(nelm,nv,el_v->nnz);
+  el_v1.IA[0]=0;
+  for(i=0;i<nelm;i++){
+    j=ep[i];
+    el_v1.IA[i+1]=el_v1.IA[i]+(el_v->IA[j+1]-el_v->IA[j]);
+    for(k=0;k<el_v->IA[j+1]-el_v->IA[j];k++){
+      el_v1.JA[el_v1.IA[i]+k]=pinv[el_v->JA[el_v->IA[j]+k]];
+      if(el_v->val && el_v1.val) el_v1.val[el_v1.IA[i]+k]=el_v->val[el_v->IA[j]+k];
+    }
+  }
+  if(!el_v->val && el_v1.val){
+    free(el_v1.val);
+    el_v1.val=NULL;
+  }
+  icsr_free(el_v);
+  *el_v=el_v1;
+  if(mesh->el_flag){
+    for(i=0;i<nelm;i++) iw[i]=mesh->el_flag[ep[i]];
+    memcpy(mesh->el_flag,iw,nelm*sizeof(INT));
+  }
+
+  free(iw);
+  free(pinv);
+
+  // edges, faces, volumes, ... in the new numbering
+  mesh_free_built(mesh);
+  build_mesh_all(mesh);
+}
+
+/******************************************************************************/
+/*!
+ * \fn void mesh_renumber_vertices(mesh_struct *mesh, const INT *p, INT *pel)
+ *
+ * \brief Renumbers the vertices of a mesh: vertex p[i] becomes vertex i
+ *        (the convention of dcsr_perm). The elements are sorted by their
+ *        smallest new vertex and the rest of the mesh is rebuilt.
+ *
+ * \param mesh     Mesh struct (built by build_mesh_all)
+ * \param p        Permutation of the vertices (mesh->nv INTs)
+ * \param pel      If not NULL, on return element pel[i] of the old mesh is
+ *                 element i of the new one (mesh->nelm INTs)
+ *
+ * \note Call before create_fespace: the FE spaces (and P1 el_dof, which
+ *       is mesh->el_v) refer to the numbering of the mesh.
+ *
+ */
+void mesh_renumber_vertices(mesh_struct *mesh,
+                            const INT *p,
+                            INT *pel)
+{
+  INT i,k,nv=mesh->nv,nelm=mesh->nelm;
+  iCSRmat *el_v=mesh->el_v;
+  INT *pinv=(INT *)calloc(nv,sizeof(INT));
+  INT *cnt=(INT *)calloc(nv+1,sizeof(INT));
+  INT *key=(INT *)calloc(nelm,sizeof(INT));
+  INT *ep=(INT *)calloc(nelm,sizeof(INT));
+
+  // elements sorted by the smallest new vertex (stable counting sort)
+  for(i=0;i<nv;i++) pinv[p[i]]=i;
+  for(i=0;i<nelm;i++){
+    key[i]=nv-1;
+    for(k=el_v->IA[i];k<el_v->IA[i+1];k++) key[i]=MIN(key[i],pinv[el_v->JA[k]]);
+    cnt[key[i]+1]++;
+  }
+  for(i=0;i<nv;i++) cnt[i+1]+=cnt[i];
+  for(i=0;i<nelm;i++) ep[cnt[key[i]]++]=i;
+
+  mesh_permute(mesh,p,ep);
+  if(pel) memcpy(pel,ep,nelm*sizeof(INT));
+
+  free(pinv);
+  free(cnt);
+  free(key);
+  free(ep);
+}
+
+/******************************************************************************/
+/*!
+ * \fn ivector *rcm_el_dof(iCSRmat *el_dof, const INT ndof)
+ *
+ * \brief Reverse Cuthill-McKee ordering of the DoF graph of an element to
+ *        DoF map (two DoF are adjacent if they share an element)
+ *
+ * \param el_dof   Element to DoF map (e.g. mesh->el_v or FE->el_dof)
+ * \param ndof     Number of DoF
+ *
+ * \return         Permutation p (dcsr_perm convention: DoF p[i] becomes i)
+ *
+ */
+ivector *rcm_el_dof(iCSRmat *el_dof,
+                    const INT ndof)
+{
+  iCSRmat dof_el,dof_dof;
+  ivector *p;
+  INT nc=el_dof->col;
+  el_dof->col=ndof;
+  icsr_trans(el_dof,&dof_el);
+  icsr_mxm_symb(&dof_el,el_dof,&dof_dof);
+  el_dof->col=nc;
+  p=graph_rcm(ndof,dof_dof.IA,dof_dof.JA);
+  icsr_free(&dof_el);
+  icsr_free(&dof_dof);
+  return p;
+}
+
+/******************************************************************************/
+/*!
+ * \fn void mesh_renumber_rcm(mesh_struct *mesh, INT *pel)
+ *
+ * \brief Renumbers the vertices of a mesh by Reverse Cuthill-McKee (and
+ *        the elements by their smallest vertex), see mesh_renumber_vertices
+ *
+ * \param mesh     Mesh struct (built by build_mesh_all)
+ * \param pel      If not NULL, the permutation of the elements on return
+ *
+ */
+void mesh_renumber_rcm(mesh_struct *mesh,
+                       INT *pel)
+{
+  ivector *p=rcm_el_dof(mesh->el_v,mesh->nv);
+  mesh_renumber_vertices(mesh,p->val,pel);
+  ivec_free(p);
+  free(p);
+}
+
+/* point on a space filling curve */
+struct sfc_pt {
+  unsigned long long key;
+  INT i;
+};
+
+static int sfc_cmp(const void *a, const void *b)
+{
+  const struct sfc_pt *pa=(const struct sfc_pt *)a, *pb=(const struct sfc_pt *)b;
+  if(pa->key!=pb->key) return (pa->key<pb->key) ? -1 : 1;
+  return (pa->i<pb->i) ? -1 : (pa->i>pb->i);
+}
+
+/* index on the curve of the integer point c (b bits per coordinate, c is
+   overwritten); Hilbert by the transpose of J. Skilling, AIP Conf. Proc.
+   707 (2004) 381 */
+static unsigned long long sfc_key(unsigned long long *c,
+                                  const INT dim,
+                                  const INT b,
+                                  const SHORT curve)
+{
+  unsigned long long key=0,q,t,m=1ULL<<(b-1);
+  INT i,k;
+  if(curve==SFC_HILBERT && dim>1){
+    for(q=m;q>1;q>>=1){
+      for(i=0;i<dim;i++){
+        if(c[i]&q) c[0]^=q-1;
+        else {t=(c[0]^c[i])&(q-1); c[0]^=t; c[i]^=t;}
+      }
+    }
+    for(i=1;i<dim;i++) c[i]^=c[i-1];
+    for(t=0,q=m;q>1;q>>=1) if(c[dim-1]&q) t^=q-1;
+    for(i=0;i<dim;i++) c[i]^=t;
+  }
+  // interleave the bits, most significant first
+  for(k=b-1;k>=0;k--)
+    for(i=0;i<dim;i++) key=(key<<1)|((c[i]>>k)&1ULL);
+  return key;
+}
+
+/* p[i]= point at position i along the curve through the n points x
+   (x[i*dim+k]) scaled from the box [lo,lo+h]^dim */
+static void sfc_sort(const INT n,
+                     const INT dim,
+                     const REAL *x,
+                     const REAL *lo,
+                     const REAL h,
+                     const SHORT curve,
+                     INT *p)
+{
+  INT i,b=MIN(31,63/dim);
+  REAL s=(h>0.) ? ((REAL )((1ULL<<b)-1))/h : 0.;
+  struct sfc_pt *pt=(struct sfc_pt *)calloc(MAX(n,1),sizeof(struct sfc_pt));
+#if defined(_OPENMP)
+#pragma omp parallel for private(i)
+#endif
+  for(i=0;i<n;i++){
+    INT k;
+    unsigned long long c[64];
+    for(k=0;k<dim;k++){
+      REAL t=(x[i*dim+k]-lo[k])*s;
+      c[k]=(t>0.) ? (unsigned long long )(t+0.5) : 0ULL;
+      if(c[k]>=(1ULL<<b)) c[k]=(1ULL<<b)-1;
+    }
+    pt[i].key=sfc_key(c,dim,b,curve);
+    pt[i].i=i;
+  }
+  qsort(pt,n,sizeof(struct sfc_pt),sfc_cmp);
+  for(i=0;i<n;i++) p[i]=pt[i].i;
+  free(pt);
+}
+
+/* bounding cube [lo,lo+h]^dim of the n points x (x[i*dim+k]) */
+static REAL sfc_box(const INT n,
+                    const INT dim,
+                    const REAL *x,
+                    REAL *lo)
+{
+  INT i,k;
+  REAL h=0.,hi;
+  for(k=0;k<dim;k++){
+    lo[k]=(n>0) ? x[k] : 0.;
+    hi=lo[k];
+    for(i=1;i<n;i++){
+      lo[k]=MIN(lo[k],x[i*dim+k]);
+      hi=MAX(hi,x[i*dim+k]);
+    }
+    h=MAX(h,hi-lo[k]);
+  }
+  return h;
+}
+
+/******************************************************************************/
+/*!
+ * \fn ivector *sfc_perm(const INT n, const INT dim, const REAL *x, const SHORT curve)
+ *
+ * \brief Order of points along a space filling curve
+ *
+ * \param n        Number of points
+ * \param dim      Dimension (n*dim coordinates)
+ * \param x        Coordinates, x[i*dim+k] (as sc->x or mesh->el_mid)
+ * \param curve    SFC_HILBERT or SFC_MORTON
+ *
+ * \return         Permutation p (dcsr_perm convention: point p[i] becomes i)
+ *
+ * \note The points are scaled to their bounding cube with 31 bits per
+ *       coordinate (63/dim for dim>2); points in the same cell keep their
+ *       relative order.
+ *
+ */
+ivector *sfc_perm(const INT n,
+                  const INT dim,
+                  const REAL *x,
+                  const SHORT curve)
+{
+  REAL *lo=(REAL *)calloc(dim,sizeof(REAL));
+  ivector *p=malloc(sizeof(ivector));
+  REAL h=sfc_box(n,dim,x,lo);
+  p->row=n;
+  p->val=(INT *)calloc(MAX(n,1),sizeof(INT));
+  sfc_sort(n,dim,x,lo,h,curve,p->val);
+  free(lo);
+  return p;
+}
+
+/******************************************************************************/
+/*!
+ * \fn void mesh_renumber_sfc(mesh_struct *mesh, const SHORT curve, INT *pel)
+ *
+ * \brief Renumbers the vertices (by their coordinates) and the elements
+ *        (by their barycenters) of a mesh along a space filling curve and
+ *        rebuilds the rest of the mesh
+ *
+ * \param mesh     Mesh struct (built by build_mesh_all)
+ * \param curve    SFC_HILBERT or SFC_MORTON
+ * \param pel      If not NULL, on return element pel[i] of the old mesh is
+ *                 element i of the new one (mesh->nelm INTs)
+ *
+ * \note Useful for meshes that come out in generation order (read from a
+ *       file or refined, where new vertices are appended). Call before
+ *       create_fespace, as mesh_renumber_vertices.
+ *
+ */
+void mesh_renumber_sfc(mesh_struct *mesh,
+                       const SHORT curve,
+                       INT *pel)
+{
+  INT i,k,dim=mesh->dim,nv=mesh->nv,nelm=mesh->nelm;
+  REAL *x=(REAL *)calloc(nv*dim,sizeof(REAL));
+  REAL *lo=(REAL *)calloc(dim,sizeof(REAL));
+  INT *p=(INT *)calloc(nv,sizeof(INT));
+  INT *ep=(INT *)calloc(nelm,sizeof(INT));
+  REAL h;
+
+  for(k=0;k<dim;k++)
+    for(i=0;i<nv;i++) x[i*dim+k]=mesh->cv->x[k*nv+i];
+  // same cube for vertices and barycenters
+  h=sfc_box(nv,dim,x,lo);
+  sfc_sort(nv,dim,x,lo,h,curve,p);
+  sfc_sort(nelm,dim,mesh->el_mid,lo,h,curve,ep);
+
+  mesh_permute(mesh,p,ep);
+  if(pel) memcpy(pel,ep,nelm*sizeof(INT));
+
+  free(x);
+  free(lo);
+  free(p);
+  free(ep);
+}
+/*EOF*/
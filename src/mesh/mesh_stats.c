@@ -83,26 +83,52 @@ iCSRmat convert_elmnode(INT *element_vertex,INT nelm,INT nv,INT nve)
  *
  * \return ed_v:	  Edge to vertex map in CSR format.
  *
+ * \note The edges are numbered by their smaller vertex; the edges with the
+ *       same smaller vertex i are numbered in the order in which the larger
+ *       vertex first appears in the elements around i.  This is the same
+ *       ordering as in the upper triangle of v_el*el_v, but the vertex to
+ *       vertex map is not formed: every vertex counts (and then numbers)
+ *       its edges independently, so both passes are done in parallel.
+ *
  */
 iCSRmat get_edge_v(INT* nedge,iCSRmat* el_v)
 {
   INT nv = el_v->col;
-  INT i,j,col_b,col_e,icntr,jcntr; /* Loop indices and counters */
+  INT i,j,k,jp,kp,ned,icntr; /* Loop indices and counters */
 
   /* Get Transpose of el_v -> v_el */
   iCSRmat v_el;
   icsr_trans(el_v,&v_el);
 
-  /* Create Vertex to Vertex Map by v_el*el_v */
-  iCSRmat v_v;
-  icsr_mxm_symb(&v_el,el_v,&v_v);
-  INT* iv_v = v_v.IA;
-  INT* jv_v = v_v.JA;
-
-  // Get the number of edges.
-  // This is the number of nonzeroes in the upper triangular
-  // part of vertex-vertex map (not including diagonal).
-  INT ned = (INT) (v_v.nnz - v_v.row)/2;
+  // Number of edges whose smaller vertex is i: ied[i+1]
+  INT* ied = (INT *) calloc(nv+1,sizeof(INT));
+#if defined(_OPENMP)
+#pragma omp parallel private(i,j,k,jp,kp,icntr)
+#endif
+  {
+    INT* ix = (INT *) malloc(nv*sizeof(INT));
+    for(i=0;i<nv;i++) ix[i] = -1;
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for(i=0;i<nv;i++) {
+      icntr = 0;
+      for(jp=v_el.IA[i];jp<v_el.IA[i+1];jp++) {
+        j = v_el.JA[jp];
+        for(kp=el_v->IA[j];kp<el_v->IA[j+1];kp++) {
+          k = el_v->JA[kp];
+          if(k>i && ix[k]!=i) {
+            ix[k] = i;
+            icntr++;
+          }
+        }
+      }
+      ied[i+1] = icntr;
+    }
+    free(ix);
+  }
+  for(i=0;i<nv;i++) ied[i+1] += ied[i];
+  ned = ied[nv];
   *nedge = ned;
 
   iCSRmat ed_v;
@@ -119,31 +145,38 @@ iCSRmat get_edge_v(INT* nedge,iCSRmat* el_v)
     ed_v.JA = NULL;
   }
 
-  // Now go through upper triangular (above diagonal) portion of node-node and
-  // count non-zeros.
-  // Each of these node-node connections are edges.  Upper so we don't count
-  // i->j and j->i as two separate edges, and no diagonal since i->i is not
-  // an edge.
-  jcntr = 0;
-  icntr = 0;
-  for(i=0;i<nv-1;i++) {
-    col_b = iv_v[i];
-    col_e = iv_v[i+1]-1;
-    for(j=col_b;j<=col_e;j++) {
-      if(jv_v[j]>i) {
-        ed_v.IA[icntr] = jcntr;
-        ed_v.JA[jcntr] = jv_v[j];
-        ed_v.JA[jcntr+1] = i;
-        jcntr=jcntr+2;
-        icntr++;
+  // Each edge is stored as (larger vertex, smaller vertex).
+#if defined(_OPENMP)
+#pragma omp parallel private(i,j,k,jp,kp,icntr)
+#endif
+  {
+    INT* ix = (INT *) malloc(nv*sizeof(INT));
+    for(i=0;i<nv;i++) ix[i] = -1;
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for(i=0;i<nv;i++) {
+      icntr = ied[i];
+      for(jp=v_el.IA[i];jp<v_el.IA[i+1];jp++) {
+        j = v_el.JA[jp];
+        for(kp=el_v->IA[j];kp<el_v->IA[j+1];kp++) {
+          k = el_v->JA[kp];
+          if(k>i && ix[k]!=i) {
+            ix[k] = i;
+            ed_v.IA[icntr] = 2*icntr;
+            ed_v.JA[2*icntr] = k;
+            ed_v.JA[2*icntr+1] = i;
+            icntr++;
+          }
+        }
       }
     }
+    free(ix);
   }
-  ed_v.IA[icntr] = jcntr;
+  if(ned>0) ed_v.IA[ned] = 2*ned;
 
-  /* Free Node Node */
-  icsr_free(&v_v);
   icsr_free(&v_el);
+  free(ied);
   ed_v.val=NULL;
   ed_v.row = ned;
   ed_v.col = nv;
@@ -212,6 +245,103 @@ void boundary_f_ed(iCSRmat* f_ed,iCSRmat* ed_v,INT nedge, INT nface,INT *f_flag,
 }
 /*******************************************************************************/
 
+/*******************************************************************************/
+/*!
+ * \fn static iCSRmat get_x_ed(iCSRmat* x_v,iCSRmat* ed_v)
+ *
+ * \brief Gets the map from elements or faces (rows of x_v) to the edges
+ *        connecting their vertices.
+ *
+ * \param x_v                        Element (or face) to vertex map
+ * \param ed_v	                   Edge to vertex map
+ *
+ * \return x_ed                      Element (or face) to edge map
+ *
+ * \note The edges of a row are ordered as in icsr_mxm_symb_max(x_v,v_ed,2):
+ *       for every vertex a of the row (in the order of x_v) the edges from
+ *       a to the vertices after a in the row, in increasing order.  The edges
+ *       are found in a vertex to edge map bucketed by the smaller vertex, so
+ *       only one linear pass over the edges and two parallel passes over the
+ *       rows are needed.
+ *
+ */
+static iCSRmat get_x_ed(iCSRmat* x_v,iCSRmat* ed_v)
+{
+  INT nv = ed_v->col, nedge = ed_v->row, nx = x_v->row;
+  INT i,j,k,p,q,a,b,lo,hi,cnt;
+  iCSRmat x_ed;
+
+  // Edges with smaller vertex i are v_ed[iv_ed[i]:iv_ed[i+1]-1].
+  INT* iv_ed = (INT *) calloc(nv+1,sizeof(INT));
+  INT* v_ed = (INT *) calloc(nedge,sizeof(INT));
+  for(i=0;i<nedge;i++) {
+    a = ed_v->JA[ed_v->IA[i]];
+    b = ed_v->JA[ed_v->IA[i]+1];
+    iv_ed[MIN(a,b)+1]++;
+  }
+  for(i=0;i<nv;i++) iv_ed[i+1] += iv_ed[i];
+  for(i=0;i<nedge;i++) {
+    a = ed_v->JA[ed_v->IA[i]];
+    b = ed_v->JA[ed_v->IA[i]+1];
+    lo = MIN(a,b);
+    v_ed[iv_ed[lo]] = i;
+    iv_ed[lo]++;
+  }
+  for(i=nv;i>0;i--) iv_ed[i] = iv_ed[i-1];
+  iv_ed[0] = 0;
+
+  x_ed.row = nx;
+  x_ed.col = nedge;
+  x_ed.val = NULL;
+  x_ed.IA = (INT *) calloc(nx+1,sizeof(INT));
+  x_ed.JA = NULL;
+  // two passes: count the edges of every row (fill=0) and store them (fill=1).
+  INT fill,k0;
+  for(fill=0;fill<2;fill++) {
+#if defined(_OPENMP)
+#pragma omp parallel for private(i,j,k,k0,p,q,a,b,lo,hi,cnt) schedule(static)
+#endif
+    for(i=0;i<nx;i++) {
+      cnt = (fill) ? x_ed.IA[i] : 0;
+      for(p=x_v->IA[i];p<x_v->IA[i+1];p++) {
+        a = x_v->JA[p];
+        k0 = cnt;
+        for(q=p+1;q<x_v->IA[i+1];q++) {
+          b = x_v->JA[q];
+          lo = MIN(a,b);
+          hi = MAX(a,b);
+          for(j=iv_ed[lo];j<iv_ed[lo+1];j++) {
+            k = ed_v->IA[v_ed[j]];
+            if(ed_v->JA[k]==hi || ed_v->JA[k+1]==hi) break;
+          }
+          if(j==iv_ed[lo+1]) continue;
+          if(fill) {
+            // keep the edges from a in increasing order
+            j = v_ed[j];
+            k = cnt-1;
+            while(k>=k0 && x_ed.JA[k]>j) {
+              x_ed.JA[k+1] = x_ed.JA[k];
+              k--;
+            }
+            x_ed.JA[k+1] = j;
+          }
+          cnt++;
+        }
+      }
+      if(!fill) x_ed.IA[i+1] = cnt;
+    }
+    if(!fill) {
+      for(i=0;i<nx;i++) x_ed.IA[i+1] += x_ed.IA[i];
+      x_ed.nnz = x_ed.IA[nx];
+      x_ed.JA = (INT *) calloc(x_ed.nnz,sizeof(INT));
+    }
+  }
+  free(iv_ed);
+  free(v_ed);
+  return x_ed;
+}
+/*******************************************************************************/
+
 /*******************************************************************************/
 /*!
  * \fn iCSRmat get_el_ed(iCSRmat* el_v,iCSRmat* ed_v)
@@ -226,18 +356,7 @@ void boundary_f_ed(iCSRmat* f_ed,iCSRmat* ed_v,INT nedge, INT nface,INT *f_flag,
  */
 iCSRmat get_el_ed(iCSRmat* el_v,iCSRmat* ed_v)
 {
-  iCSRmat el_ed;
-
-  // Get transpose of edge to vertex
-  iCSRmat v_ed;
-  icsr_trans(ed_v,&v_ed);
-  icsr_mxm_symb_max(el_v,&v_ed,&el_ed,2);
-  //zicsr_mxm_symb_max(el_v,&v_ed,&el_ed,2);
-  //fprintf(stdout,"\nXXXX: %d, %d %d\n",el_ed.nnz,el_ed.row,el_ed.col);
-  //print_full_mat_int(el_ed.nnz,1,el_ed.JA,"eled");
-  icsr_free(&v_ed);
-
-  return el_ed;
+  return get_x_ed(el_v,ed_v);
 }
 /*******************************************************************************/
 
@@ -362,6 +481,119 @@ void get_face_ordering(INT el_order,INT dim,INT f_order,INT *fel_order)
 }
 /*******************************************************************************/
 
+/*******************************************************************************/
+/*!
+ * \fn static INT face_cmp(const INT nvf,const INT *a,const INT *b)
+ *
+ * \brief Compares lexicographically two sorted vertex tuples of length nvf
+ *
+ * \return -1 if a<b, 1 if a>b and 0 if a=b
+ *
+ */
+static INT face_cmp(const INT nvf,const INT *a,const INT *b)
+{
+  INT k;
+  for(k=0;k<nvf;k++){
+    if(a[k]<b[k]) return -1;
+    if(a[k]>b[k]) return 1;
+  }
+  return 0;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/*!
+ * \fn void match_faces(const INT nf,const INT nvf,const INT nv,INT *fv,INT *fmate)
+ *
+ * \brief Finds which of the given faces coincide (have the same set of
+ *        vertices). Used to find element neighbors: the faces of all
+ *        elements are given and two elements are neighbors if they
+ *        have a common face.
+ *
+ *        The faces are bucketed (counting sort) by their smallest
+ *        vertex. Then the faces in every bucket are sorted
+ *        lexicographically by their sorted vertex tuples and the
+ *        equal neighbors in the sorted order are matched. The buckets
+ *        are independent and are processed in parallel when compiled
+ *        with OpenMP. This is O(nf*nvf) work plus sorting the buckets,
+ *        whose size is bounded by the vertex valence.
+ *
+ * \param nf                         Number of faces
+ * \param nvf                        Number of vertices per face
+ * \param nv                         Number of vertices (all vertex numbers are in [0,nv))
+ * \param fv(nf,nvf)                 Vertices of every face (any order)
+ *
+ * \return fmate                     fmate[i]=j if face i and face j have the same
+ *                                   vertices and -1 if face i is not matched
+ *
+ * \note If more than two faces have the same vertices (not a manifold) they
+ *       are matched in pairs in the order they are given.
+ *
+ */
+void match_faces(const INT nf,const INT nvf,const INT nv,INT *fv,INT *fmate)
+{
+  INT i,j,k,v,ib,ie;
+  INT *key=(INT *)calloc(nf*nvf,sizeof(INT));
+  INT *ia=(INT *)calloc(nv+1,sizeof(INT));
+  INT *perm=(INT *)calloc(nf,sizeof(INT));
+  /* sorted vertex tuples */
+#if defined(_OPENMP)
+#pragma omp parallel for private(i,j,k,v)
+#endif
+  for(i=0;i<nf;i++){
+    fmate[i]=-1;
+    for(j=0;j<nvf;j++){
+      v=fv[i*nvf+j];
+      k=j-1;
+      while((k>=0) && (v<key[i*nvf+k])){
+	key[i*nvf+k+1]=key[i*nvf+k];
+	k--;
+      }
+      key[i*nvf+k+1]=v;
+    }
+  }
+  /* bucket by the smallest vertex */
+  for(i=0;i<nf;i++) ia[key[i*nvf]+1]++;
+  for(v=0;v<nv;v++) ia[v+1]+=ia[v];
+  for(i=0;i<nf;i++){
+    v=key[i*nvf];
+    perm[ia[v]]=i;
+    ia[v]++;
+  }
+  for(v=nv;v>0;v--) ia[v]=ia[v-1];
+  ia[0]=0;
+  /* sort every bucket (the order of equal faces is kept) and match */
+#if defined(_OPENMP)
+#pragma omp parallel for private(v,ib,ie,i,j,k) schedule(dynamic,256)
+#endif
+  for(v=0;v<nv;v++){
+    ib=ia[v];
+    ie=ia[v+1];
+    for(j=ib+1;j<ie;j++){
+      i=perm[j];
+      k=j-1;
+      while((k>=ib) && (face_cmp(nvf,key+i*nvf,key+perm[k]*nvf)<0)){
+	perm[k+1]=perm[k];
+	k--;
+      }
+      perm[k+1]=i;
+    }
+    for(j=ib+1;j<ie;j++){
+      i=perm[j-1];
+      k=perm[j];
+      if(fmate[i]>=0) continue;
+      if(face_cmp(nvf,key+i*nvf,key+k*nvf)) continue;
+      fmate[i]=k;
+      fmate[k]=i;
+    }
+  }
+  free(key);
+  free(ia);
+  free(perm);
+  return;
+}
+/*******************************************************************************/
+
 /*******************************************************************************/
 /*!
  * \fn void get_face_maps(iCSRmat* el_v,INT el_order,iCSRmat* ed_v,INT nface,INT dim,INT f_order,iCSRmat *el_f,INT *f_bdry,INT *nbface,iCSRmat *f_v,iCSRmat *f_ed,INT *fel_order)
@@ -388,125 +620,84 @@ void get_face_ordering(INT el_order,INT dim,INT f_order,INT *fel_order)
  * \return nbf                       Number of boundary faces
  * \return f_v                       Face to vertex map
  *
+ * \note The faces shared by two elements are found with match_faces().
+ *
  */
 void get_face_maps(iCSRmat* el_v,INT el_order,iCSRmat* ed_v,INT nface,INT dim,INT f_order,iCSRmat *el_f,INT *f_bdry,INT *nbface,iCSRmat *f_v,iCSRmat *f_ed,INT *fel_order)
 {
   // Flag for errors
   SHORT status;
 
-  INT i,j,k,m,p,jk,col_b,icntr,jcntr,kcntr; /* Loop Indices */
-  INT ncol1,ncol2,ncol3,ncol4,ncol5,ncol6;  /* Node indices */
-  INT el1=-1,el2=-1,el3=-1,el=-1; /* Element indices */
-  INT iflag = 0;  /* Marks if we found a face */
+  INT i,j,k,jk,col_b,icntr,jcntr,kcntr; /* Loop Indices */
+  INT el=-1; /* Element indices */
+  INT nvtx = 0; /* 1+(largest vertex number) */
   INT nbf = 0; /* hold number of boundary faces */
-  INT nd[dim];
-  INT f_num=-1;  /* Current face number of element */
   INT nelm = el_v->row;
   INT edpf = 2*dim - 3;
 
+  if(dim!=2 && dim!=3) {
+    status = ERROR_DIM;
+    check_error(status, __FUNCTION__);
+  }
+
   // We will build face to element map first and then transpose it
   iCSRmat f_el = icsr_create (nface,nelm,nelm*f_order);
 
-  /* Get Transpose of el_v -> v_el */
-  iCSRmat v_el;
-  icsr_trans(el_v,&v_el);
+  // Vertices of all faces of all elements; face j of element i is
+  // row i*f_order+j.
+  INT *el_fv = (INT *) calloc(nelm*f_order*dim,sizeof(INT));
+  INT *fmate = (INT *) calloc(nelm*f_order,sizeof(INT));
+  for(i=0;i<nelm;i++) {
+    col_b = el_v->IA[i];
+    for(j=0;j<f_order;j++) {
+      for(k=0;k<dim;k++) {
+        jk = col_b+fel_order[j*dim+k];
+        el_fv[(i*f_order+j)*dim+k] = el_v->JA[jk];
+        if(el_v->JA[jk]>=nvtx) nvtx = el_v->JA[jk]+1;
+      }
+    }
+  }
+  match_faces(nelm*f_order,dim,nvtx,el_fv,fmate);
 
-  // Get interior faces first
   // Loop over All elements and each face on the element
   // Then populate face to element and face to vertex map
   // Also determines if a face is on the boundary.
   icntr=0;
   jcntr=0;
   kcntr=0;
-  iflag=0;
   for(i=0;i<nelm;i++) {
-    // Get first node of element
-    col_b = el_v->IA[i];
     // Now loop over all faces of element
     for(j=0;j<f_order;j++) {
-      // Get appropriate nodes on face
-      for(k=0;k<dim;k++) {
-        jk = col_b+fel_order[j*dim+k];
-        nd[k] = el_v->JA[jk];
+      jk = fmate[i*f_order+j];
+      if(jk>=0) {
+        el = jk/f_order;
+        // the face was numbered when visiting the element el
+        if(el<i) continue;
       }
-      // Next Loop over all elements that touch the first node
-      ncol1 = v_el.IA[nd[0]];
-      ncol2 = v_el.IA[nd[0]+1];
-      for(k=ncol1;k<ncol2;k++) {
-        el1 = v_el.JA[k];
-        // If not the same element we started in then check other nodes elements
-        if(el1!=i) {
-          ncol3 = v_el.IA[nd[1]];
-          ncol4 = v_el.IA[nd[1]+1];
-          for(m=ncol3;m<ncol4;m++) {
-            el2 = v_el.JA[m];
-            // Our two nodes share the element!  In 2D this is the face!
-            // In 3D, we check third guy
-            if(el2==el1) {
-              if(dim==2) {
-                // Mark the element that shares the face as well as the
-                // nodes that are shared
-                iflag = 1;
-                el = el1;
-              } else if(dim==3) {
-                ncol5 = v_el.IA[nd[2]];
-                ncol6 = v_el.IA[nd[2]+1];
-                for(p=ncol5;p<ncol6;p++) {
-                  el3 = v_el.JA[p];
-                  if(el3==el2) {
-                    // Mark the element that shares the face as well as
-                    // the nodes that are shared
-                    iflag = 1;
-                    el = el1;
-                  }
-                }
-              } else {
-                status = ERROR_DIM;
-                check_error(status, __FUNCTION__);
-              }
-            }
-          }
-        }
+      f_el.IA[icntr] = jcntr;
+      f_el.JA[jcntr] = i;
+      f_el.val[jcntr] = j;
+      f_v->IA[icntr] = kcntr;
+      for(k=0;k<dim;k++) {
+        f_v->JA[kcntr] = el_fv[(i*f_order+j)*dim+k];
+        kcntr++;
       }
-      if(iflag && el>i) {
-        f_el.IA[icntr] = jcntr;
-        f_el.JA[jcntr] = i;
-        f_el.val[jcntr] = j;
+      if(jk>=0) {
+        // Face number for other element
         f_el.JA[jcntr+1] = el;
-        // Find face number for other element
-        find_facenumber(el_v,el,nd,dim,&f_num);
-        f_el.val[jcntr+1] = f_num;
+        f_el.val[jcntr+1] = jk%f_order;
         f_bdry[icntr] = 0;
-        f_v->IA[icntr] = kcntr;
-        f_v->JA[kcntr] = nd[0];
-        f_v->JA[kcntr+1] = nd[1];
-        kcntr+=2;
-        if(dim==3) {
-          f_v->JA[kcntr] = nd[2];
-          kcntr++;
-        }
-        icntr++;
         jcntr+=2;
-      } else if(!iflag){  // this must be a boundary face!
+      } else {  // this must be a boundary face!
         nbf++;
-        f_el.IA[icntr] = jcntr;
-        f_el.JA[jcntr] = i;
-        f_el.val[jcntr] = j;
         f_bdry[icntr] = 1;
-        f_v->IA[icntr] = kcntr;
-        f_v->JA[kcntr] = nd[0];
-        f_v->JA[kcntr+1] = nd[1];
-        kcntr+=2;
-        if(dim==3) {
-          f_v->JA[kcntr] = nd[2];
-          kcntr++;
-        }
-        icntr++;
         jcntr++;
       }
-      iflag=0;
+      icntr++;
     }
   }
+  free(el_fv);
+  free(fmate);
 
   f_el.IA[icntr] = jcntr;
   f_v->IA[icntr] = kcntr;
@@ -522,21 +713,16 @@ void get_face_maps(iCSRmat* el_v,INT el_order,iCSRmat* ed_v,INT nface,INT dim,IN
   icsr_trans(&v_f,f_v);
 
   /* Get Face to Edge Map */
-  iCSRmat face_ed;
-  iCSRmat v_ed;
-  icsr_trans(ed_v,&v_ed);
-  icsr_mxm_symb_max(f_v,&v_ed,&face_ed,2);
+  iCSRmat face_ed = get_x_ed(f_v,ed_v);
   for(i=0;i<nface+1;i++)
     f_ed->IA[i] = face_ed.IA[i];
 
   for(i=0;i<nface*edpf;i++)
     f_ed->JA[i] = face_ed.JA[i];
   icsr_free(&face_ed);
-  icsr_free(&v_ed);
 
   *nbface = nbf;
 
-  icsr_free(&v_el);
   icsr_free(&f_el);
   icsr_free(&v_f);
 
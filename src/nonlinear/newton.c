@@ -56,6 +56,25 @@ void initialize_newton(newton *n_it,input_param *inparam,INT ndof,INT blksize)
   n_it->rhs=malloc(sizeof(struct dvector));     /* f - A(sol_prev) */
   n_it->res_norm=0.0;
   n_it->update_norm=0.0;
+  n_it->res_norm_prev=0.0;
+
+  // Forcing terms for the linear solves (inexact Newton)
+  n_it->forcing_type = inparam->nonlinear_itsolver_forcing;
+  n_it->eta = 0.5;  // first step
+  n_it->eta_max = 0.9;
+  n_it->eta_gamma = 0.9;
+  n_it->eta_alpha = 2.0;
+  n_it->linres_norm = 0.0;
+
+  // Preconditioner (set pc_setup, pc_free and pc_data to use solve_newton_linear)
+  n_it->pc=NULL;
+  n_it->pc_setup=NULL;
+  n_it->pc_free=NULL;
+  n_it->pc_data=NULL;
+  n_it->pc_max_age = MAX(inparam->nonlinear_itsolver_pc_lag,1);
+  n_it->pc_age = 0;
+  n_it->pc_iter0 = -1;
+  n_it->pc_degrade = 2.0;
 
   dvec_alloc(ndof,n_it->sol);
   dvec_alloc(ndof,n_it->rhs);
@@ -75,6 +94,8 @@ void initialize_newton(newton *n_it,input_param *inparam,INT ndof,INT blksize)
  */
 void free_newton(newton* n_it)
 {
+  free_newton_precond(n_it);
+
   if(n_it->Jac) {
     dcsr_free(n_it->Jac);
     free(n_it->Jac);
@@ -260,12 +281,15 @@ INT check_newton_convergence(newton *n_it)
  * \note This uses the little l2 norm, though it probably should be a dual space
  *       norm for the entire block system instead.  One should avoid this as a
  *       stopping tolerance check regardless.
+ *       The previous norm is kept in res_norm_prev (for the forcing terms), so
+ *       call it once per Newton step.
  */
 void get_residual_norm(newton *n_it)
 {
   INT res_length = n_it->rhs->row;
   INT i=0;
   REAL resnorm = 0.0;
+  n_it->res_norm_prev = n_it->res_norm;
   for(i=0;i<res_length;i++) {
     resnorm += n_it->rhs->val[i]*n_it->rhs->val[i];
   }
@@ -353,3 +377,277 @@ void get_blockupdate_norm(newton *n_it,block_fespace* FE,mesh_struct* mesh, qcoo
   return;
 }
 /******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn void get_newton_forcing(newton *n_it,linear_itsolver_param *itparam)
+ *
+ * \brief Computes the forcing term eta of an inexact Newton step (Eisenstat-Walker)
+ *        and sets the linear tolerance: ||Jacobian*update - rhs|| <= eta*||rhs||
+ *
+ * \param n_it     Newton struct (after get_residual_norm of the current step)
+ * \param itparam  Parameters of the linear solver (linear_tol, linear_stop_type)
+ *
+ * \note forcing_type = 0: the linear tolerance is not changed
+ *                      1: eta = | ||rhs_k|| - ||rhs_{k-1} - J_{k-1}*update_{k-1}|| | / ||rhs_{k-1}||
+ *                      2: eta = gamma*(||rhs_k||/||rhs_{k-1}||)^alpha
+ *       with the safeguards of Eisenstat and Walker (eta does not decrease too fast),
+ *       eta <= eta_max, and, if the residual is in the stopping test, no more
+ *       accuracy than 0.5*tol (no oversolving at the last step).
+ *       Early steps are solved loosely and the accuracy grows as Newton converges.
+ */
+void get_newton_forcing(newton *n_it,linear_itsolver_param *itparam)
+{
+  REAL eta = n_it->eta, safe;
+  REAL res = n_it->res_norm, res_prev = n_it->res_norm_prev;
+  REAL alpha;
+
+  if(n_it->forcing_type==0) return;
+
+  if(n_it->current_step>1 && res_prev>0.0) {
+    if(n_it->forcing_type==1) { // Choice 1
+      alpha = 0.5*(1.0+sqrt(5.0));
+      eta = fabs(res - n_it->linres_norm)/res_prev;
+      safe = pow(n_it->eta,alpha);
+    } else { // Choice 2
+      alpha = n_it->eta_alpha;
+      eta = n_it->eta_gamma*pow(res/res_prev,alpha);
+      safe = n_it->eta_gamma*pow(n_it->eta,alpha);
+    }
+    if(safe>0.1) eta = MAX(eta,safe);
+  }
+
+  // No need to solve beyond the nonlinear tolerance (scaled residual)
+  if((n_it->tol_type==2 || n_it->tol_type==3) && res>0.0)
+    eta = MAX(eta,0.5*n_it->tol*sqrt((REAL )n_it->rhs->row)/res);
+
+  eta = MIN(eta,n_it->eta_max);
+  n_it->eta = eta;
+
+  // initial guess update=0, so the relative residual is ||J*update-rhs||/||rhs||
+  itparam->linear_tol = eta;
+  itparam->linear_stop_type = STOP_REL_RES;
+
+  return;
+}
+/******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn void free_newton_precond(newton *n_it)
+ *
+ * \brief Frees the preconditioner kept in the Newton struct
+ *
+ * \param n_it     Newton struct
+ *
+ */
+void free_newton_precond(newton *n_it)
+{
+  if(n_it->pc) {
+    if(n_it->pc_free) n_it->pc_free(n_it->pc,n_it->pc_data);
+    else free(n_it->pc);
+    n_it->pc=NULL;
+  }
+  n_it->pc_age = 0;
+  n_it->pc_iter0 = -1;
+
+  return;
+}
+/******************************************************************************************************/
+
+/* Krylov solve of Jacobian*update = rhs with n_it->pc, from update=0.
+   With a forcing term the rhs is scaled to norm 1: the Krylov solvers
+   stop when ||r|| < 1e-3*tol, which for a loose tol and a small
+   nonlinear residual would skip the solve. */
+static INT newton_krylov(newton *n_it,linear_itsolver_param *itparam)
+{
+  INT iter;
+  REAL s = 1.0;
+
+  if(n_it->forcing_type) {
+    s = dvec_norm2(n_it->rhs);
+    s = (s>0.0) ? s : 1.0;
+    dvec_ax(1.0/s,n_it->rhs);
+  }
+
+  dvec_set(n_it->update->row,n_it->update,0.0);
+  if(n_it->isblock)
+    iter = solver_bdcsr_linear_itsolver(n_it->Jac_block,n_it->rhs,n_it->update,n_it->pc,itparam);
+  else
+    iter = solver_dcsr_linear_itsolver(n_it->Jac,n_it->rhs,n_it->update,n_it->pc,itparam);
+
+  if(s!=1.0) {
+    dvec_ax(s,n_it->rhs);
+    dvec_ax(s,n_it->update);
+  }
+
+  return iter;
+}
+
+/******************************************************************************************************/
+/*!
+ * \fn INT solve_newton_linear(newton *n_it,linear_itsolver_param *itparam)
+ *
+ * \brief Solves the Newton system Jacobian*update = rhs by a preconditioned Krylov
+ *        method, with the forcing term as tolerance and a preconditioner that is
+ *        kept over several Newton steps
+ *
+ * \param n_it     Newton struct (Jacobian and rhs assembled for the current step)
+ * \param itparam  Parameters of the linear solver
+ *
+ * \return         Iteration number if converges; ERROR otherwise.
+ *
+ * \note Call it between the assembly of the Jacobian and update_sol_newton,
+ *       instead of a linear_solver_* function. The preconditioner is built with
+ *       n_it->pc_setup(n_it,n_it->pc_data) (e.g. newton_precond_amg) and
+ *       rebuilt when
+ *         - it has been used for pc_max_age Newton steps,
+ *         - the linear iterations exceeded pc_degrade times those of its first
+ *           solve (at the next step), or
+ *         - the solve with it failed (the step is then solved again).
+ *       With pc_setup=NULL no preconditioner is used.
+ */
+INT solve_newton_linear(newton *n_it,linear_itsolver_param *itparam)
+{
+  INT iter;
+  SHORT reused;
+
+  // Tolerance from the forcing term
+  get_newton_forcing(n_it,itparam);
+
+  // Preconditioner
+  if(n_it->pc_setup) {
+    if(n_it->pc && n_it->pc_age>=n_it->pc_max_age) free_newton_precond(n_it);
+    if(!n_it->pc) {
+      n_it->pc = n_it->pc_setup(n_it,n_it->pc_data);
+      n_it->pc_age = 0;
+      n_it->pc_iter0 = -1;
+    }
+  }
+  reused = (n_it->pc && n_it->pc_age>0);
+
+  iter = newton_krylov(n_it,itparam);
+
+  // The old preconditioner failed: rebuild it and solve again
+  if(iter<0 && reused) {
+    free_newton_precond(n_it);
+    n_it->pc = n_it->pc_setup(n_it,n_it->pc_data);
+    iter = newton_krylov(n_it,itparam);
+  }
+
+  if(n_it->pc) {
+    n_it->pc_age++;
+    if(n_it->pc_iter0<0) {
+      n_it->pc_iter0 = iter;
+    } else if(iter<0 || iter>n_it->pc_degrade*MAX(n_it->pc_iter0,1)) {
+      n_it->pc_age = n_it->pc_max_age; // rebuild at the next step
+    }
+  }
+
+  // Linear residual for the forcing term (choice 1)
+  if(n_it->forcing_type==1) {
+    dvector r = dvec_create(n_it->rhs->row);
+    if(n_it->isblock) bdcsr_mxv(n_it->Jac_block,n_it->update->val,r.val);
+    else dcsr_mxv(n_it->Jac,n_it->update->val,r.val);
+    dvec_axpy(-1.0,n_it->rhs,&r);
+    n_it->linres_norm = dvec_norm2(&r);
+    dvec_free(&r);
+  }
+
+  return iter;
+}
+/******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn precond *newton_precond_amg(newton *n_it,void *amgparam)
+ *
+ * \brief AMG preconditioner of the (dCSRmat) Jacobian, for n_it->pc_setup
+ *
+ * \param n_it      Newton struct
+ * \param amgparam  Pointer to AMG_param (n_it->pc_data)
+ *
+ * \return          The preconditioner (free it with newton_precond_amg_free)
+ *
+ * \note Same setup as linear_solver_dcsr_krylov_amg.
+ */
+precond *newton_precond_amg(newton *n_it,void *amgparam)
+{
+  AMG_param *param = (AMG_param *)amgparam;
+  dCSRmat *A = n_it->Jac;
+  const INT nnz = A->nnz, m = A->row, n = A->col;
+  INT status = SUCCESS;
+
+  // initialize A, b, x for mgl[0]
+  AMG_data *mgl=amg_data_create(param->max_levels);
+  mgl[0].A=dcsr_create(m,n,nnz); dcsr_cp(A,&mgl[0].A);
+  mgl[0].b=dvec_create(n); mgl[0].x=dvec_create(n);
+
+  switch (param->AMG_type) {
+  case SA_AMG: // Smoothed Aggregation AMG setup
+    status = amg_setup_sa(mgl, param);
+    break;
+  default: // Unsmoothed Aggregation AMG
+    status = amg_setup_ua(mgl, param);
+    break;
+  }
+  if(status<0) {
+    amg_data_free(mgl, param); free(mgl);
+    return NULL;
+  }
+
+  precond_data *pcdata = (precond_data *)calloc(1,sizeof(precond_data));
+  precond_data_null(pcdata);
+  param_amg_to_prec(pcdata,param);
+  pcdata->max_levels = mgl[0].num_levels;
+  pcdata->mgl_data = mgl;
+
+  precond *pc = (precond *)calloc(1,sizeof(precond));
+  pc->data = pcdata;
+  switch (param->cycle_type) {
+  case AMLI_CYCLE: // AMLI cycle
+    pc->fct = precond_amli;
+    break;
+  case NL_AMLI_CYCLE: // Nonlinear AMLI AMG
+    pc->fct = precond_nl_amli;
+    break;
+  case ADD_CYCLE: // additive cycle
+    pc->fct = precond_amg_add;
+    break;
+  default: // V,W-Cycle AMG
+    pc->fct = precond_amg;
+    break;
+  }
+
+  return pc;
+}
+/******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn void newton_precond_amg_free(precond *pc,void *amgparam)
+ *
+ * \brief Frees a preconditioner from newton_precond_amg (for n_it->pc_free)
+ *
+ * \param pc        Preconditioner
+ * \param amgparam  Pointer to AMG_param used to build it (n_it->pc_data)
+ *
+ */
+void newton_precond_amg_free(precond *pc,void *amgparam)
+{
+  if(pc==NULL) return;
+  precond_data *pcdata = (precond_data *)pc->data;
+  if(pcdata) {
+    if(pcdata->mgl_data) {
+      amg_data_free(pcdata->mgl_data,(AMG_param *)amgparam);
+      free(pcdata->mgl_data);
+      pcdata->mgl_data = NULL;
+    }
+    precond_data_free(pcdata);
+    free(pcdata);
+  }
+  free(pc);
+
+  return;
+}
+/******************************************************************************************************/
@@ -9,7 +9,6 @@
  *
  *  \todo   Add safe guard for the overall computatinal complexity -- Xiaozhe Hu
  *  \todo   Add maximal weighted matching coarsning -- Xiaozhe Hu
- *  \todo   Add maximal independent set aggregation -- Xiaozhe Hu
  *
  */
 
@@ -21,6 +20,10 @@ static SHORT aggregation_hec(dCSRmat *A, ivector *vertices, AMG_param *param, dC
 static INT heavy_edg(const REAL *wei,const INT *numb, const INT n0,const INT n1);
 static SHORT aggregation_hem(dCSRmat *A, ivector *vertices, AMG_param *param, dCSRmat *Neigh, INT *num_aggregations, INT lvl);
 static SHORT aggregation_vmb(dCSRmat *A, ivector *vertices, AMG_param *param, dCSRmat *Neigh, INT *num_aggregations, INT lvl);
+static SHORT aggregation_mis(dCSRmat *A, ivector *vertices, AMG_param *param, dCSRmat *Neigh, INT *num_aggregations, INT lvl);
+static SHORT aggregation_aggressive(dCSRmat *A, ivector *vertices, AMG_param *param, INT *num_aggregations, INT lvl);
+static void smooth_aggregation_drop(dCSRmat *P, const REAL tol);
+static void amg_setup_sell(AMG_data *mgl, AMG_param *param);
 static void smooth_aggregation_p(dCSRmat *A, dCSRmat *tentp, dCSRmat *P, AMG_param *param, INT levelNum, dCSRmat *N);
 static SHORT amg_setup_unsmoothP_unsmoothR(AMG_data *, AMG_param *);
 static SHORT amg_setup_smoothP_smoothR(AMG_data *, AMG_param *);
@@ -56,6 +59,8 @@ SHORT amg_setup_ua (AMG_data *mgl,
 
     SHORT status = amg_setup_unsmoothP_unsmoothR(mgl, param);
 
+    if ( status == SUCCESS ) amg_setup_sell(mgl, param);
+
     return status;
 }
 
@@ -79,6 +84,8 @@ SHORT amg_setup_sa (AMG_data *mgl,
 
     SHORT status = amg_setup_smoothP_smoothR(mgl, param);
 
+    if ( status == SUCCESS ) amg_setup_sell(mgl, param);
+
     return status;
 }
 
@@ -226,6 +233,39 @@ SHORT metric_amg_setup_bdcsr(AMG_data_bdcsr  *mgl,
 /*---------------------------------*/
 /*--      Private Functions      --*/
 /*---------------------------------*/
+/***********************************************************************************************/
+/**
+ * \fn static void amg_setup_sell(AMG_data *mgl, AMG_param *param)
+ *
+ * \brief Build SELL-C-sigma copies of the level matrices for the residuals
+ *        in the cycle (if param->sell_chunk > 0)
+ *
+ * \param mgl    Pointer to AMG data: AMG_data
+ * \param param  Pointer to AMG parameters: AMG_param
+ *
+ * \note The coarsest level is skipped; it is handled by the coarse solver.
+ */
+static void amg_setup_sell(AMG_data *mgl,
+                           AMG_param *param)
+{
+    const INT nl = mgl[0].num_levels;
+    INT l;
+
+    if ( param->sell_chunk <= 0 ) return;
+
+    for ( l = 0; l < nl-1; ++l ) {
+        dsell_free(&mgl[l].As);
+        mgl[l].As = dcsr_2_dsell(&mgl[l].A, param->sell_chunk, SELL_SIGMA);
+        if ( param->print_level > PRINT_MIN ) {
+            printf("Level %lld: SELL-%lld-%lld storage %lld (nnz %lld)\n",
+                   (long long )l, (long long )mgl[l].As.C,
+                   (long long )mgl[l].As.sigma,
+                   (long long )mgl[l].As.cs[mgl[l].As.nchunks],
+                   (long long )mgl[l].As.nnz);
+        }
+    }
+}
+
 /***********************************************************************************************/
 /**
  * \fn static void form_tentative_p (ivector *vertices, dCSRmat *tentp,
@@ -378,7 +418,7 @@ static void construct_strongly_coupled(dCSRmat *A,
 {
 
   // local variables
-  const INT  row = A->row, col = A->col, nnz = A->IA[row]-A->IA[0];
+  const INT  row = A->row, col = A->col;
   const INT  *AIA = A->IA, *AJA = A->JA;
   const REAL *Aval = A->val;
 
@@ -397,42 +437,53 @@ static void construct_strongly_coupled(dCSRmat *A,
   dvector diag;
   dcsr_getdiag(0, A, &diag);
 
-  // allocate Neigh
-  dcsr_alloc(row, col, nnz, Neigh);
+  // an entry (i,j) is kept if it is on the diagonal or it is a strong negative coupling
+#define STRONG_COUPLED(i,j)  ( (AJA[j] == (i))                           \
+     || ( ((Aval[j]*Aval[j]) >= strongly_coupled2*ABS(diag.val[(i)]*diag.val[AJA[j]])) \
+          && (Aval[j] < 0e0) ) )
+
+  // first pass: count the strongly coupled neighbors in every row
+  INT *cnt = (INT *)calloc(row+1, sizeof(INT));
+#if defined(_OPENMP)
+#pragma omp parallel for private(i,j,index,row_start,row_end) schedule(static)
+#endif
+  for ( i = 0; i < row; ++i ) {
+    index = 0;
+    row_start = AIA[i]; row_end = AIA[i+1];
+    for ( j = row_start; j < row_end; ++j ) {
+      if ( STRONG_COUPLED(i,j) ) index++;
+    }
+    cnt[i+1] = index;
+  }
+  for ( i = 0; i < row; ++i ) cnt[i+1] += cnt[i];
+
+  // allocate Neigh (exactly)
+  dcsr_alloc(row, col, cnt[row], Neigh);
 
   NIA  = Neigh->IA; NJA  = Neigh->JA;
   Nval = Neigh->val;
+  memcpy(NIA, cnt, (row+1)*sizeof(INT));
+  free(cnt);
 
-  // set IA for Neigh
-  for ( i = row; i >= 0; i-- ) NIA[i] = AIA[i];
-
-  // main loop of finding strongly coupled neighbors
-  for ( index = i = 0; i < row; ++i ) {
-    NIA[i] = index;
+  // second pass: fill the strongly coupled neighbors
+#if defined(_OPENMP)
+#pragma omp parallel for private(i,j,index,row_start,row_end) schedule(static)
+#endif
+  for ( i = 0; i < row; ++i ) {
+    index = NIA[i];
     row_start = AIA[i]; row_end = AIA[i+1];
-    //fprintf(stdout,"\nHere coupled index %lld \n", (long long )index);
     for ( j = row_start; j < row_end; ++j ) {
-      //fprintf(stdout,"\nHere coupled row start %lld end %lld \n", (long long )row_start, (long long )row_end);
-      if ( (AJA[j] == i)
-	   || ( ((Aval[j]*Aval[j]) >= strongly_coupled2*ABS(diag.val[i]*diag.val[AJA[j]])) && (Aval[j] < 0e0) )
-	   )
-	{
-	  //fprintf(stdout,"\nHere coupled \n");
-	  NJA[index] = AJA[j];
-	  Nval[index] = Aval[j];
-	  index++;
-	  //fprintf(stdout,"\nHere coupled \n");
-	}
-
+      if ( STRONG_COUPLED(i,j) ) {
+	NJA[index] = AJA[j];
+	Nval[index] = Aval[j];
+	index++;
+      }
     } // end for ( j = row_start; j < row_end; ++j )
-  } // end for ( index = i = 0; i < row; ++i )
+  } // end for ( i = 0; i < row; ++i )
+#undef STRONG_COUPLED
 
   dvec_free(&diag); // free it here;
-  NIA[row] = index;
-
-  Neigh->nnz = index;
-  Neigh->JA  = (INT*) realloc(Neigh->JA,  (Neigh->IA[row])*sizeof(INT));
-  Neigh->val = (REAL*)realloc(Neigh->val, (Neigh->IA[row])*sizeof(REAL));
+  Neigh->nnz = NIA[row];
   //
   if(0){
     //begin finding connected components (ltz):
@@ -451,6 +502,55 @@ static void construct_strongly_coupled(dCSRmat *A,
   } //end if(0);
 }
 
+/***********************************************************************************************/
+/**
+ * \fn static void smooth_aggregation_drop(dCSRmat *P, const REAL tol)
+ *
+ * \brief Drop entries of the smoothed prolongation P with |p_ij| < tol*max_j|p_ij|
+ *
+ * \param P         Pointer to the prolongation operator (compressed in place)
+ * \param tol       Relative drop tolerance
+ *
+ * \note The dropped entries of each row are lumped into its largest entry, so
+ *       row sums of P (and thus P applied to the near kernel) are preserved.
+ *
+ */
+static void smooth_aggregation_drop(dCSRmat *P,
+                                    const REAL tol)
+{
+    const INT row = P->row;
+    INT  i, j, jmax, nz = 0, begin;
+    REAL pmax, dropped;
+
+    for ( begin = 0, i = 0; i < row; ++i ) {
+
+        // find the largest entry in row i
+        for ( pmax = 0.0, jmax = begin, j = begin; j < P->IA[i+1]; ++j ) {
+            if ( ABS(P->val[j]) > pmax ) { pmax = ABS(P->val[j]); jmax = j; }
+        }
+
+        // lump small entries into the largest one
+        for ( dropped = 0.0, j = begin; j < P->IA[i+1]; ++j ) {
+            if ( j != jmax && ABS(P->val[j]) < tol*pmax ) dropped += P->val[j];
+        }
+
+        // compress the row
+        for ( j = begin; j < P->IA[i+1]; ++j ) {
+            if ( j != jmax && ABS(P->val[j]) < tol*pmax ) continue;
+            P->JA[nz]  = P->JA[j];
+            P->val[nz] = (j == jmax) ? P->val[j] + dropped : P->val[j];
+            nz++;
+        }
+
+        begin = P->IA[i+1];
+        P->IA[i+1] = nz;
+    }
+
+    P->nnz = nz;
+    P->JA  = (INT *)realloc(P->JA, MAX(nz,1)*sizeof(INT));
+    P->val = (REAL *)realloc(P->val, MAX(nz,1)*sizeof(REAL));
+}
+
 /***********************************************************************************************/
 /**
  * \fn static void smooth_aggregation_p(dCSRmat *A, dCSRmat *tentp, dCSRmat *P,
@@ -569,6 +669,17 @@ static void smooth_aggregation_p(dCSRmat *A,
     P->nnz = P->IA[P->row];
     dcsr_free(&S);
 
+    /* Step 3. Drop small entries of P to bound the fill of P and RAP */
+    if ( param->smooth_drop_tol > 0.0 ) {
+        const INT nnz0 = P->nnz;
+        smooth_aggregation_drop(P, param->smooth_drop_tol);
+        if ( param->print_level > PRINT_MIN ) {
+            printf("Level %lld: nnz(P) = %lld -> %lld (tentative %lld)\n",
+                   (long long )levelNum, (long long )nnz0, (long long )P->nnz,
+                   (long long )tentp->nnz);
+        }
+    }
+
 }
 
 /***********************************************************************************************/
@@ -726,6 +837,261 @@ END:
     return status;
 }
 
+/***********************************************************************************************/
+/**
+ * \fn static SHORT aggregation_mis (dCSRmat *A, ivector *vertices, AMG_param *param,
+ *                                   dCSRmat *Neigh, INT *num_aggregations,INT lvl)
+ *
+ * \brief Parallel aggregation based on a distance-2 maximal independent set (MIS-2)
+ *        of the graph of strongly coupled neighbors
+ *
+ * \param A                 Pointer to the coefficient matrices
+ * \param vertices          Pointer to the aggregation of vertices
+ * \param param             Pointer to AMG parameters
+ * \param Neigh             Pointer to strongly coupled neighbors
+ * \param num_aggregations  Pointer to number of aggregations
+ * \param lvl               Level number
+ *
+ * \note The roots of the aggregates are a MIS-2 of the graph of strongly coupled
+ *       neighbors (graph_mis_luby_weights; isolated vertices are not roots).  The
+ *       weights are a 32-bit multiplicative hash of the vertex number, which spreads
+ *       the roots more evenly than random weights (fewer Krylov iterations).  Then the
+ *       remaining vertices join, in rounds, the aggregate of their most strongly
+ *       coupled aggregated neighbor which has less than param->max_aggregation
+ *       vertices.  The choices of a round are
+ *       made vertex by vertex with data from the previous round only (in parallel
+ *       with OpenMP) and are accepted in the order of the vertices while the
+ *       aggregate is not full; the result is deterministic.  Vertices left out
+ *       start new aggregates with their free neighbors, as in aggregation_vmb.
+ *
+ * \note Refer to N. Bell, S. Dalton and L. Olson "Exposing fine-grained
+ *       parallelism in algebraic multigrid methods", 2012
+ *
+ */
+static SHORT aggregation_mis(dCSRmat *A,
+                             ivector *vertices,
+                             AMG_param *param,
+                             dCSRmat *Neigh,
+                             INT *num_aggregations, INT lvl)
+{
+    // local variables
+    const INT    row = A->row;
+    const INT    max_aggregation = param->max_aggregation;
+
+    // return status
+    SHORT  status = SUCCESS;
+
+    INT  i, j, k, jj, count, num_changed;
+    INT  *num_each_agg = NULL;
+    INT  *NIA = NULL, *NJA = NULL;
+    REAL *Nval = NULL;
+    REAL maxval;
+    unsigned long long h;
+    ivector *roots = NULL;
+    unsigned long long *w = (unsigned long long *)calloc(row, sizeof(unsigned long long));
+    INT *agg = (INT *)calloc(row, sizeof(INT));
+
+    // find strongly coupled neighbors
+    construct_strongly_coupled(A, param, Neigh);
+
+    NIA  = Neigh->IA; NJA  = Neigh->JA;
+    Nval = Neigh->val;
+
+    /*------------------------------------------*/
+    /*             Initialization               */
+    /*------------------------------------------*/
+    ivec_alloc(row, vertices);
+    iarray_set(row, vertices->val, -2);
+    *num_aggregations = 0;
+
+#if defined(_OPENMP)
+#pragma omp parallel for private(i,h)
+#endif
+    for ( i = 0; i < row; i++ ) {
+        if ( (NIA[i+1] - NIA[i]) == 1 ) vertices->val[i] = UNPT;
+        // a bijective hash of i (mod 2^32)
+        h = ((unsigned long long )i*2654435761u) & 0xFFFFFFFFULL;
+        h ^= h >> 16; h = (h*2246822519u) & 0xFFFFFFFFULL; h ^= h >> 13;
+        w[i] = h;
+    }
+
+    /*------------------------------------------*/
+    /*   Step 1. MIS-2 (roots of aggregates)    */
+    /*------------------------------------------*/
+    roots = graph_mis_luby_weights(row, NIA, NJA, 2, w);
+
+    // number the aggregates in the order of their roots
+    for ( k = 0; k < roots->row; k++ ) {
+        i = roots->val[k];
+        if ( vertices->val[i] == UNPT ) continue;
+        vertices->val[i] = *num_aggregations;
+        (*num_aggregations)++;
+    }
+
+    if ( *num_aggregations < MIN_CDOF ) {
+        status = ERROR_AMG_COARSEING; goto END;
+    }
+
+    /*------------------------------------------*/
+    /*   Step 2. grow the aggregates in rounds  */
+    /*------------------------------------------*/
+    num_each_agg = (INT *)calloc(*num_aggregations, sizeof(INT));
+    iarray_set(*num_aggregations, num_each_agg, 1);
+
+    num_changed = 1;
+    while ( num_changed > 0 ) {
+        num_changed = 0;
+        // agg[i]: aggregate of the most strongly coupled aggregated neighbor
+        // which is not full
+#if defined(_OPENMP)
+#pragma omp parallel for private(i,j,k,jj,maxval)
+#endif
+        for ( i = 0; i < row; i++ ) {
+            agg[i] = -1;
+            if ( vertices->val[i] != -2 ) continue;
+            k = -1; maxval = -1.0;
+            for ( jj = NIA[i]; jj < NIA[i+1]; jj++ ) {
+                j = NJA[jj];
+                if ( j == i || vertices->val[j] < 0 ) continue;
+                if ( num_each_agg[vertices->val[j]] >= max_aggregation ) continue;
+                if ( ABS(Nval[jj]) > maxval ) {
+                    k = j;
+                    maxval = ABS(Nval[jj]);
+                }
+            }
+            if ( k >= 0 ) agg[i] = vertices->val[k];
+        }
+        // join while the aggregate is not full
+        for ( i = 0; i < row; i++ ) {
+            k = agg[i];
+            if ( k < 0 || num_each_agg[k] >= max_aggregation ) continue;
+            vertices->val[i] = k;
+            num_each_agg[k]++;
+            num_changed++;
+        }
+    }
+
+    // the vertices left out (all aggregated neighbors are full, or not reached
+    // if Neigh is not symmetric) form new aggregates with their free neighbors
+    for ( i = 0; i < row; i++ ) {
+        if ( vertices->val[i] != -2 ) continue;
+        vertices->val[i] = *num_aggregations;
+        count = 1;
+        for ( jj = NIA[i]; jj < NIA[i+1] && count < max_aggregation; jj++ ) {
+            j = NJA[jj];
+            if ( vertices->val[j] == -2 ) {
+                vertices->val[j] = *num_aggregations;
+                count++;
+            }
+        }
+        (*num_aggregations)++;
+    }
+
+END:
+    ivec_free(roots); free(roots);
+    free(w);
+    free(agg);
+    free(num_each_agg);
+
+    return status;
+}
+
+/***********************************************************************************************/
+/**
+ * \fn static SHORT aggregation_aggressive (dCSRmat *A, ivector *vertices, AMG_param *param,
+ *                                          INT *num_aggregations,INT lvl)
+ *
+ * \brief Aggressive coarsening: aggregates the aggregates of A once more
+ *
+ * \param A                 Pointer to the coefficient matrices
+ * \param vertices          Pointer to the aggregation of vertices (input from any aggregation,
+ *                          output the aggregation by aggregates of aggregates)
+ * \param param             Pointer to AMG parameters
+ * \param num_aggregations  Pointer to number of aggregations (input and output)
+ * \param lvl               Level number
+ *
+ * \note The graph of the aggregates is the graph of P^T*A*P with the boolean (piecewise
+ *       constant) P given by vertices; it is aggregated with the same aggregation type.
+ *       If this fails (too few aggregates) the input aggregation is kept.  Aggregates which
+ *       are isolated in the graph of the aggregates stay as they are.
+ *
+ */
+static SHORT aggregation_aggressive(dCSRmat *A,
+                                    ivector *vertices,
+                                    AMG_param *param,
+                                    INT *num_aggregations, INT lvl)
+{
+    // local variables
+    const INT    row = A->row;
+
+    // return status
+    SHORT  status = SUCCESS;
+
+    INT  i, num_aggs2 = 0;
+    dCSRmat P, R, Ac, Neigh2;
+    ivector vertices2;
+
+    REAL *one = (REAL *)calloc(row, sizeof(REAL));
+    array_set(row, one, 1.0);
+
+    // graph of the aggregates
+    form_tentative_p(vertices, &P, &one, lvl+1, *num_aggregations);
+    dcsr_trans(&P, &R);
+    dcsr_rap_agg(&R, A, &P, &Ac);
+
+    vertices2.row = 0; vertices2.val = NULL;
+    Neigh2.IA = NULL; Neigh2.JA = NULL; Neigh2.val = NULL;
+
+    switch ( param->aggregation_type ) {
+
+        case VMB: // VMB aggregation
+            status = aggregation_vmb(&Ac, &vertices2, param, &Neigh2, &num_aggs2, lvl);
+            break;
+
+        case MIS: // MIS-2 (parallel) aggregation
+            status = aggregation_mis(&Ac, &vertices2, param, &Neigh2, &num_aggs2, lvl);
+            break;
+
+        case HEC: // Heavy edge coarsening aggregation
+            status = aggregation_hec(&Ac, &vertices2, param, &Neigh2, &num_aggs2, lvl);
+            break;
+
+        case HEM: // Heavy edge matching
+            status = aggregation_hem(&Ac, &vertices2, param, &Neigh2, &num_aggs2, lvl);
+            break;
+
+        default: // wrong aggregation type
+            status = ERROR_AMG_AGG_TYPE;
+            check_error(status, __FUNCTION__);
+            break;
+    }
+
+    if ( status == SUCCESS ) {
+        // isolated aggregates are aggregates on their own
+        for ( i = 0; i < Ac.row; i++ ) {
+            if ( vertices2.val[i] < 0 ) vertices2.val[i] = num_aggs2++;
+        }
+        // aggregates of aggregates
+        for ( i = 0; i < row; i++ ) {
+            if ( vertices->val[i] > UNPT ) vertices->val[i] = vertices2.val[vertices->val[i]];
+        }
+        *num_aggregations = num_aggs2;
+    }
+    else if ( param->print_level > PRINT_MIN ) {
+        printf("### HAZMATH WARNING: Aggressive coarsening on level-%lld failed! Use standard one.\n",
+               (long long )lvl);
+    }
+
+    free(one);
+    dcsr_free(&P);
+    dcsr_free(&R);
+    dcsr_free(&Ac);
+    dcsr_free(&Neigh2);
+    ivec_free(&vertices2);
+
+    return SUCCESS;
+}
+
 /***********************************************************************************************/
 /**
  * \fn static SHORT aggregation_hec (dCSRmat *A, ivector *vertices, AMG_param *param,
@@ -1305,6 +1671,11 @@ static SHORT amg_setup_unsmoothP_unsmoothR(AMG_data *mgl,
                                          &Neighbor[lvl], &num_aggs[lvl], lvl);
                 break;
 
+            case MIS: // MIS-2 (parallel) aggregation
+                status = aggregation_mis(&mgl[lvl].A, &vertices[lvl], param,
+                                         &Neighbor[lvl], &num_aggs[lvl], lvl);
+                break;
+
             case HEC: // Heavy edge coarsening aggregation
                 status = aggregation_hec(&mgl[lvl].A, &vertices[lvl], param,
                                          &Neighbor[lvl], &num_aggs[lvl], lvl);
@@ -1321,6 +1692,12 @@ static SHORT amg_setup_unsmoothP_unsmoothR(AMG_data *mgl,
                 break;
         }
 
+        /*-- Aggressive coarsening on the first levels: aggregates of aggregates --*/
+        if ( (status == SUCCESS) && (lvl < param->aggressive_levels) ) {
+            status = aggregation_aggressive(&mgl[lvl].A, &vertices[lvl], param,
+                                            &num_aggs[lvl], lvl);
+        }
+
         /*-- Choose strength threshold adaptively --*/
         if ( num_aggs[lvl]*4 > mgl[lvl].A.row )
             param->strong_coupled /= 2;
@@ -1401,6 +1778,10 @@ static SHORT amg_setup_unsmoothP_unsmoothR(AMG_data *mgl,
             break;
         }
 	  //#endif
+        case SOLVER_AUTO:
+            // dense LU, sparse direct or (Numeric = NULL) iterative by size
+            mgl[lvl].Numeric = amg_coarse_setup(&mgl[lvl].A, prtlvl);
+            break;
         default:
             // Do nothing!
             break;
@@ -1544,6 +1925,11 @@ static SHORT amg_setup_smoothP_smoothR(AMG_data *mgl,
                                          &Neighbor[lvl], &num_aggs[lvl],lvl);
                 break;
 
+            case MIS: // MIS-2 (parallel) aggregation
+                status = aggregation_mis(&mgl[lvl].A, &vertices[lvl], param,
+                                         &Neighbor[lvl], &num_aggs[lvl], lvl);
+                break;
+
             case HEC: // Heavy edge coarsening aggregation
                 status = aggregation_hec(&mgl[lvl].A, &vertices[lvl], param,
                                          &Neighbor[lvl], &num_aggs[lvl],lvl);
@@ -1643,6 +2029,10 @@ static SHORT amg_setup_smoothP_smoothR(AMG_data *mgl,
       break;
     }
 	    //#endif
+    case SOLVER_AUTO:
+      // dense LU, sparse direct or (Numeric = NULL) iterative by size
+      mgl[lvl].Numeric = amg_coarse_setup(&mgl[lvl].A, prtlvl);
+      break;
         default:
             // Do nothing!
             break;
@@ -1783,6 +2173,11 @@ static SHORT famg_setup_unsmoothP_unsmoothR(AMG_data *mgl,
                                          &Neighbor[lvl], &num_aggs[lvl],lvl);
                 break;
 
+            case MIS: // MIS-2 (parallel) aggregation
+                status = aggregation_mis(&mgl[lvl].A, &vertices[lvl], param,
+                                         &Neighbor[lvl], &num_aggs[lvl], lvl);
+                break;
+
             case HEC: // Heavy edge coarsening aggregation
                 status = aggregation_hec(&mgl[lvl].A, &vertices[lvl], param,
                                          &Neighbor[lvl], &num_aggs[lvl],lvl);
@@ -2018,6 +2413,11 @@ static SHORT famg_setup_smoothP_smoothR(AMG_data *mgl,
                                          &Neighbor[lvl], &num_aggs[lvl],lvl);
                 break;
 
+            case MIS: // MIS-2 (parallel) aggregation
+                status = aggregation_mis(&mgl[lvl].A, &vertices[lvl], param,
+                                         &Neighbor[lvl], &num_aggs[lvl], lvl);
+                break;
+
             case HEC: // Heavy edge coarsening aggregation
                 status = aggregation_hec(&mgl[lvl].A, &vertices[lvl], param,
                                          &Neighbor[lvl], &num_aggs[lvl],lvl);
@@ -2256,6 +2656,11 @@ static SHORT amg_setup_unsmoothP_unsmoothR_bsr(AMG_data_bsr   *mgl,
                                          &Neighbor[lvl], &num_aggs[lvl], lvl);
                 break;
 
+            case MIS: // MIS-2 (parallel) aggregation
+                status = aggregation_mis(&mgl[lvl].PP, &vertices[lvl], param,
+                                         &Neighbor[lvl], &num_aggs[lvl], lvl);
+                break;
+
             case HEC: // Heavy edge coarsening aggregation
 
                 status = aggregation_hec(&mgl[lvl].PP, &vertices[lvl], param,
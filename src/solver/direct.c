@@ -11,6 +11,7 @@
  */
 
 #include "hazmath.h"
+#include "../utilities/lock.inl"
 
 #if WITH_SUITESPARSE
 #include "umfpack.h"
@@ -365,7 +366,7 @@ INT block_solve_HAZ(block_dCSRmat *bA,
 void* hazmath_factorize (dCSRmat *ptrA,
                          const SHORT prtlvl)
 {
-  void *Numeric;
+  void *Numeric=NULL;
   clock_t start_time = clock();
 #if WITH_SUITESPARSE
   const INT n = ptrA->col;
@@ -382,6 +383,7 @@ void* hazmath_factorize (dCSRmat *ptrA,
   status = umfpack_di_numeric (Ap, Ai, Ax, Symbolic, &Numeric, NULL, NULL);
   if(status<0) {
     fprintf(stderr,"UMFPACK ERROR in Numeric, status = %lld\n\n",(long long )status);
+    Numeric=NULL;
   }
   umfpack_di_free_symbolic (&Symbolic);
   if ( prtlvl > PRINT_MIN ) {
@@ -500,6 +502,342 @@ INT hazmath_free_numeric (void **Numeric)
   return (INT )status; 
 }
 
+/*---------------------------------*/
+/*--  Coarsest level direct solver --*/
+/*---------------------------------*/
+
+/**
+ * \struct coarse_factor
+ * \brief Factorization of the coarsest level matrix used by SOLVER_AUTO.
+ *
+ * \note Factorizations are kept in a small cache, so that an AMG setup
+ *       with an unchanged coarsest matrix reuses the previous one. The
+ *       cache holds its own reference to each entry: the least recently
+ *       used one is dropped when the cache is full, and all of them by
+ *       amg_coarse_cache_free. A factorization is freed when neither the
+ *       cache nor an AMG hierarchy (amg_data_free -> amg_coarse_free)
+ *       holds it any more.
+ */
+typedef struct {
+  SHORT type;          // dense LU (1) or sparse direct (2)
+  INT refs;            // number of owners (AMG hierarchies + cache)
+  unsigned long long used; // time of the last setup with it (for LRU)
+  unsigned long long key; // fingerprint of A
+  dCSRmat A;           // copy of the coarsest matrix (to detect changes)
+  REAL *lu;            // dense LU factors (row-wise, scaled pivoting)
+  INT  *perm;          // pivoting permutation for dense LU
+  REAL *work;          // work array for the dense solve
+  dCSRmat At;          // matrix given to the sparse direct solver
+  void *Numeric;       // sparse direct factorization
+} coarse_factor;
+
+static coarse_factor *coarse_cache[COARSE_CACHE_SIZE];
+static unsigned long long coarse_cache_clock=0;
+static haz_lock_t coarse_lock = HAZ_LOCK_INITIALIZER;
+
+/*******************************************************************/
+/**
+ * \fn static unsigned long long coarse_key(dCSRmat *A)
+ * \brief FNV-1a fingerprint of the pattern and values of A
+ */
+static unsigned long long coarse_key(dCSRmat *A)
+{
+  unsigned long long h=14695981039346656037ULL;
+  const unsigned char *c;
+  size_t k,len;
+  const void *arr[3]={A->IA,A->JA,A->val};
+  const size_t sz[3]={(A->row+1)*sizeof(INT),A->nnz*sizeof(INT),A->nnz*sizeof(REAL)};
+  INT i;
+  for(i=0;i<3;i++){
+    c=(const unsigned char *)arr[i]; len=sz[i];
+    for(k=0;k<len;k++){ h^=c[k]; h*=1099511628211ULL; }
+  }
+  return h^((unsigned long long )A->row<<32)^(unsigned long long )A->nnz;
+}
+
+/*******************************************************************/
+/**
+ * \fn static SHORT coarse_same(dCSRmat *A, dCSRmat *B)
+ * \brief Returns 1 if A and B are identical (pattern and values)
+ */
+static SHORT coarse_same(dCSRmat *A,dCSRmat *B)
+{
+  if(A->row!=B->row || A->col!=B->col || A->nnz!=B->nnz) return 0;
+  if(memcmp(A->IA,B->IA,(A->row+1)*sizeof(INT))) return 0;
+  if(memcmp(A->JA,B->JA,A->nnz*sizeof(INT))) return 0;
+  if(memcmp(A->val,B->val,A->nnz*sizeof(REAL))) return 0;
+  return 1;
+}
+
+/*******************************************************************/
+/**
+ * \fn static SHORT coarse_is_symmetric(dCSRmat *A)
+ * \brief Returns 1 if A is (numerically) symmetric
+ */
+static SHORT coarse_is_symmetric(dCSRmat *A)
+{
+  const INT n=A->row;
+  INT i,j,jk;
+  SHORT flag=1;
+  dCSRmat AT;
+  REAL *w;
+  if(A->row!=A->col) return 0;
+  dcsr_trans(A,&AT);
+  w=(REAL *)calloc(n,sizeof(REAL));
+  for(i=0;(i<n)&&flag;i++){
+    if((AT.IA[i+1]-AT.IA[i])!=(A->IA[i+1]-A->IA[i])) {flag=0;break;}
+    for(jk=A->IA[i];jk<A->IA[i+1];jk++) w[A->JA[jk]]+=A->val[jk];
+    for(jk=AT.IA[i];jk<AT.IA[i+1];jk++) w[AT.JA[jk]]-=AT.val[jk];
+    for(jk=A->IA[i];jk<A->IA[i+1];jk++){
+      j=A->JA[jk];
+      if(ABS(w[j])>1e-14*(ABS(A->val[jk])+1.)) flag=0;
+      w[j]=0.;
+    }
+    for(jk=AT.IA[i];jk<AT.IA[i+1];jk++) w[AT.JA[jk]]=0.;
+  }
+  free(w);
+  dcsr_free(&AT);
+  return flag;
+}
+
+/*******************************************************************/
+/**
+ * \fn static void coarse_factor_free(coarse_factor *cf)
+ * \brief Free cf (no owner is left)
+ */
+static void coarse_factor_free(coarse_factor *cf)
+{
+  if(cf==NULL) return;
+  dcsr_free(&cf->A);
+  if(cf->lu) free(cf->lu);
+  if(cf->perm) free(cf->perm);
+  if(cf->work) free(cf->work);
+  if(cf->Numeric) hazmath_free_numeric(&cf->Numeric);
+  dcsr_free(&cf->At);
+  free(cf);
+}
+
+/*******************************************************************/
+/**
+ * \fn static void coarse_factor_release(coarse_factor *cf)
+ * \brief Drop one reference to cf and free it when no owner is left
+ */
+static void coarse_factor_release(coarse_factor *cf)
+{
+  INT refs;
+  if(cf==NULL) return;
+  haz_lock(&coarse_lock);
+  refs=--cf->refs;
+  haz_unlock(&coarse_lock);
+  if(refs==0) coarse_factor_free(cf);
+}
+
+/*******************************************************************/
+/**
+ * \fn void* amg_coarse_setup (dCSRmat *A, const SHORT prtlvl)
+ *
+ * \brief Set up the coarsest level solver for SOLVER_AUTO: dense LU if
+ *        A is small (or nearly full), sparse direct (UMFPACK or HAZMATH)
+ *        if it is of moderate size, otherwise iterative.
+ *
+ * \param A        Pointer to the coarsest level matrix (not modified)
+ * \param prtlvl   Output level
+ *
+ * \return         Handle to the factorization, or NULL if the coarsest
+ *                 level should be solved iteratively
+ *
+ * \note A cached factorization of an identical matrix (from a previous
+ *       setup) is reused; the handle must be released by amg_coarse_free
+ *       (done by amg_data_free).
+ *
+ */
+void* amg_coarse_setup (dCSRmat *A,
+                        const SHORT prtlvl)
+{
+  const INT n=A->row, nnz=A->nnz;
+  coarse_factor *cf, *old=NULL;
+  unsigned long long key;
+  INT i,j,k;
+  SHORT flag;
+  REAL det,umin,umax;
+
+  // iterative solver for large coarse problems
+  if( (n>MAX_DIRECT_CDOF) || (n<=0) ){
+    if ( prtlvl > PRINT_MIN )
+      printf("Coarse solver: iterative (n=%lld, nnz=%lld)\n",(long long )n,(long long )nnz);
+    return NULL;
+  }
+
+  // reuse a factorization of the same matrix if there is one
+  key=coarse_key(A);
+  haz_lock(&coarse_lock);
+  for(k=0;k<COARSE_CACHE_SIZE;k++){
+    cf=coarse_cache[k];
+    if(cf && cf->key==key && coarse_same(&cf->A,A)){
+      cf->refs++;
+      cf->used=++coarse_cache_clock;
+      haz_unlock(&coarse_lock);
+      if ( prtlvl > PRINT_MIN )
+        printf("Coarse solver: reusing %s factorization (n=%lld, nnz=%lld)\n",
+               (cf->type==1)?"dense LU":"sparse direct",(long long )n,(long long )nnz);
+      return (void *)cf;
+    }
+  }
+  haz_unlock(&coarse_lock);
+
+  cf=(coarse_factor *)calloc(1,sizeof(coarse_factor));
+  cf->key=key;
+  cf->A=dcsr_create(A->row,A->col,nnz);
+  dcsr_cp(A,&cf->A);
+
+  // dense LU: small or nearly full coarse matrices
+  if( (n<=MAX_DENSE_CDOF) || ((n<=4*MAX_DENSE_CDOF) && (4.*nnz>(REAL )n*n)) ){
+    cf->type=1;
+    cf->lu=(REAL *)calloc((size_t )n*n,sizeof(REAL));
+    cf->perm=(INT *)calloc(n,sizeof(INT));
+    cf->work=(REAL *)calloc(n,sizeof(REAL));
+    for(i=0;i<n;i++)
+      for(j=A->IA[i];j<A->IA[i+1];j++)
+        cf->lu[(size_t )i*n+A->JA[j]]+=A->val[j];
+    // ddense_lu does not check the last pivot; look at all of them
+    flag=ddense_lu(1,n,&det,cf->lu,cf->perm,cf->work);
+    for(umax=0.,umin=BIGREAL,i=0;(i<n)&&(!flag);i++){
+      det=ABS(cf->lu[(size_t )cf->perm[i]*n+i]);
+      umax=MAX(umax,det); umin=MIN(umin,det);
+    }
+    if(flag || (umin<=1e-12*umax)){
+      // (nearly) singular, e.g. pure Neumann: leave it to the iterative solver
+      coarse_factor_free(cf);
+      if ( prtlvl > PRINT_MIN )
+        printf("Coarse solver: iterative, singular coarse matrix (n=%lld)\n",(long long )n);
+      return NULL;
+    }
+  }
+  // sparse direct
+  else {
+    cf->type=2;
+#if WITH_SUITESPARSE
+    // UMFPACK works with the transpose
+    dcsr_trans(A,&cf->At);
+    cf->Numeric=hazmath_factorize(&cf->At,0);
+#else
+    SHORT more_params[3]={1,1,0}; //={is_sym,use_perm,ordering_algorithm}
+    more_params[0]=coarse_is_symmetric(A);
+    cf->At=dcsr_create(A->row,A->col,nnz);
+    dcsr_cp(A,&cf->At);
+    cf->Numeric=run_hazmath_factorize(&cf->At,0,(void *)more_params);
+#endif
+    if(cf->Numeric==NULL){
+      coarse_factor_free(cf);
+      if ( prtlvl > PRINT_MIN )
+        printf("Coarse solver: iterative, sparse factorization failed (n=%lld)\n",(long long )n);
+      return NULL;
+    }
+  }
+
+  if ( prtlvl > PRINT_MIN )
+    printf("Coarse solver: %s (n=%lld, nnz=%lld)\n",
+           (cf->type==1)?"dense LU":"sparse direct",(long long )n,(long long )nnz);
+
+  // one reference for the caller and one for the cache, which takes a
+  // free slot or drops its least recently used entry
+  cf->refs=2;
+  haz_lock(&coarse_lock);
+  cf->used=++coarse_cache_clock;
+  for(i=0,k=0;i<COARSE_CACHE_SIZE;i++){
+    if(coarse_cache[i]==NULL){ k=i; break; }
+    if(coarse_cache[i]->used<coarse_cache[k]->used) k=i;
+  }
+  if(coarse_cache[k] && (--coarse_cache[k]->refs==0)) old=coarse_cache[k];
+  coarse_cache[k]=cf;
+  haz_unlock(&coarse_lock);
+  coarse_factor_free(old);
+
+  return (void *)cf;
+}
+
+/*******************************************************************/
+/**
+ * \fn INT amg_coarse_solve (void *Numeric, dvector *b, dvector *x)
+ *
+ * \brief Solve the coarsest level problem with the factorization from
+ *        amg_coarse_setup
+ *
+ * \param Numeric   Handle returned by amg_coarse_setup (not NULL)
+ * \param b         Pointer to the right hand side
+ * \param x         Pointer to the solution (output)
+ *
+ * \return          SUCCESS or error code of the direct solver
+ *
+ */
+INT amg_coarse_solve (void *Numeric,
+                      dvector *b,
+                      dvector *x)
+{
+  coarse_factor *cf=(coarse_factor *)Numeric;
+
+  if(cf->type==1){
+    array_cp(cf->A.row,b->val,x->val);
+    ddense_solve_pivot(0,cf->A.row,cf->lu,x->val,cf->perm,cf->work);
+    return SUCCESS;
+  }
+  return hazmath_solve(&cf->At,b,x,cf->Numeric,0);
+}
+
+/*******************************************************************/
+/**
+ * \fn void amg_coarse_free (void **Numeric)
+ *
+ * \brief Release a handle returned by amg_coarse_setup (the
+ *        factorization stays in the cache until it is evicted)
+ *
+ * \param Numeric   double pointer to the handle (set to NULL on output)
+ *
+ */
+void amg_coarse_free (void **Numeric)
+{
+  coarse_factor_release((coarse_factor *)Numeric[0]);
+  Numeric[0]=NULL;
+}
+
+/*******************************************************************/
+/**
+ * \fn void amg_coarse_cache_free (void)
+ *
+ * \brief Drop all cached coarsest level factorizations, e.g. at shutdown
+ *        (handles still held by AMG hierarchies remain valid)
+ *
+ */
+void amg_coarse_cache_free (void)
+{
+  INT k;
+  coarse_factor *cf[COARSE_CACHE_SIZE];
+  haz_lock(&coarse_lock);
+  for(k=0;k<COARSE_CACHE_SIZE;k++){
+    cf[k]=coarse_cache[k];
+    coarse_cache[k]=NULL;
+    if(cf[k] && (--cf[k]->refs>0)) cf[k]=NULL;
+  }
+  haz_unlock(&coarse_lock);
+  for(k=0;k<COARSE_CACHE_SIZE;k++) coarse_factor_free(cf[k]);
+}
+
+/*******************************************************************/
+/**
+ * \fn INT amg_coarse_cache_size (void)
+ *
+ * \brief Number of cached coarsest level factorizations
+ *
+ */
+INT amg_coarse_cache_size (void)
+{
+  INT k,count=0;
+  haz_lock(&coarse_lock);
+  for(k=0;k<COARSE_CACHE_SIZE;k++)
+    if(coarse_cache[k]) count++;
+  haz_unlock(&coarse_lock);
+  return count;
+}
 
 /*---------------------------------*/
 /*--        End of File          --*/
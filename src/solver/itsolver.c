@@ -2207,6 +2207,91 @@ MEMORY_ERROR:
 }
 
 
+/********************************************************************************************/
+/**
+ * \fn INT linear_solver_dcsr_krylov_amg_bsr (dCSRmat *A, dvector *b, dvector *x,
+ *                                            linear_itsolver_param *itparam,
+ *                                            AMG_param *amgparam, const INT nb)
+ *
+ * \brief Solve Ax=b by AMG preconditioned Krylov methods, using the BSR AMG
+ *        (amg_setup_ua_bsr) if A has a natural block structure
+ *
+ * \param A         Pointer to the coeff matrix in dCSRmat format
+ * \param b         Pointer to the right hand side in dvector format
+ * \param x         Pointer to the approx solution in dvector format
+ * \param itparam   Pointer to parameters for iterative solvers
+ * \param amgparam  Pointer to parameters of AMG
+ * \param nb        Block size if known (e.g. get_blocksize_fespace), or 0
+ *                  to detect it from A
+ *
+ * \return          Iteration number if converges; ERROR otherwise.
+ *
+ * \note Component-major systems (as assembled on a block_fespace or on a
+ *       vector P1 space) are reordered node-major for the BSR solve and
+ *       the solution is mapped back. Without a block structure this is
+ *       linear_solver_dcsr_krylov_amg.
+ *
+ */
+INT linear_solver_dcsr_krylov_amg_bsr(dCSRmat    *A,
+                                      dvector    *b,
+                                      dvector    *x,
+                                      linear_itsolver_param  *itparam,
+                                      AMG_param  *amgparam,
+                                      const INT   nb)
+{
+    const SHORT prtlvl = itparam->linear_print_level;
+
+    INT i, status;
+    ivector perm;
+    dCSRmat Ap, AT;
+    dBSRmat Ab;
+    dvector bp, xp;
+
+    INT nbA = dcsr_detect_block(A, nb, &perm);
+
+    if ( nbA <= 1 ) {
+        if ( prtlvl > PRINT_MIN ) printf("No block structure found: using CSR AMG\n");
+        return linear_solver_dcsr_krylov_amg(A, b, x, itparam, amgparam);
+    }
+
+    if ( prtlvl > PRINT_MIN )
+        printf("Block structure nb = %lld (%s): using BSR AMG\n",
+               (long long )nbA, perm.row ? "component-major, reordered" : "node-major");
+
+    if ( perm.row ) {
+        // Ap = A(perm,perm), bp = b(perm), xp = x(perm)
+        AT = dcsr_create(A->col, A->row, A->nnz);
+        Ap = dcsr_create(A->row, A->col, A->nnz);
+        dcsr_transz(A, perm.val, &AT);
+        dcsr_transz(&AT, perm.val, &Ap);
+        dcsr_free(&AT);
+        bp = dvec_create(b->row);
+        xp = dvec_create(x->row);
+        for ( i = 0; i < perm.row; ++i ) {
+            bp.val[i] = b->val[perm.val[i]];
+            xp.val[i] = x->val[perm.val[i]];
+        }
+        Ab = dcsr_2_dbsr(&Ap, nbA);
+        dcsr_free(&Ap);
+    }
+    else {
+        Ab = dcsr_2_dbsr(A, nbA);
+    }
+
+    status = linear_solver_dbsr_krylov_amg(&Ab, perm.row ? &bp : b,
+                                           perm.row ? &xp : x, itparam, amgparam);
+
+    if ( perm.row ) {
+        for ( i = 0; i < perm.row; ++i ) x->val[perm.val[i]] = xp.val[i];
+        dvec_free(&bp);
+        dvec_free(&xp);
+        ivec_free(&perm);
+    }
+    dbsr_free(&Ab);
+
+    return status;
+}
+
 /********************************************************************************************/
 // preconditioned Krylov methods for block CSR format
 /********************************************************************************************/
@@ -4021,16 +4106,11 @@ INT linear_solver_bdcsr_babuska_block_2(block_dCSRmat *A,
     // compute the rational approximation using AAA algorithms
     //    REAL err_max=get_rpzwf(frac_inv, (void *)func_param,	rpnwf, &mbig, &mmax_in, &k, xmin_in, xmax_in, AAA_tol, print_level);
     //    get_rpzwf(frac_inv, (void *)func_param,rpnwf, &mbig, &mmax_in, &k, xmin_in, xmax_in, AAA_tol, print_level);
-    REAL16 **zf=set_f_values(frac_inv,					\
-			     func_param[0],func_param[1],func_param[2],func_param[3], \
-			     &mbig,xmin_in,xmax_in,			\
-			     print_level);
-  //  for(i=0;i<numval;i++)fprintf(stdout,"\nz(%d)=%.16Le;f(%d)=%.16Le;",i+1,*(zf[0]+i),i+1,*(zf[1]+i));
-  //  fprintf(stdout,"\n");
-    get_rpzwf(mbig,zf[0],zf[1],rpnwf,&mmax_in,&k,AAA_tol,print_level);
-    free(zf[0]);
-    free(zf[1]);
-    free(zf);
+    // computed once for every set of parameters (see ra_cache.c)
+    get_rpzwf_cached("frac_inv",frac_inv,				\
+		     func_param[0],func_param[1],func_param[2],func_param[3], \
+		     mbig,xmin_in,xmax_in,					\
+		     rpnwf,&mmax_in,&k,AAA_tol,print_level);
     // assign poles and residules
     dvec_alloc(k,  &residues_r);
     dvec_alloc(k-1, &poles_r);
@@ -17,6 +17,27 @@
 /*---------------------------------*/
 /*--      Private Functions      --*/
 /*---------------------------------*/
+/***********************************************************************************************/
+/**
+ * \fn static void level_residual(AMG_data *mgl, REAL *x, REAL *r)
+ *
+ * \brief r = r - A*x on one level, with the SELL-C-sigma copy of A if there is one
+ *
+ * \param  mgl       pointer to the AMG data of the level
+ * \param  x         pointer to the iterate
+ * \param  r         pointer to the right hand side (OUTPUT: residual)
+ *
+ */
+static void level_residual(AMG_data *mgl,
+                           REAL *x,
+                           REAL *r)
+{
+    if ( mgl->As.row > 0 )
+        dsell_aAxpy(-1.0, &mgl->As, x, r);
+    else
+        dcsr_aAxpy(-1.0, &mgl->A, x, r);
+}
+
 /***********************************************************************************************/
 /**
  * \fn static void coarse_itsolver(dCSRmat *A, dvector *b, dvector *x,
@@ -292,7 +313,7 @@ ForwardSweep:
 
         // form residual r = b - A x
         array_cp(mgl[l].A.row, mgl[l].b.val, mgl[l].w.val);
-        dcsr_aAxpy(-1.0,&mgl[l].A, mgl[l].x.val, mgl[l].w.val);
+        level_residual(&mgl[l], mgl[l].x.val, mgl[l].w.val);
 
         // restriction r1 = R*r0
         switch ( amg_type ) {
@@ -320,6 +341,13 @@ ForwardSweep:
 	  break;
         }
 	  //#endif
+        case SOLVER_AUTO:
+            // dense LU or sparse direct; iterative if no factorization was made
+            if ( mgl[nl-1].Numeric != NULL )
+                amg_coarse_solve(mgl[nl-1].Numeric, &mgl[nl-1].b, &mgl[nl-1].x);
+            else
+                coarse_itsolver(&mgl[nl-1].A, &mgl[nl-1].b, &mgl[nl-1].x, tol, prtlvl);
+            break;
         default:
             // use iterative solver on the coarsest level
             coarse_itsolver(&mgl[nl-1].A, &mgl[nl-1].b, &mgl[nl-1].x, tol, prtlvl);
@@ -464,7 +492,7 @@ void amli(AMG_data *mgl,
 
         // form residual r = b - A x
         array_cp(m0,b0->val,r);
-        dcsr_aAxpy(-1.0,A0,e0->val,r);
+        level_residual(&mgl[level], e0->val, r);
 
         // restriction r1 = R*r0
         switch (amg_type) {
@@ -530,6 +558,13 @@ void amli(AMG_data *mgl,
                 break;
 		//#endif
 
+            case SOLVER_AUTO:
+                // dense LU or sparse direct; iterative if no factorization was made
+                if ( mgl[level].Numeric != NULL )
+                    amg_coarse_solve(mgl[level].Numeric, b0, e0);
+                else
+                    coarse_itsolver(A0, b0, e0, tol, prtlvl);
+                break;
             default:
                 /* use iterative solver on the coarsest level */
                 coarse_itsolver(A0, b0, e0, tol, prtlvl);
@@ -595,7 +630,7 @@ void nl_amli (AMG_data *mgl,
 
         // form residual r = b - A x
         array_cp(m0,b0->val,r);
-        dcsr_aAxpy(-1.0,A0,e0->val,r);
+        level_residual(&mgl[level], e0->val, r);
 
         // restriction r1 = R*r0
         switch (amg_type) {
@@ -674,6 +709,13 @@ void nl_amli (AMG_data *mgl,
                 break;
 		//#endif
 
+            case SOLVER_AUTO:
+                // dense LU or sparse direct; iterative if no factorization was made
+                if ( mgl[level].Numeric != NULL )
+                    amg_coarse_solve(mgl[level].Numeric, b0, e0);
+                else
+                    coarse_itsolver(A0, b0, e0, tol, prtlvl);
+                break;
             default:
                 /* use iterative solver on the coarsest level */
                 coarse_itsolver(A0, b0, e0, tol, prtlvl);
@@ -716,7 +758,7 @@ void mgcycle_add(AMG_data *mgl,
 
     // compute the residual on the finest level
     array_cp(mgl[0].A.row, mgl[0].b.val, mgl[0].w.val);
-    dcsr_aAxpy(-1.0,&mgl[0].A, mgl[0].x.val, mgl[0].w.val);
+    level_residual(&mgl[0], mgl[0].x.val, mgl[0].w.val);
 
     // main loop
     while ( l < nl-1 ) {
@@ -781,6 +823,13 @@ void mgcycle_add(AMG_data *mgl,
             break;
         }
 	  //#endif
+        case SOLVER_AUTO:
+            // dense LU or sparse direct; iterative if no factorization was made
+            if ( mgl[nl-1].Numeric != NULL )
+                amg_coarse_solve(mgl[nl-1].Numeric, &mgl[nl-1].b, &mgl[nl-1].x);
+            else
+                coarse_itsolver(&mgl[nl-1].A, &mgl[nl-1].b, &mgl[nl-1].x, tol, prtlvl);
+            break;
         default:
             // use iterative solver on the coarsest level
             coarse_itsolver(&mgl[nl-1].A, &mgl[nl-1].b, &mgl[nl-1].x, tol, prtlvl);
@@ -901,6 +950,13 @@ void mgcycle_add_update(AMG_data *mgl,
             break;
         }
 	  //#endif
+        case SOLVER_AUTO:
+            // dense LU or sparse direct; iterative if no factorization was made
+            if ( mgl[nl-1].Numeric != NULL )
+                amg_coarse_solve(mgl[nl-1].Numeric, &mgl[nl-1].b, &mgl[nl-1].x);
+            else
+                coarse_itsolver(&mgl[nl-1].A, &mgl[nl-1].b, &mgl[nl-1].x, tol, prtlvl);
+            break;
         default:
             // use iterative solver on the coarsest level
             coarse_itsolver(&mgl[nl-1].A, &mgl[nl-1].b, &mgl[nl-1].x, tol, prtlvl);
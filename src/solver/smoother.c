@@ -13,6 +13,37 @@
  */
 
 #include "hazmath.h"
+#include "../utilities/dbsr_block.inl"
+
+/*!
+ * \brief One block Gauss-Seidel sweep over rows i0, i0+step, ..., (i1
+ *        excluded) of a dBSRmat with fixed block size NB; one function per
+ *        block size in DBSR_FOR_EACH_NB (see dbsr_block.inl)
+ */
+#define DBSR_GS_NB(NB)                                                  \
+static void smoother_dbsr_gs_nb##NB(const dBSRmat *A,                   \
+                                    const REAL *b,                      \
+                                    REAL *u,                            \
+                                    const REAL *diaginv,                \
+                                    const INT i0,                       \
+                                    const INT i1,                       \
+                                    const INT step)                     \
+{                                                                       \
+    const INT  *IA = A->IA, *JA = A->JA;                                \
+    const REAL *val = A->val;                                           \
+    INT i, j, k, l;                                                     \
+    REAL t[NB];                                                         \
+    for ( i = i0; i != i1; i += step ) {                                \
+        for ( l = 0; l < NB; ++l ) t[l] = b[i*NB+l];                    \
+        for ( k = IA[i]; k < IA[i+1]; ++k ) {                           \
+            j = JA[k];                                                  \
+            if ( j != i ) dbsr_blk_ymAx_##NB(val+k*NB*NB, u+j*NB, t);   \
+        }                                                               \
+        dbsr_blk_mxv_##NB(diaginv+i*NB*NB, t, u+i*NB);                  \
+    }                                                                   \
+}
+
+DBSR_FOR_EACH_NB(DBSR_GS_NB)
 
 /*---------------------------------*/
 /*--      Public Functions       --*/
@@ -935,6 +966,14 @@ void smoother_dbsr_gs_ascend(dBSRmat *A,
         }
     }
     else if (nb > 1) {
+        // unrolled kernels for common block sizes
+#define DBSR_CASE_GS(NB) case NB: smoother_dbsr_gs_nb##NB(A, b_val, u_val, diaginv, 0, ROW, 1); return;
+        switch (nb) {
+            DBSR_FOR_EACH_NB(DBSR_CASE_GS)
+            default: break;
+        }
+#undef DBSR_CASE_GS
+
         REAL *b_tmp = (REAL *)calloc(nb, sizeof(REAL));
 
         for (i = 0; i < ROW; ++i) {
@@ -1003,6 +1042,14 @@ void smoother_dbsr_gs_descend(dBSRmat *A,
         }
     }
     else if (nb > 1) {
+        // unrolled kernels for common block sizes
+#define DBSR_CASE_GS(NB) case NB: smoother_dbsr_gs_nb##NB(A, b_val, u_val, diaginv, ROW-1, -1, -1); return;
+        switch (nb) {
+            DBSR_FOR_EACH_NB(DBSR_CASE_GS)
+            default: break;
+        }
+#undef DBSR_CASE_GS
+
         REAL *b_tmp = (REAL *)calloc(nb, sizeof(REAL));
 
         for (i = ROW-1; i >= 0; i--) {
@@ -0,0 +1,403 @@
+/*! \file src/timestepping/async_output.c
+ *
+ * \brief Asynchronous (background thread) output of time-series data:
+ *        the solution of a time step is copied into a ring of buffers
+ *        and written by a writer thread while the next step is computed.
+ *
+ *  Copyright 2015__HAZMATH__. All rights reserved.
+ *
+ * \note The mesh and FE spaces passed to async_dump_sol_vtk and
+ *       async_dump_blocksol_vtk are only read by the writer thread; they
+ *       must not be changed or freed before async_writer_flush (or
+ *       async_writer_free) returns. The vtu format is the one set by
+ *       vtu_set_format at the time the file is written.
+ *
+ * \note A writer has one producer: all async_* calls on the same
+ *       async_writer must come from the same thread.
+ *
+ * \note The writer thread needs WITH_PTHREADS (cmake -DUSE_PTHREADS=1).
+ *       Without it the same functions write the file at once, in the
+ *       calling thread.
+ */
+
+#include "hazmath.h"
+#if WITH_PTHREADS
+#include <pthread.h>
+#endif
+
+#define ASYNC_DVEC      0
+#define ASYNC_VTK       1
+#define ASYNC_BLOCKVTK  2
+
+/* one queued write */
+struct async_job {
+  SHORT kind;
+  char *fname;
+  char **varname;
+  INT nvar;
+  mesh_struct *mesh;
+  void *FE;
+  REAL *val;
+  INT n;
+  INT nalloc;
+};
+
+struct async_writer {
+
+  //! Number of buffers in the ring
+  INT nbuf;
+
+  //! The queued writes (nbuf of them)
+  struct async_job *job;
+
+  //! Oldest queued write
+  INT head;
+
+  //! Number of queued writes
+  INT count;
+
+#if WITH_PTHREADS
+  //! Set when the writer thread should exit
+  SHORT stop;
+
+  //! Writer thread
+  pthread_t thread;
+
+  //! Protects head, count and stop
+  pthread_mutex_t lock;
+
+  //! Signaled when a write is queued
+  pthread_cond_t queued;
+
+  //! Signaled when a write is done
+  pthread_cond_t done;
+
+  //! Next writer (list of writers flushed at exit)
+  struct async_writer *next;
+#endif
+
+};
+
+#if WITH_PTHREADS
+/* writers still alive, flushed at exit */
+static async_writer *async_list = NULL;
+static pthread_mutex_t async_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static SHORT async_atexit_set = 0;
+#endif
+
+/******************************************************************************/
+/* write one job; runs in the writer thread */
+static void async_job_write(struct async_job *job)
+{
+  dvector v;
+  switch(job->kind) {
+  case ASYNC_DVEC:
+    v.row = job->n; v.val = job->val;
+    dvec_write(job->fname,&v);
+    break;
+  case ASYNC_VTK:
+    dump_sol_vtk(job->fname,job->varname[0],job->mesh,(fespace *)job->FE,job->val);
+    break;
+  case ASYNC_BLOCKVTK:
+    dump_blocksol_vtk(job->fname,job->varname,job->mesh,(block_fespace *)job->FE,job->val);
+    break;
+  }
+}
+
+/* free the strings of a job (the buffer val is kept for reuse) */
+static void async_job_clear(struct async_job *job)
+{
+  INT i;
+  if(job->fname) free(job->fname);
+  for(i=0;i<job->nvar;i++) free(job->varname[i]);
+  if(job->varname) free(job->varname);
+  job->fname = NULL; job->varname = NULL; job->nvar = 0;
+}
+
+#if WITH_PTHREADS
+/* writer thread: write the queued jobs in order until stopped */
+static void *async_writer_loop(void *arg)
+{
+  async_writer *aw = (async_writer *)arg;
+  struct async_job *job;
+  for(;;) {
+    pthread_mutex_lock(&aw->lock);
+    while(aw->count==0 && !aw->stop) pthread_cond_wait(&aw->queued,&aw->lock);
+    if(aw->count==0) { // stop and nothing left
+      pthread_mutex_unlock(&aw->lock);
+      break;
+    }
+    job = &aw->job[aw->head];
+    pthread_mutex_unlock(&aw->lock);
+
+    async_job_write(job);
+    async_job_clear(job);
+
+    pthread_mutex_lock(&aw->lock);
+    aw->head = (aw->head+1)%aw->nbuf;
+    aw->count--;
+    pthread_cond_broadcast(&aw->done);
+    pthread_mutex_unlock(&aw->lock);
+  }
+  return NULL;
+}
+
+/* flush all writers (registered with atexit) */
+static void async_writer_flush_all(void)
+{
+  async_writer *aw;
+  pthread_mutex_lock(&async_list_lock);
+  for(aw=async_list;aw;aw=aw->next) async_writer_flush(aw);
+  pthread_mutex_unlock(&async_list_lock);
+}
+
+/* wait for a free buffer and return it with its val resized to n. The
+   buffer is taken outside the lock and only counted as queued by
+   async_job_put, so there must be a single producer per writer. */
+static struct async_job *async_job_get(async_writer *aw,
+                                       const INT n)
+{
+  struct async_job *job;
+  pthread_mutex_lock(&aw->lock);
+  while(aw->count==aw->nbuf) pthread_cond_wait(&aw->done,&aw->lock);
+  job = &aw->job[(aw->head+aw->count)%aw->nbuf];
+  pthread_mutex_unlock(&aw->lock);
+  if(job->nalloc<n) {
+    job->val = (REAL *)realloc(job->val,n*sizeof(REAL));
+    job->nalloc = n;
+  }
+  job->n = n;
+  return job;
+}
+
+/* hand a filled buffer to the writer thread */
+static void async_job_put(async_writer *aw)
+{
+  pthread_mutex_lock(&aw->lock);
+  aw->count++;
+  pthread_cond_signal(&aw->queued);
+  pthread_mutex_unlock(&aw->lock);
+}
+#else
+/* no writer thread: the one buffer of aw, with its val resized to n */
+static struct async_job *async_job_get(async_writer *aw,
+                                       const INT n)
+{
+  struct async_job *job = &aw->job[0];
+  if(job->nalloc<n) {
+    job->val = (REAL *)realloc(job->val,n*sizeof(REAL));
+    job->nalloc = n;
+  }
+  job->n = n;
+  return job;
+}
+
+/* no writer thread: write the buffer now */
+static void async_job_put(async_writer *aw)
+{
+  async_job_write(&aw->job[0]);
+  async_job_clear(&aw->job[0]);
+}
+#endif
+
+/******************************************************************************/
+/*!
+ * \fn async_writer *async_writer_create(const INT nbuf)
+ *
+ * \brief Create an asynchronous writer and start its thread
+ *
+ * \param nbuf    Number of buffers (<=0: ASYNC_NBUF); bounds the memory to
+ *                nbuf copies of the solution
+ *
+ * \return        Pointer to the async_writer
+ *
+ * \note Queued writes are flushed at exit; call async_writer_free to
+ *       stop the thread and release the buffers. Without WITH_PTHREADS
+ *       there is no thread and one buffer.
+ *
+ */
+async_writer *async_writer_create(const INT nbuf)
+{
+  async_writer *aw = (async_writer *)calloc(1,sizeof(async_writer));
+  aw->nbuf = (nbuf>0) ? nbuf : ASYNC_NBUF;
+#if !WITH_PTHREADS
+  aw->nbuf = 1; // each write is done at once
+#endif
+  aw->job = (struct async_job *)calloc(aw->nbuf,sizeof(struct async_job));
+  aw->head = 0;
+  aw->count = 0;
+#if WITH_PTHREADS
+  aw->stop = 0;
+  pthread_mutex_init(&aw->lock,NULL);
+  pthread_cond_init(&aw->queued,NULL);
+  pthread_cond_init(&aw->done,NULL);
+  if(pthread_create(&aw->thread,NULL,async_writer_loop,aw)) {
+    check_error(ERROR_ALLOC_MEM,__FUNCTION__);
+  }
+
+  pthread_mutex_lock(&async_list_lock);
+  aw->next = async_list;
+  async_list = aw;
+  if(!async_atexit_set) {
+    atexit(async_writer_flush_all);
+    async_atexit_set = 1;
+  }
+  pthread_mutex_unlock(&async_list_lock);
+#endif
+
+  return aw;
+}
+
+/******************************************************************************/
+/*!
+ * \fn void async_writer_flush(async_writer *aw)
+ *
+ * \brief Wait until all queued writes are on disk
+ *
+ * \param aw      Pointer to the async_writer
+ *
+ */
+void async_writer_flush(async_writer *aw)
+{
+#if WITH_PTHREADS
+  pthread_mutex_lock(&aw->lock);
+  while(aw->count>0) pthread_cond_wait(&aw->done,&aw->lock);
+  pthread_mutex_unlock(&aw->lock);
+#endif
+}
+
+/******************************************************************************/
+/*!
+ * \fn void async_writer_free(async_writer *aw)
+ *
+ * \brief Flush, stop the writer thread and free the async_writer
+ *
+ * \param aw      Pointer to the async_writer
+ *
+ */
+void async_writer_free(async_writer *aw)
+{
+  INT i;
+#if WITH_PTHREADS
+  async_writer **p;
+#endif
+  if(aw==NULL) return;
+
+#if WITH_PTHREADS
+  pthread_mutex_lock(&aw->lock);
+  aw->stop = 1;
+  pthread_cond_signal(&aw->queued);
+  pthread_mutex_unlock(&aw->lock);
+  pthread_join(aw->thread,NULL);
+
+  pthread_mutex_lock(&async_list_lock);
+  for(p=&async_list;*p;p=&(*p)->next) {
+    if(*p==aw) { *p = aw->next; break; }
+  }
+  pthread_mutex_unlock(&async_list_lock);
+  pthread_mutex_destroy(&aw->lock);
+  pthread_cond_destroy(&aw->queued);
+  pthread_cond_destroy(&aw->done);
+#endif
+
+  for(i=0;i<aw->nbuf;i++) {
+    async_job_clear(&aw->job[i]);
+    if(aw->job[i].val) free(aw->job[i].val);
+  }
+  free(aw->job);
+  free(aw);
+}
+
+/******************************************************************************/
+/*!
+ * \fn void async_dvec_write(async_writer *aw, const char *filename, dvector *vec)
+ *
+ * \brief Queue dvec_write(filename,vec); vec may be changed on return
+ *
+ * \param aw        Pointer to the async_writer
+ * \param filename  File name
+ * \param vec       Pointer to the dvector
+ *
+ */
+void async_dvec_write(async_writer *aw,
+                      const char *filename,
+                      dvector *vec)
+{
+  struct async_job *job = async_job_get(aw,vec->row);
+  job->kind = ASYNC_DVEC;
+  job->fname = strdup(filename);
+  memcpy(job->val,vec->val,vec->row*sizeof(REAL));
+  async_job_put(aw);
+}
+
+/******************************************************************************/
+/*!
+ * \fn void async_dump_sol_vtk(async_writer *aw, char *namevtk, char *varname,
+ *                             mesh_struct *mesh, fespace *FE, REAL *sol)
+ *
+ * \brief Queue dump_sol_vtk(namevtk,varname,mesh,FE,sol); sol may be
+ *        changed on return
+ *
+ * \param aw       Pointer to the async_writer
+ * \param namevtk  Filename
+ * \param varname  String for variable name
+ * \param mesh     Mesh struct to dump
+ * \param FE       FE space of solution
+ * \param sol      solution vector to dump
+ *
+ */
+void async_dump_sol_vtk(async_writer *aw,
+                        char *namevtk,
+                        char *varname,
+                        mesh_struct *mesh,
+                        fespace *FE,
+                        REAL *sol)
+{
+  struct async_job *job = async_job_get(aw,FE->ndof);
+  job->kind = ASYNC_VTK;
+  job->fname = strdup(namevtk);
+  job->nvar = 1;
+  job->varname = (char **)malloc(sizeof(char *));
+  job->varname[0] = strdup(varname);
+  job->mesh = mesh;
+  job->FE = FE;
+  memcpy(job->val,sol,FE->ndof*sizeof(REAL));
+  async_job_put(aw);
+}
+
+/******************************************************************************/
+/*!
+ * \fn void async_dump_blocksol_vtk(async_writer *aw, char *namevtk, char **varname,
+ *                                  mesh_struct *mesh, block_fespace *FE, REAL *sol)
+ *
+ * \brief Queue dump_blocksol_vtk(namevtk,varname,mesh,FE,sol); sol may be
+ *        changed on return
+ *
+ * \param aw       Pointer to the async_writer
+ * \param namevtk  Filename
+ * \param varname  String for variable names
+ * \param mesh     Mesh struct to dump
+ * \param FE       Block FE space of solution
+ * \param sol      solution vector to dump
+ *
+ */
+void async_dump_blocksol_vtk(async_writer *aw,
+                             char *namevtk,
+                             char **varname,
+                             mesh_struct *mesh,
+                             block_fespace *FE,
+                             REAL *sol)
+{
+  INT i;
+  struct async_job *job = async_job_get(aw,FE->ndof);
+  job->kind = ASYNC_BLOCKVTK;
+  job->fname = strdup(namevtk);
+  job->nvar = FE->nspaces;
+  job->varname = (char **)malloc(FE->nspaces*sizeof(char *));
+  for(i=0;i<FE->nspaces;i++) job->varname[i] = strdup(varname[i]);
+  job->mesh = mesh;
+  job->FE = FE;
+  memcpy(job->val,sol,FE->ndof*sizeof(REAL));
+  async_job_put(aw);
+}
+/*EOF*/
@@ -10,6 +10,121 @@
 
 #include "hazmath.h"
 
+/* At gets the union of the patterns of M and A (the entries of M, then the
+   new entries of A, row by row: the order of dcsr_add); mmap and amap get
+   the positions of the entries of M and A in At. M or A can be NULL. */
+static void timeop_pattern(dCSRmat *M,dCSRmat *A,dCSRmat *At,ivector *mmap,ivector *amap)
+{
+  dCSRmat *B[2]={M,A};
+  ivector *map[2]={mmap,amap};
+  INT row = M ? M->row : A->row, col = M ? M->col : A->col;
+  INT i,j,k,l,nnz=0;
+  INT *mark=(INT *)calloc(MAX(col,1),sizeof(INT));
+
+  for(j=0;j<col;j++) mark[j]=-1;
+  for(l=0;l<2;l++) {
+    ivec_free(map[l]);
+    ivec_alloc(B[l] ? B[l]->nnz : 0,map[l]);
+    nnz += map[l]->row;
+  }
+  dcsr_free(At);
+  At->row=row; At->col=col;
+  At->IA=(INT *)calloc(row+1,sizeof(INT));
+  At->JA=(INT *)calloc(MAX(nnz,1),sizeof(INT));
+  nnz=0;
+  for(i=0;i<row;i++) {
+    At->IA[i]=nnz;
+    for(l=0;l<2;l++) {
+      if(!B[l]) continue;
+      for(k=B[l]->IA[i];k<B[l]->IA[i+1];k++) {
+        j=B[l]->JA[k];
+        if(mark[j]<At->IA[i]) {
+          mark[j]=nnz;
+          At->JA[nnz++]=j;
+        }
+        map[l]->val[k]=mark[j];
+      }
+    }
+  }
+  At->IA[row]=nnz;
+  At->nnz=nnz;
+  At->JA=(INT *)realloc(At->JA,MAX(nnz,1)*sizeof(INT));
+  At->val=(REAL *)calloc(MAX(nnz,1),sizeof(REAL));
+  free(mark);
+}
+
+/* 1 if the pattern of At has not been computed for M and A */
+static SHORT timeop_stale(dCSRmat *M,dCSRmat *A,dCSRmat *At,ivector *mmap,ivector *amap)
+{
+  return (At->IA==NULL || mmap->row!=(M ? M->nnz : 0) || amap->row!=(A ? A->nnz : 0));
+}
+
+/* At = M + c*A on the pattern from timeop_pattern: one pass over the values */
+static void timeop_values(dCSRmat *M,dCSRmat *A,REAL c,dCSRmat *At,ivector *mmap,ivector *amap)
+{
+  INT k;
+  memset(At->val,0,At->nnz*sizeof(REAL));
+  if(M) for(k=0;k<M->nnz;k++) At->val[mmap->val[k]] += M->val[k];
+  if(A) for(k=0;k<A->nnz;k++) At->val[amap->val[k]] += c*A->val[k];
+}
+
+/* Anb shares the pattern (IA, JA) of At and gets a copy of its values */
+static void timeop_share(dCSRmat *At,dCSRmat *Anb)
+{
+  if(Anb->IA!=At->IA) {
+    dcsr_free(Anb);
+    Anb->row=At->row; Anb->col=At->col; Anb->nnz=At->nnz;
+    Anb->IA=At->IA;
+    Anb->JA=At->JA;
+    Anb->val=(REAL *)calloc(MAX(At->nnz,1),sizeof(REAL));
+  }
+  memcpy(Anb->val,At->val,At->nnz*sizeof(REAL));
+}
+
+/* Anb stops sharing the pattern of At (before At is freed or rebuilt) */
+static void timeop_unshare(dCSRmat *At,dCSRmat *Anb)
+{
+  if(Anb && At && Anb->IA && Anb->IA==At->IA) {
+    Anb->IA=NULL;
+    Anb->JA=NULL;
+    dcsr_free(Anb);
+  }
+}
+
+/* Positions in At of the entries that the elimination of the Dirichlet dofs
+   sets to zero (zero) and to one (one, the diagonal of the Dirichlet rows).
+   rowshift and colshift are the global numbers of the first row and column
+   of At; diag indicates a diagonal block. */
+static void timeop_bc_lists(dCSRmat *At,INT *dirichlet,INT rowshift,INT colshift,SHORT diag,
+                            ivector *zero,ivector *one)
+{
+  INT i,k,nz=0,no=0;
+  ivec_free(zero);
+  ivec_free(one);
+  ivec_alloc(At->nnz,zero);
+  ivec_alloc(At->row,one);
+  for(i=0;i<At->row;i++) {
+    for(k=At->IA[i];k<At->IA[i+1];k++) {
+      if(dirichlet[i+rowshift]==1) { // Boundary Row
+        if(diag && At->JA[k]==i) one->val[no++]=k;
+        else zero->val[nz++]=k;
+      } else if(dirichlet[At->JA[k]+colshift]==1) { // Boundary Column
+        zero->val[nz++]=k;
+      }
+    }
+  }
+  zero->row=nz;
+  one->row=no;
+}
+
+/* Applies the lists from timeop_bc_lists */
+static void timeop_bc_apply(dCSRmat *At,ivector *zero,ivector *one)
+{
+  INT k;
+  for(k=0;k<zero->row;k++) At->val[zero->val[k]] = 0.0;
+  for(k=0;k<one->row;k++) At->val[one->val[k]] = 1.0;
+}
+
 //**** NON-BLOCK STUFF ******/
 /******************************************************************************************************/
 /*!
@@ -67,13 +182,22 @@ void initialize_timestepper(timestepper *tstepper,input_param *inparam,INT rhs_t
   // Matrices and Vectors
   tstepper->M=NULL;
   tstepper->A=NULL;
-  tstepper->At=malloc(sizeof(struct dCSRmat)); /* A_time */
-  tstepper->At_noBC=malloc(sizeof(struct dCSRmat)); /* A_time with no boundary elimination */
+  tstepper->At=calloc(1,sizeof(struct dCSRmat)); /* A_time */
+  tstepper->At_noBC=calloc(1,sizeof(struct dCSRmat)); /* A_time with no boundary elimination */
   tstepper->sol_prev=malloc(sizeof(struct dvector)); /* uprev */
   tstepper->sol=NULL;      /* u */
   tstepper->rhs=NULL;     /* f */
   tstepper->rhs_prev=malloc(sizeof(struct dvector)); /* fprev */
   tstepper->rhs_time=malloc(sizeof(struct dvector));
+  tstepper->M_to_At=NULL;  /* built at the first update_timeoperator */
+  tstepper->A_to_At=NULL;
+  tstepper->bc_zero=NULL;  /* built at the first eliminate_timeoperator_DirichletBC */
+  tstepper->bc_one=NULL;
+
+  // Bounds for adaptive timestepping
+  tstepper->dt_min = 1e-8*tstepper->dt;
+  tstepper->dt_max = BIGREAL;
+  tstepper->err_est = 0.0;
 
   dvec_alloc(tstepper->old_steps*ndof,tstepper->sol_prev);
   dvec_alloc(ndof,tstepper->rhs_prev);
@@ -99,9 +223,15 @@ void initialize_timestepper(timestepper *tstepper,input_param *inparam,INT rhs_t
  *
  * \return n_it         Freed struct for Timestepping
  *
+ * \note At_noBC shares IA and JA with At, so this is the only safe way to free
+ *       them (dcsr_free on either one frees the shared arrays twice).
+ *
  */
 void free_timestepper(timestepper* ts)
 {
+  // At_noBC may share the pattern of At
+  timeop_unshare(ts->At,ts->At_noBC);
+
   if(ts->A) {
     dcsr_free(ts->A);
     ts->A=NULL;
@@ -152,6 +282,30 @@ void free_timestepper(timestepper* ts)
       ts->rhs_time=NULL;
   }
 
+  if(ts->M_to_At) {
+    ivec_free(ts->M_to_At);
+    free(ts->M_to_At);
+    ts->M_to_At=NULL;
+  }
+
+  if(ts->A_to_At) {
+    ivec_free(ts->A_to_At);
+    free(ts->A_to_At);
+    ts->A_to_At=NULL;
+  }
+
+  if(ts->bc_zero) {
+    ivec_free(ts->bc_zero);
+    free(ts->bc_zero);
+    ts->bc_zero=NULL;
+  }
+
+  if(ts->bc_one) {
+    ivec_free(ts->bc_one);
+    free(ts->bc_one);
+    ts->bc_one=NULL;
+  }
+
   return;
 }
 /****************************************************************************************/
@@ -172,7 +326,7 @@ void update_timestep(timestepper *tstepper)
 
   // Counters and Physical Time
   tstepper->current_step++;
-  tstepper->time = tstepper->current_step*tstepper->dt;
+  tstepper->time = tstepper->time + tstepper->dt;
 
   // If using BDF-k store last k timesteps
   INT k = tstepper->old_steps;
@@ -204,11 +358,18 @@ void update_timestep(timestepper *tstepper)
  *        Assumes we have: M du/dt + L(u) = b
  *
  * \param ts            Timestepping struct
- * \param first_visit   Indicates if this is the first visit in order to do allocation.
+ * \param first_visit   Forces a recomputation of the pattern of At (set it if M or A
+ *                      got a new pattern with the same number of nonzeros)
  * \param cpyNoBC       Indicates if you'd like to store the time matrix without BC eliminated
  *
  * \return ts.Atime     Matrix to solve with
  *
+ * \note At is updated in place on a cached pattern (see update_timeoperator), so
+ *       it can be called at every step with a new dt or a new A of the same pattern.
+ *       The pattern is only checked through the number of nonzeros of M and A.
+ *       At_noBC shares IA and JA with At and only gets a copy of the values.
+ *       The Dirichlet elimination can be redone with eliminate_timeoperator_DirichletBC.
+ *
  */
 void get_timeoperator(timestepper* ts,INT first_visit,INT cpyNoBC)
 {
@@ -218,25 +379,30 @@ void get_timeoperator(timestepper* ts,INT first_visit,INT cpyNoBC)
   REAL dt = ts->dt;
   INT time_scheme = ts->time_scheme;
 
+  // drop the cached pattern so that update_timeoperator recomputes it
+  if(first_visit && ts->At) {
+    timeop_unshare(ts->At,ts->At_noBC);
+    dcsr_free(ts->At);
+  }
+
   switch (time_scheme) {
   case 0: // Crank-Nicolson: (M + 0.5*dt*A)u = (M*uprev - 0.5*dt*L(uprev) + 0.5*dt*(b_old + b)
-    dcsr_add(ts->M,1.0,ts->A,0.5*dt,ts->At);
+    update_timeoperator(ts,0.5*dt);
     break;
   case 1: // Backward Euler: (M + dt*A)u = M*uprev + dt*b
-    dcsr_add(ts->M,1.0,ts->A,dt,ts->At);
+    update_timeoperator(ts,dt);
     break;
   case 2: // BDF-2: (M + (2/3)*dt*A)u = (4/3)*M*uprev - (1/3)*M*uprevprev+ (2/3)*dt*b
-    dcsr_add(ts->M,1.0,ts->A,2.0*dt/3.0,ts->At);
+    update_timeoperator(ts,2.0*dt/3.0);
     break;
   default:
     status = ERROR_TS_TYPE;
     check_error(status, __FUNCTION__);
   }
 
-  if(first_visit)
-    dcsr_alloc(ts->At->row,ts->At->col,ts->At->nnz,ts->At_noBC);
+  // At_noBC shares the pattern of At
   if(cpyNoBC)
-    dcsr_cp(ts->At,ts->At_noBC);
+    timeop_share(ts->At,ts->At_noBC);
 
   return;
 }
@@ -328,6 +494,201 @@ void update_time_rhs(timestepper *ts)
 }
 /******************************************************************************************************/
 
+/******************************************************************************************************/
+/*!
+ * \fn void update_timeoperator(timestepper *ts,REAL c)
+ *
+ * \brief Computes At = M + c*A on the union of the sparsity patterns of M and A
+ *
+ * \param ts            Timestepping struct
+ * \param c             Coefficient of A (e.g. dt for Backward Euler, 0.5*dt for Crank-Nicolson)
+ *
+ * \return ts.At        Time operator (no boundary conditions eliminated)
+ *
+ * \note The pattern of At (same order of the entries as dcsr_add) and the
+ *       positions of the entries of M and A in it are computed the first
+ *       time and kept in ts->M_to_At and ts->A_to_At. After that every
+ *       call is one pass over the values of M and A, so dt can change at
+ *       every step. The pattern is recomputed if the number of nonzeros of
+ *       M or A changes; a new pattern with the same number of nonzeros is
+ *       not detected (use get_timeoperator with first_visit=1).
+ *
+ */
+void update_timeoperator(timestepper *ts,REAL c)
+{
+  if(!ts->M_to_At) {
+    ts->M_to_At=calloc(1,sizeof(struct ivector));
+    ts->A_to_At=calloc(1,sizeof(struct ivector));
+  }
+
+  if(timeop_stale(ts->M,ts->A,ts->At,ts->M_to_At,ts->A_to_At)) {
+    timeop_unshare(ts->At,ts->At_noBC);
+    timeop_pattern(ts->M,ts->A,ts->At,ts->M_to_At,ts->A_to_At);
+    // the Dirichlet lists refer to the old pattern
+    if(ts->bc_zero) ivec_free(ts->bc_zero);
+    if(ts->bc_one) ivec_free(ts->bc_one);
+  }
+
+  timeop_values(ts->M,ts->A,c,ts->At,ts->M_to_At,ts->A_to_At);
+
+  return;
+}
+/******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn void eliminate_timeoperator_DirichletBC(timestepper *ts,INT *dirichlet)
+ *
+ * \brief Eliminates the Dirichlet boundaries from the time operator At (as in
+ *        eliminate_DirichletBC with b=NULL) using cached lists of entries
+ *
+ * \param ts            Timestepping struct
+ * \param dirichlet     Dirichlet flags of the DOF (FE->dirichlet)
+ *
+ * \return ts.At        Time operator with boundaries eliminated
+ *
+ * \note The positions of the entries of At to set to 0 and 1 are computed at
+ *       the first call after the pattern of At is (re)computed and kept in
+ *       ts->bc_zero and ts->bc_one. After that only these entries are
+ *       touched, so the elimination can be repeated after every update of
+ *       At. The RHS is still done with eliminate_DirichletBC_RHS and At_noBC.
+ *
+ */
+void eliminate_timeoperator_DirichletBC(timestepper *ts,INT *dirichlet)
+{
+  if(!ts->bc_zero) {
+    ts->bc_zero=calloc(1,sizeof(struct ivector));
+    ts->bc_one=calloc(1,sizeof(struct ivector));
+  }
+  if(!ts->bc_zero->val)
+    timeop_bc_lists(ts->At,dirichlet,0,0,1,ts->bc_zero,ts->bc_one);
+
+  timeop_bc_apply(ts->At,ts->bc_zero,ts->bc_one);
+
+  return;
+}
+/******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn INT adaptive_timestep(timestepper *ts,REAL tol,void (*rhs_fun)(timestepper *,void *),
+ *                           INT (*solve)(timestepper *,void *),void *data)
+ *
+ * \brief Performs one time step with step size control.
+ *        The step is computed with Backward Euler and with Crank-Nicolson from
+ *        the same solution and their difference is the error estimate.
+ *        Steps with a too large error are rejected and repeated with a smaller dt.
+ *
+ * \param ts            Timestepping struct: ts->sol is the solution at ts->time,
+ *                      ts->dt the step size to try (time_scheme 0 or 1)
+ * \param tol           Tolerance for the local error: ||u_CN-u_BE|| <= tol*(1+||u||)
+ *                      (discrete RMS norms)
+ * \param rhs_fun       If ts->rhs_timedep, computes ts->rhs at ts->time (can be NULL otherwise)
+ * \param solve         Solves ts->At*ts->sol = ts->rhs_time at ts->time (with ts->sol as
+ *                      the initial guess; boundary conditions are eliminated here as
+ *                      ts->At is rewritten at every solve); returns < 0 if it fails
+ * \param data          Passed to rhs_fun and solve
+ *
+ * \return              Number of rejected steps (>= 0), ERROR_TS_STEP if a step of size
+ *                      ts->dt_min is rejected, or the error (< 0) of solve if it fails;
+ *                      ts->sol and ts->time are unchanged in both error cases
+ *
+ * \note On return ts->sol, ts->time and ts->current_step are those of the accepted
+ *       step: time_scheme=1 keeps the Backward Euler solution (L-stable, for long
+ *       quiescent phases), time_scheme=0 keeps the Crank-Nicolson solution. ts->dt
+ *       is the step size proposed for the next step (between ts->dt_min and
+ *       ts->dt_max) and ts->err_est the error estimate relative to tol.
+ *       Call it instead of update_timestep, update_time_rhs and get_timeoperator.
+ *       The time operators are updated with update_timeoperator.
+ *
+ */
+INT adaptive_timestep(timestepper *ts,REAL tol,void (*rhs_fun)(timestepper *,void *),
+                      INT (*solve)(timestepper *,void *),void *data)
+{
+  INT ndof = ts->sol->row;
+  INT time_scheme = ts->time_scheme;
+  INT i, nreject = 0, flag;
+  REAL time = ts->time;
+  REAL dt = ts->dt;
+  REAL est,fac;
+  REAL rms = 1.0/sqrt((REAL )MAX(ndof,1));
+
+  if(time_scheme!=0 && time_scheme!=1) {
+    check_error(ERROR_TS_TYPE, __FUNCTION__);
+  }
+
+  dvector ube = dvec_create(ndof);
+
+  // Solution and RHS at the current time
+  array_cp(ndof,ts->sol->val,ts->sol_prev->val);
+  array_cp(ndof,ts->rhs->val,ts->rhs_prev->val);
+
+  while(1) {
+    ts->dt = dt;
+    ts->time = time + dt;
+    if(ts->rhs_timedep && rhs_fun) rhs_fun(ts,data);
+
+    // Backward Euler: (M + dt*A)u = M*uprev + dt*b
+    ts->time_scheme = 1;
+    update_time_rhs(ts);
+    update_timeoperator(ts,dt);
+    array_cp(ndof,ts->sol_prev->val,ts->sol->val);
+    flag = solve(ts,data);
+    array_cp(ndof,ts->sol->val,ube.val);
+
+    // Crank-Nicolson: (M + 0.5*dt*A)u = M*uprev - 0.5*dt*L(uprev) + 0.5*dt*(b_old + b)
+    // (from the same initial guess as Backward Euler)
+    if(flag>=0) {
+      ts->time_scheme = 0;
+      update_time_rhs(ts);
+      update_timeoperator(ts,0.5*dt);
+      array_cp(ndof,ts->sol_prev->val,ts->sol->val);
+      flag = solve(ts,data);
+    }
+    ts->time_scheme = time_scheme;
+
+    // A failed solve is not a rejected step: give up with the solver's error
+    if(flag<0) {
+      ts->time = time;
+      array_cp(ndof,ts->sol_prev->val,ts->sol->val);
+      dvec_free(&ube);
+      return flag;
+    }
+
+    // Error estimate (of the Backward Euler step)
+    est = 0.0;
+    for(i=0;i<ndof;i++) est += (ts->sol->val[i]-ube.val[i])*(ts->sol->val[i]-ube.val[i]);
+    est = rms*sqrt(est)/(tol*(1.0+rms*array_norm2(ndof,ts->sol->val)));
+
+    // New step size (the local error of Backward Euler is O(dt^2))
+    fac = (est>0.0) ? 0.9/sqrt(est) : 5.0;
+    fac = MIN(5.0,MAX(0.2,fac));
+    if(est<=1.0) break;
+
+    // Reject
+    nreject++;
+    dt = MAX(dt*MIN(fac,0.5),ts->dt_min);
+    if(ts->dt<=ts->dt_min) {
+      ts->time = time;
+      ts->dt = dt;
+      array_cp(ndof,ts->sol_prev->val,ts->sol->val);
+      dvec_free(&ube);
+      return ERROR_TS_STEP;
+    }
+  }
+
+  // Accept
+  if(time_scheme==1) array_cp(ndof,ube.val,ts->sol->val);
+  if(nreject) fac = MIN(fac,1.0);
+  ts->current_step++;
+  ts->err_est = est;
+  ts->dt = MIN(ts->dt_max,MAX(ts->dt_min,dt*fac));
+
+  dvec_free(&ube);
+  return nreject;
+}
+/******************************************************************************************************/
+
 //**** BLOCK Versions ******/
 /******************************************************************************************************/
 /*!
@@ -394,6 +755,10 @@ void initialize_blktimestepper(block_timestepper *tstepper,input_param *inparam,
 
   bdcsr_alloc(blksize,blksize,tstepper->At);
   bdcsr_alloc(blksize,blksize,tstepper->At_noBC);
+  tstepper->M_to_At=NULL;  /* built at the first update_blktimeoperator */
+  tstepper->A_to_At=NULL;
+  tstepper->bc_zero=NULL;  /* built at the first eliminate_blktimeoperator_DirichletBC */
+  tstepper->bc_one=NULL;
   dvec_alloc(tstepper->old_steps*ndof,tstepper->sol_prev);
   dvec_alloc(ndof,tstepper->rhs_prev);
   dvec_alloc(ndof,tstepper->rhs_time);
@@ -421,9 +786,19 @@ void initialize_blktimestepper(block_timestepper *tstepper,input_param *inparam,
  *
  * \return n_it   Freed struct for block Timestepping
  *
+ * \note The blocks of At_noBC share IA and JA with the blocks of At, so this is
+ *       the only safe way to free them.
+ *
  */
 void free_blktimestepper(block_timestepper* ts, INT flag)
 {
+  INT k, nb = ts->At ? ts->At->brow*ts->At->bcol : 0;
+
+  // At_noBC may share the pattern of At
+  if(ts->At && ts->At_noBC && ts->At_noBC->blocks) {
+    for(k=0;k<nb;k++)
+      if(ts->At->blocks[k]) timeop_unshare(ts->At->blocks[k],ts->At_noBC->blocks[k]);
+  }
 
   if(ts->A) {
     if (flag == 0){
@@ -485,6 +860,28 @@ void free_blktimestepper(block_timestepper* ts, INT flag)
       ts->rhs_time=NULL;
   }
 
+  if(ts->M_to_At) {
+    for(k=0;k<nb;k++) {
+      ivec_free(&ts->M_to_At[k]);
+      ivec_free(&ts->A_to_At[k]);
+    }
+    free(ts->M_to_At);
+    free(ts->A_to_At);
+    ts->M_to_At=NULL;
+    ts->A_to_At=NULL;
+  }
+
+  if(ts->bc_zero) {
+    for(k=0;k<nb;k++) {
+      ivec_free(&ts->bc_zero[k]);
+      ivec_free(&ts->bc_one[k]);
+    }
+    free(ts->bc_zero);
+    free(ts->bc_one);
+    ts->bc_zero=NULL;
+    ts->bc_one=NULL;
+  }
+
   return;
 }
 /****************************************************************************************/
@@ -532,43 +929,186 @@ void update_blktimestep(block_timestepper *tstepper)
 
 /******************************************************************************************************/
 /*!
-* \fn void get_blktimeoperator(block_timestepper* ts,INT cpyNoBC)
+* \fn void get_blktimeoperator(block_timestepper* ts,INT first_visit,INT cpyNoBC)
 *
 * \brief Gets the matrix to solve for BLOCK timestepping scheme
 *        Assumes we have: M du/dt + L(u) = b
 *
 * \param ts            block Timestepping struct
-* \param first_visit   Indicates if this is the first visit in order to do allocation.
+* \param first_visit   Forces a recomputation of the patterns of the blocks of At (set it if
+*                      a block of M or A got a new pattern with the same number of nonzeros)
 * \param cpyNoBC       Indicates if you'd like to store the time matrix without BC eliminated
 *
 * \return ts.Atime     Matrix to solve with
 *
+* \note At is updated in place on cached block patterns (see update_blktimeoperator);
+*       the blocks of At_noBC share IA and JA with the blocks of At. The patterns
+*       are only checked through the number of nonzeros of the blocks of M and A.
+*
 */
 void get_blktimeoperator(block_timestepper* ts,INT first_visit,INT cpyNoBC)
 {
     // Flag for errors
     SHORT status;
+    INT k;
 
     REAL dt = ts->dt;
     INT time_scheme = ts->time_scheme;
 
+    // drop the cached patterns so that update_blktimeoperator recomputes them
+    if(first_visit && ts->At) {
+      for(k=0;k<(ts->At->brow*ts->At->bcol);k++) {
+        if(ts->At->blocks[k]==NULL) continue;
+        timeop_unshare(ts->At->blocks[k],ts->At_noBC->blocks[k]);
+        dcsr_free(ts->At->blocks[k]);
+      }
+    }
+
     switch (time_scheme) {
       case 0: // Crank-Nicolson: (M + 0.5*dt*A)u = (M*uprev - 0.5*dt*L(uprev) + 0.5*dt*(b_old + b)
-        bdcsr_add(ts->M,1.0,ts->A,0.5*dt,ts->At);
+        update_blktimeoperator(ts,0.5*dt);
         break;
       case 1: // Backward Euler: (M + dt*A)u = M*uprev + dt*b
-        bdcsr_add(ts->M,1.0,ts->A,dt,ts->At);
+        update_blktimeoperator(ts,dt);
         break;
       case 2: // BDF-2: (M + (2/3)*dt*A)u = (4/3)*M*uprev - (1/3)*M*uprevprev+ (2/3)*dt*b
-        bdcsr_add(ts->M,1.0,ts->A,2.0*dt/3.0,ts->At);
+        update_blktimeoperator(ts,2.0*dt/3.0);
         break;
       default:
         status = ERROR_TS_TYPE;
         check_error(status, __FUNCTION__);
     }
-    if(cpyNoBC)
-      bdcsr_cp(ts->At,ts->At_noBC);
 
+    // The blocks of At_noBC share the pattern of the blocks of At
+    if(cpyNoBC) {
+      for(k=0;k<(ts->At->brow*ts->At->bcol);k++) {
+        if(ts->At->blocks[k]==NULL) {
+          if(ts->At_noBC->blocks[k]) {
+            dcsr_free(ts->At_noBC->blocks[k]);
+            free(ts->At_noBC->blocks[k]);
+            ts->At_noBC->blocks[k]=NULL;
+          }
+          continue;
+        }
+        if(!ts->At_noBC->blocks[k]) ts->At_noBC->blocks[k]=calloc(1,sizeof(struct dCSRmat));
+        timeop_share(ts->At->blocks[k],ts->At_noBC->blocks[k]);
+      }
+    }
+
+  return;
+}
+/******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn void update_blktimeoperator(block_timestepper *ts,REAL c)
+ *
+ * \brief Computes At = M + c*A blockwise on the union of the sparsity patterns of M and A
+ *
+ * \param ts            block Timestepping struct
+ * \param c             Coefficient of A (e.g. dt for Backward Euler, 0.5*dt for Crank-Nicolson)
+ *
+ * \return ts.At        Time operator (no boundary conditions eliminated)
+ *
+ * \note Block version of update_timeoperator: the pattern of every block and the
+ *       positions of the entries of M and A in it are kept in ts->M_to_At and
+ *       ts->A_to_At. Blocks that are NULL in both M and A are NULL in At (as in bdcsr_add).
+ *
+ */
+void update_blktimeoperator(block_timestepper *ts,REAL c)
+{
+  block_dCSRmat *M=ts->M, *A=ts->A, *At=ts->At;
+  INT k, nb=At->brow*At->bcol;
+  SHORT rebuilt=0;
+
+  if(!ts->M_to_At) {
+    ts->M_to_At=calloc(nb,sizeof(struct ivector));
+    ts->A_to_At=calloc(nb,sizeof(struct ivector));
+  }
+
+  for(k=0;k<nb;k++) {
+    if(M->blocks[k]==NULL && A->blocks[k]==NULL) {
+      if(At->blocks[k]) {
+        timeop_unshare(At->blocks[k],ts->At_noBC->blocks[k]);
+        dcsr_free(At->blocks[k]);
+        free(At->blocks[k]);
+        At->blocks[k]=NULL;
+      }
+      continue;
+    }
+    if(!At->blocks[k]) At->blocks[k]=calloc(1,sizeof(struct dCSRmat));
+    if(timeop_stale(M->blocks[k],A->blocks[k],At->blocks[k],&ts->M_to_At[k],&ts->A_to_At[k])) {
+      timeop_unshare(At->blocks[k],ts->At_noBC->blocks[k]);
+      timeop_pattern(M->blocks[k],A->blocks[k],At->blocks[k],&ts->M_to_At[k],&ts->A_to_At[k]);
+      rebuilt=1;
+    }
+    timeop_values(M->blocks[k],A->blocks[k],c,At->blocks[k],&ts->M_to_At[k],&ts->A_to_At[k]);
+  }
+
+  // the Dirichlet lists refer to the old pattern
+  if(rebuilt && ts->bc_zero) {
+    for(k=0;k<nb;k++) {
+      ivec_free(&ts->bc_zero[k]);
+      ivec_free(&ts->bc_one[k]);
+    }
+  }
+
+  return;
+}
+/******************************************************************************************************/
+
+/******************************************************************************************************/
+/*!
+ * \fn void eliminate_blktimeoperator_DirichletBC(block_timestepper *ts,INT *dirichlet)
+ *
+ * \brief Eliminates the Dirichlet boundaries from the BLOCK time operator At (as in
+ *        eliminate_DirichletBC_blockFE_blockA with b=NULL) using cached lists of entries
+ *
+ * \param ts            block Timestepping struct
+ * \param dirichlet     Dirichlet flags of the DOF of all spaces (FE->dirichlet)
+ *
+ * \return ts.At        Time operator with boundaries eliminated
+ *
+ * \note The lists are computed at the first call after the pattern of At is
+ *       (re)computed and kept in ts->bc_zero and ts->bc_one.
+ *
+ */
+void eliminate_blktimeoperator_DirichletBC(block_timestepper *ts,INT *dirichlet)
+{
+  block_dCSRmat *At=ts->At;
+  INT i,j,k, nb=At->brow*At->bcol;
+  INT *rowshift=(INT *)calloc(At->brow+1,sizeof(INT));
+  INT *colshift=(INT *)calloc(At->bcol+1,sizeof(INT));
+
+  if(!ts->bc_zero) {
+    ts->bc_zero=calloc(nb,sizeof(struct ivector));
+    ts->bc_one=calloc(nb,sizeof(struct ivector));
+  }
+
+  // Find dof shifts needed for each block
+  for(i=0;i<At->brow;i++) {
+    for(j=0;j<At->bcol;j++) {
+      if(At->blocks[i*At->bcol+j]) {
+        rowshift[i+1]=At->blocks[i*At->bcol+j]->row;
+        colshift[j+1]=At->blocks[i*At->bcol+j]->col;
+      }
+    }
+  }
+  for(i=0;i<At->brow;i++) rowshift[i+1]+=rowshift[i];
+  for(j=0;j<At->bcol;j++) colshift[j+1]+=colshift[j];
+
+  for(i=0;i<At->brow;i++) {
+    for(j=0;j<At->bcol;j++) {
+      k=i*At->bcol+j;
+      if(!At->blocks[k]) continue;
+      if(!ts->bc_zero[k].val)
+        timeop_bc_lists(At->blocks[k],dirichlet,rowshift[i],colshift[j],(i==j),&ts->bc_zero[k],&ts->bc_one[k]);
+      timeop_bc_apply(At->blocks[k],&ts->bc_zero[k],&ts->bc_one[k]);
+    }
+  }
+
+  free(rowshift);
+  free(colshift);
   return;
 }
 /******************************************************************************************************/
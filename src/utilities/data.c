@@ -105,6 +105,7 @@ void amg_data_free(AMG_data *mgl,
         dcsr_free(&mgl[i].P);
         dcsr_free(&mgl[i].R);
         dcsr_free(&mgl[i].M);
+        dsell_free(&mgl[i].As);
         dvec_free(&mgl[i].b);
         dvec_free(&mgl[i].x);
         dvec_free(&mgl[i].w);
@@ -129,6 +130,9 @@ void amg_data_free(AMG_data *mgl,
 	  break;
         }
 	  //#endif
+        case SOLVER_AUTO:
+            amg_coarse_free(&(mgl[max_levels-1].Numeric));
+            break;
 
         default: // Do nothing!
             break;
@@ -0,0 +1,127 @@
+/*! \file src/utilities/dbsr_block.inl
+ *
+ *  \brief Small dense block kernels with compile-time block size used by
+ *         the dBSRmat routines (sparse.c, smoother.c).
+ *
+ *  \note  DBSR_BLOCK_KERNELS(NB) generates static inline kernels for
+ *         NB x NB row-major blocks. With NB a constant the compiler fully
+ *         unrolls the loops and keeps the block in registers. The block
+ *         sizes that get specialized are listed in DBSR_FOR_EACH_NB; all
+ *         other nb go through the generic ddense_* routines.
+ *
+ */
+
+#define DBSR_FOR_EACH_NB(F) F(2) F(3) F(4) F(6) F(7)
+
+/* OpenMP pragma inside the kernel generating macros (empty without OpenMP) */
+#if defined(_OPENMP)
+#define DBSR_OMP(x) _Pragma(#x)
+#else
+#define DBSR_OMP(x)
+#endif
+
+#define DBSR_BLOCK_KERNELS(NB)                                          \
+/* y := y + A*x */                                                      \
+static inline void dbsr_blk_ypAx_##NB(const REAL *A,                    \
+                                      const REAL *x,                    \
+                                      REAL *y)                          \
+{                                                                       \
+    INT i,j;                                                            \
+    REAL s;                                                             \
+    for ( i = 0; i < NB; ++i ) {                                        \
+        for ( s = y[i], j = 0; j < NB; ++j ) s += A[i*NB+j]*x[j];       \
+        y[i] = s;                                                       \
+    }                                                                   \
+}                                                                       \
+/* y := y - A*x */                                                      \
+static inline void dbsr_blk_ymAx_##NB(const REAL *A,                    \
+                                      const REAL *x,                    \
+                                      REAL *y)                          \
+{                                                                       \
+    INT i,j;                                                            \
+    REAL s;                                                             \
+    for ( i = 0; i < NB; ++i ) {                                        \
+        for ( s = y[i], j = 0; j < NB; ++j ) s -= A[i*NB+j]*x[j];       \
+        y[i] = s;                                                       \
+    }                                                                   \
+}                                                                       \
+/* y := A*x */                                                          \
+static inline void dbsr_blk_mxv_##NB(const REAL *A,                     \
+                                     const REAL *x,                     \
+                                     REAL *y)                           \
+{                                                                       \
+    INT i,j;                                                            \
+    REAL s;                                                             \
+    for ( i = 0; i < NB; ++i ) {                                        \
+        for ( s = 0.0, j = 0; j < NB; ++j ) s += A[i*NB+j]*x[j];        \
+        y[i] = s;                                                       \
+    }                                                                   \
+}                                                                       \
+/* C := A*B */                                                          \
+static inline void dbsr_blk_mul_##NB(const REAL *A,                     \
+                                     const REAL *B,                     \
+                                     REAL *C)                           \
+{                                                                       \
+    INT i,j,k;                                                          \
+    REAL c[NB];                                                         \
+    for ( i = 0; i < NB; ++i ) {                                        \
+        for ( j = 0; j < NB; ++j ) c[j] = 0.0;                          \
+        for ( k = 0; k < NB; ++k )                                      \
+            for ( j = 0; j < NB; ++j ) c[j] += A[i*NB+k]*B[k*NB+j];     \
+        for ( j = 0; j < NB; ++j ) C[i*NB+j] = c[j];                    \
+    }                                                                   \
+}                                                                       \
+/* C := C + A*B */                                                      \
+static inline void dbsr_blk_mul_add_##NB(const REAL *A,                 \
+                                         const REAL *B,                 \
+                                         REAL *C)                       \
+{                                                                       \
+    INT i,j,k;                                                          \
+    for ( i = 0; i < NB; ++i )                                          \
+        for ( k = 0; k < NB; ++k )                                      \
+            for ( j = 0; j < NB; ++j ) C[i*NB+j] += A[i*NB+k]*B[k*NB+j]; \
+}
+
+DBSR_FOR_EACH_NB(DBSR_BLOCK_KERNELS)
+
+/**
+ * \fn static inline void dbsr_blk_mul (const REAL *A, const REAL *B,
+ *                                      REAL *C, const INT nb)
+ *
+ * \brief C := A*B for nb x nb blocks, dispatched on nb
+ */
+static inline void dbsr_blk_mul(const REAL *A,
+                                const REAL *B,
+                                REAL *C,
+                                const INT nb)
+{
+#define DBSR_CASE_MUL(NB) case NB: dbsr_blk_mul_##NB(A,B,C); return;
+    switch ( nb ) {
+        DBSR_FOR_EACH_NB(DBSR_CASE_MUL)
+        default: ddense_mul(A,B,C,nb); return;
+    }
+#undef DBSR_CASE_MUL
+}
+
+/**
+ * \fn static inline void dbsr_blk_mul_add (const REAL *A, const REAL *B,
+ *                                          REAL *C, REAL *work, const INT nb)
+ *
+ * \brief C := C + A*B for nb x nb blocks, dispatched on nb (work: nb*nb)
+ */
+static inline void dbsr_blk_mul_add(const REAL *A,
+                                    const REAL *B,
+                                    REAL *C,
+                                    REAL *work,
+                                    const INT nb)
+{
+#define DBSR_CASE_MUL_ADD(NB) case NB: dbsr_blk_mul_add_##NB(A,B,C); return;
+    switch ( nb ) {
+        DBSR_FOR_EACH_NB(DBSR_CASE_MUL_ADD)
+        default:
+            ddense_mul(A,B,work,nb);
+            array_axpy(nb*nb,1.0,work,C);
+            return;
+    }
+#undef DBSR_CASE_MUL_ADD
+}
@@ -239,6 +239,218 @@ void find_det_4( REAL* A, REAL* deta)
 
 }
 
+/*********************************************************************
+ *
+ *  blocked matrix-matrix product (abybfull, ddense_mul, LU)
+ *
+ **********************************************************************/
+/* c[i][jc+j] += alpha*(a*b)[i][j], i<mr, j<nr, from the packed strips
+   a (kc x DENSE_MR) and b (kc x DENSE_NR) */
+static inline void ddense_gemm_micro(const INT kc,
+                                     const REAL alpha,
+                                     const REAL *a,
+                                     const REAL *b,
+                                     REAL **c,
+                                     const INT jc,
+                                     const INT mr,
+                                     const INT nr)
+{
+  INT l,i,j;
+  REAL acc[DENSE_MR][DENSE_NR];
+  for(i=0;i<DENSE_MR;i++)
+    for(j=0;j<DENSE_NR;j++) acc[i][j] = 0.0;
+  for(l=0;l<kc;l++,a+=DENSE_MR,b+=DENSE_NR)
+    for(i=0;i<DENSE_MR;i++)
+      for(j=0;j<DENSE_NR;j++) acc[i][j] += a[i]*b[j];
+  for(i=0;i<mr;i++)
+    for(j=0;j<nr;j++) c[i][jc+j] += alpha*acc[i][j];
+}
+
+/* C += alpha*A*B, A m x k, B k x n, given by pointers to their rows:
+   a[i] (k entries), b[l] (n entries), c[i] (n entries). The product is
+   tiled for the caches (DENSE_MC x DENSE_KC blocks of A, DENSE_KC x
+   DENSE_NC blocks of B, both packed) and for the registers
+   (DENSE_MR x DENSE_NR) */
+static void ddense_gemm_rows(const INT m,
+                             const INT n,
+                             const INT k,
+                             const REAL alpha,
+                             REAL **a,
+                             REAL **b,
+                             REAL **c)
+{
+  INT jc,pc,ic,jr,ir,nc,kc,mc,nr,mr,i,j,l;
+  REAL *ap, *bp;
+  const REAL *x;
+  REAL *apack=(REAL *)malloc((DENSE_MC+DENSE_MR)*DENSE_KC*sizeof(REAL));
+  REAL *bpack=(REAL *)malloc((DENSE_NC+DENSE_NR)*DENSE_KC*sizeof(REAL));
+  for(jc=0;jc<n;jc+=DENSE_NC){
+    nc=MIN(DENSE_NC,n-jc);
+    for(pc=0;pc<k;pc+=DENSE_KC){
+      kc=MIN(DENSE_KC,k-pc);
+      // pack B(pc:pc+kc,jc:jc+nc) in strips of DENSE_NR columns
+      for(jr=0;jr<nc;jr+=DENSE_NR){
+	nr=MIN(DENSE_NR,nc-jr);
+	bp=bpack+jr*kc;
+	for(l=0;l<kc;l++,bp+=DENSE_NR){
+	  x=b[pc+l]+jc+jr;
+	  for(j=0;j<nr;j++) bp[j]=x[j];
+	  for(;j<DENSE_NR;j++) bp[j]=0.;
+	}
+      }
+      for(ic=0;ic<m;ic+=DENSE_MC){
+	mc=MIN(DENSE_MC,m-ic);
+	// pack A(ic:ic+mc,pc:pc+kc) in strips of DENSE_MR rows
+	for(ir=0;ir<mc;ir+=DENSE_MR){
+	  mr=MIN(DENSE_MR,mc-ir);
+	  ap=apack+ir*kc;
+	  for(i=0;i<mr;i++){
+	    x=a[ic+ir+i]+pc;
+	    for(l=0;l<kc;l++) ap[l*DENSE_MR+i]=x[l];
+	  }
+	  for(;i<DENSE_MR;i++)
+	    for(l=0;l<kc;l++) ap[l*DENSE_MR+i]=0.;
+	}
+	for(jr=0;jr<nc;jr+=DENSE_NR){
+	  nr=MIN(DENSE_NR,nc-jr);
+	  for(ir=0;ir<mc;ir+=DENSE_MR){
+	    mr=MIN(DENSE_MR,mc-ir);
+	    ddense_gemm_micro(kc,alpha,apack+ir*kc,bpack+jr*kc,c+ic+ir,jc+jr,mr,nr);
+	  }
+	}
+      }
+    }
+  }
+  free(apack);
+  free(bpack);
+}
+
+/**************************************************************************/
+/*!
+ * \fn void ddense_gemm(const INT m, const INT n, const INT k, const REAL alpha,
+ *                      const REAL *A, const INT lda, const REAL *B, const INT ldb,
+ *                      REAL *C, const INT ldc)
+ *
+ * \brief Computes C = C + alpha*A*B for matrices stored by rows
+ *
+ * \param m      number of rows of A and C
+ * \param n      number of columns of B and C
+ * \param k      number of columns of A and rows of B
+ * \param alpha  scalar
+ * \param A      m by k matrix, row i starts at A+i*lda
+ * \param B      k by n matrix, row i starts at B+i*ldb
+ * \param C      m by n matrix, row i starts at C+i*ldc
+ *
+ * \note Calls dgemm if BLAS is available; otherwise a cache and
+ *       register blocked kernel (plain loops for small products).
+ *
+ */
+void ddense_gemm(const INT m,
+		 const INT n,
+		 const INT k,
+		 const REAL alpha,
+		 const REAL *A,
+		 const INT lda,
+		 const REAL *B,
+		 const INT ldb,
+		 REAL *C,
+		 const INT ldc)
+{
+  INT i,l,j;
+  if(m<=0 || n<=0 || k<=0) return;
+#if WITH_BLAS
+  {
+    // by rows C=A*B is by columns C^T=B^T*A^T
+    char tr='N';
+    INT mm=m,nn=n,kk=k,la=lda,lb=ldb,lc=ldc;
+    REAL al=alpha,one=1.;
+    dgemm_(&tr,&tr,&nn,&mm,&kk,&al,(REAL *)B,&lb,(REAL *)A,&la,&one,C,&lc);
+    return;
+  }
+#endif
+  if((REAL )m*n*k<=DENSE_SMALL){
+    REAL ail;
+    for(i=0;i<m;i++){
+      for(l=0;l<k;l++){
+	ail=alpha*A[i*lda+l];
+	for(j=0;j<n;j++) C[i*ldc+j]+=ail*B[l*ldb+j];
+      }
+    }
+    return;
+  }
+  REAL **rows=(REAL **)malloc((2*m+k)*sizeof(REAL *));
+  for(i=0;i<m;i++){
+    rows[i]=(REAL *)A+i*lda;
+    rows[m+k+i]=C+i*ldc;
+  }
+  for(l=0;l<k;l++) rows[m+l]=(REAL *)B+l*ldb;
+  ddense_gemm_rows(m,n,k,alpha,rows,rows+m,rows+m+k);
+  free(rows);
+  return;
+}
+
+/* Elimination part of the LU decomposition with scaled partial pivoting
+   (piv holds the inverse row scales). The rows stay in place and p[]
+   is the pivoting order. Right looking and blocked: a panel of
+   DENSE_LU_NB columns is factored, then the rows of U to its right are
+   computed and the trailing matrix is updated with one product.
+   Returns 2 if a pivot is smaller than tol. */
+static SHORT ddense_lu_factor(const INT n,
+			      REAL *A,
+			      INT *p,
+			      const REAL *piv,
+			      const REAL tol)
+{
+  const INT nm1=n-1;
+  INT k0,ke,k,i,j,kp,kswp;
+  REAL r,t,akk,lik,*ai,*ak;
+  REAL **rows=NULL;
+  if(n>DENSE_LU_NB) rows=(REAL **)malloc((2*n+DENSE_LU_NB)*sizeof(REAL *));
+  for(k0=0;k0<nm1;k0+=DENSE_LU_NB){
+    ke=MIN(n,k0+DENSE_LU_NB);
+    // panel: columns k0..ke-1
+    for(k=k0;k<MIN(ke,nm1);k++){
+      r=fabs(A[p[k]*n+k])*piv[p[k]];
+      kp=k;
+      for(i=k;i<n;i++){
+	t=fabs(A[p[i]*n+k])*piv[p[i]];
+	if(t>r){r=t; kp=i;}
+      }
+      kswp=p[kp]; p[kp]=p[k]; p[k]=kswp;
+      ak=A+p[k]*n;
+      akk=ak[k];
+      if(fabs(akk)<tol){
+	if(rows) free(rows);
+	return (SHORT )2;
+      }
+      for(i=k+1;i<n;i++){
+	ai=A+p[i]*n;
+	lik=ai[k]=ai[k]/akk;
+	for(j=k+1;j<ke;j++) ai[j]-=lik*ak[j];
+      }
+    }
+    if(ke>=n) break;
+    // rows of U to the right of the panel
+    for(k=k0;k<ke;k++){
+      ak=A+p[k]*n;
+      for(i=k+1;i<ke;i++){
+	ai=A+p[i]*n;
+	lik=ai[k];
+	for(j=ke;j<n;j++) ai[j]-=lik*ak[j];
+      }
+    }
+    // trailing matrix: A22 = A22 - L21*U12
+    for(i=ke;i<n;i++){
+      rows[i-ke]=A+p[i]*n+k0;
+      rows[n+DENSE_LU_NB+i-ke]=A+p[i]*n+ke;
+    }
+    for(k=k0;k<ke;k++) rows[n+k-k0]=A+p[k]*n+ke;
+    ddense_gemm_rows(n-ke,n-ke,ke-k0,-1.,rows,rows+n,rows+n+DENSE_LU_NB);
+  }
+  if(rows) free(rows);
+  return (SHORT )0;
+}
+
 /*********************************************************************
  *
  *  other dense matrix routines
@@ -266,8 +478,8 @@ void find_det_4( REAL* A, REAL* deta)
  */
 INT ddense_solve_pivot(INT dopivot, INT n, REAL *A, REAL *b, INT *p,REAL *piv)
 {
-  INT nm1,i1,k1,pin,kswp,kp,i,j,k;
-  REAL r,t,absaij;
+  INT nm1,i1,pin,i,j,k;
+  REAL absaij;
   REAL *x=piv;
   if(dopivot) {
     for (i=0;i<n;i++){
@@ -280,24 +492,7 @@ INT ddense_solve_pivot(INT dopivot, INT n, REAL *A, REAL *b, INT *p,REAL *piv)
       }
       piv[i]=1./piv[i]; //here we need error stop if too small
     }
-    nm1 = n-1;
-    for (k = 0;k<nm1;k++){
-      r = fabs(A[p[k]*n+k])*piv[p[k]];
-      kp = k;
-      for (i=k;i<n;i++){
-	t = fabs(A[p[i]*n+k])*piv[p[i]];
-	if (t > r){r = t; kp = i;}
-      }
-      kswp = p[kp]; p[kp] = p[k]; p[k] = kswp;
-      k1 = k+1;
-      for (i = k1;i<n;i++){
-	pin=p[i]*n;
-	A[pin+k] = A[pin+k]/A[p[k]*n+k];
-	for(j = k1;j<n;j++){
-	  A[pin+j] = A[pin+j]-A[pin+k]*A[p[k]*n+j];
-	}
-      }
-    }
+    ddense_lu_factor(n,A,p,piv,0.);
     /*end of decomposition; now solver part*/
   }
   x[0] = b[p[0]];
@@ -341,8 +536,8 @@ INT ddense_solve_pivot(INT dopivot, INT n, REAL *A, REAL *b, INT *p,REAL *piv)
 SHORT ddense_lu(INT dopivot, INT n, REAL *deta, REAL *A,INT *p,REAL *piv)
 {
   // return 0 if all is OK and returns 1 or 2 if there is a division by a very small number...<tol
-  INT nm1,i1,k1,pin,kswp,kp,i,j,k;
-  REAL det0,r,t,absaij,tol=1e-10;
+  INT nm1,i1,pin,i,j;
+  REAL det0,absaij,tol=1e-10;
   if(dopivot){
     for (i=0;i<n;i++){
       p[i]=i;
@@ -357,27 +552,9 @@ SHORT ddense_lu(INT dopivot, INT n, REAL *deta, REAL *A,INT *p,REAL *piv)
       piv[i]=1./piv[i]; //here we need error stop if too small
       //       fprintf(stderr,"\n*** i=%i; pivot=%g\n",i,piv[i]);
     }
-    nm1 = n-1;
-    for (k = 0;k<nm1;k++){
-      r = fabs(A[p[k]*n+k])*piv[p[k]];
-      kp = k;
-      for (i=k;i<n;i++){
- 	t = fabs(A[p[i]*n+k])*piv[p[i]];
- 	if (t > r){r = t; kp = i;}
-      }
-      kswp = p[kp]; p[kp] = p[k]; p[k] = kswp;
-      k1 = k+1;
-      for (i = k1;i<n;i++){
- 	pin=p[i]*n;
-	if(fabs(A[p[k]*n+k])<tol) {
-	  *deta=0e0;
-	  return (SHORT )2;
-	}
-	A[pin+k] = A[pin+k]/A[p[k]*n+k];
-	for(j = k1;j<n;j++){
-	  A[pin+j] = A[pin+j]-A[pin+k]*A[p[k]*n+j];
-	}
-      }
+    if(ddense_lu_factor(n,A,p,piv,tol)) {
+      *deta=0e0;
+      return (SHORT )2;
     }
   }
   nm1=n-1;
@@ -485,22 +662,7 @@ void abybfull(const INT m, const INT p, REAL *c,	\
 	      REAL *a, REAL *b, const INT n)
 {
   /* matrices c = a*b+c; a is m by n, b is n by p; c is m by p */
-  REAL cij;
-  INT i,j,k,ij,ik,kj,in,ip;
-  for(i=0;i<m;i++){
-    in=i*n;
-    ip=i*p;
-    for(j=0;j<p;j++){
-      cij=0.;
-      for(k=0;k<n;k++){
-	ik=in + k;
-	kj=k*p + j;
-	cij+=a[ik]*b[kj];
-      }
-      ij=ip+j;
-      c[ij]+=cij;
-    }
-  }
+  ddense_gemm(m,p,n,1.,a,n,b,p,c,p);
   return;
 }
 /**************************************************************************/
@@ -567,47 +729,72 @@ void ddense_atbyv(const INT m, REAL *y,REAL *a, REAL *x, const INT n)
  *
  * \return Q    orthogonal full matrix from QR decomposition
  * \return R    upper triangular matrix from QR decomposition
+ *
+ * \note A and Q are stored by columns, R by rows. Calls LAPACK
+ *       (dgeqrf/dorgqr) if available.
  */
 void ddense_qr(const INT m, const INT n, REAL *A, REAL *Q, REAL *R)
 {
-
   // local variables
   INT i,j;
-  REAL *qj = (REAL *)calloc(m, sizeof(REAL));
-  REAL *aj;
+#if WITH_LAPACK
+  INT mm=m,nn=n,lda=m,lwork=-1,info;
+  REAL workopt, *work;
+  REAL *tau = (REAL *)calloc(n, sizeof(REAL));
+
+  // A is stored by columns, as LAPACK wants it
+  array_cp(m*n, A, Q);
+  dgeqrf_(&mm,&nn,Q,&lda,tau,&workopt,&lwork,&info);
+  lwork = (INT) workopt;
+  work = (REAL *)calloc(lwork, sizeof(REAL));
+  dgeqrf_(&mm,&nn,Q,&lda,tau,work,&lwork,&info);
+  for (j=0; j<n; j++)
+    for (i=0; i<=j; i++) R[i*n+j] = Q[j*m+i];
+  dorgqr_(&mm,&nn,&nn,Q,&lda,tau,work,&lwork,&info);
+
+  // same signs as Gram-Schmidt: positive diagonal of R
+  for (j=0; j<n; j++) {
+    if (R[j*n+j] < 0.0) {
+      for (i=j; i<n; i++) R[j*n+i] = -R[j*n+i];
+      array_ax(m, -1.0, &Q[j*m]);
+    }
+  }
+  free(work);
+  free(tau);
+#else
+  // modified Gram-Schmidt; the dot products use DENSE_NR independent
+  // partial sums so that they vectorize
+  INT l,u;
+  REAL rij, acc[DENSE_NR], *qi, *qj;
 
   // main loop
   for (j=0; j<n; j++)
   {
-
       // qj = aj
-      aj = &A[j*m];
-      array_cp(m, aj, qj);
+      qj = &Q[j*m];
+      array_cp(m, &A[j*m], qj);
 
       // inner loop
       for (i=0; i<j; i++)
       {
-
-        // rij = qi'*qj
-        R[i*n+j] = array_dotprod(m, &Q[i*m], qj);
-
-        // qj = qj - rij*qi
-        array_axpy(m, -R[i*n+j], &Q[i*m], qj);
-
+          // rij = qi'*qj
+          qi = &Q[i*m];
+          for (u=0; u<DENSE_NR; u++) acc[u] = 0.0;
+          for (l=0; l+DENSE_NR<=m; l+=DENSE_NR)
+              for (u=0; u<DENSE_NR; u++) acc[u] += qi[l+u]*qj[l+u];
+          for (rij=0.0; l<m; l++) rij += qi[l]*qj[l];
+          for (u=0; u<DENSE_NR; u++) rij += acc[u];
+          R[i*n+j] = rij;
+
+          // qj = qj - rij*qi
+          for (l=0; l<m; l++) qj[l] -= rij*qi[l];
       }
 
-      // rjj = ||qj||_2
+      // rjj = ||qj||_2, qj = qj/rjj
       R[j*n+j] = array_norm2(m, qj);
-
-      // qj = qj/rjj
-      array_cp(m, qj, &Q[j*m]);
-      array_ax(m, 1./R[j*n+j], &Q[j*m]);
-
+      array_ax(m, 1./R[j*n+j], qj);
   }
-
-  // free
-  free (qj);
-
+#endif
 }
 
 /**************************************************************************/
@@ -1073,16 +1260,10 @@ void ddense_mul (const REAL  *a,
                  const INT    n)
 {
     const INT n2 = n*n;
-    INT i,j,k;
-    REAL temp;
+    INT i;
 
-    for (i=0; i<n2; i+=n) {
-        for (j=0; j<n; ++j) {
-            temp = 0.0;
-            for (k=0; k<n; ++k) temp += a[i+k]*b[k*n+j];
-            c[i+j] = temp;
-        } // end for j
-    } // end for i
+    for (i=0; i<n2; ++i) c[i] = 0.0;
+    ddense_gemm(n, n, n, 1.0, a, n, b, n, c, n);
 
     return;
 }
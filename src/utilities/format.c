@@ -770,6 +770,192 @@ dBSRmat dcsr_2_dbsr(const dCSRmat  *A,
     return B;
 }
 
+/*!
+ * \fn dSELLmat dcsr_2_dsell (const dCSRmat *A, const INT C, const INT sigma)
+ *
+ * \brief Transfer a dCSRmat type matrix into SELL-C-sigma format
+ *
+ * \param A      Pointer to the dCSRmat type matrix
+ * \param C      Chunk height (<=0: SELL_CHUNK, the SIMD width)
+ * \param sigma  Sorting window in rows, rounded up to a multiple of C
+ *               (<=0: SELL_SIGMA); rows are not sorted if sigma<=C
+ *
+ * \return       dSELLmat matrix
+ *
+ * \note Rows are sorted by decreasing length within each window with a
+ *       counting sort; rows of equal length keep their order.
+ *
+ */
+dSELLmat dcsr_2_dsell(const dCSRmat *A,
+                      const INT C,
+                      const INT sigma)
+{
+    const INT m = A->row;
+    const INT *IA = A->IA, *JA = A->JA;
+    const REAL *val = A->val;
+
+    INT i, j, k, c, r, w0, w1, len, maxlen, pos;
+    INT *count;
+    dSELLmat B;
+
+    B.row = m; B.col = A->col; B.nnz = A->nnz;
+    B.C = (C > 0) ? MIN(C, SELL_MAX_CHUNK) : SELL_CHUNK;
+    B.sigma = (sigma > 0) ? sigma : SELL_SIGMA;
+    B.sigma = MAX(B.C, (B.sigma+B.C-1)/B.C*B.C);
+    B.nchunks = (m+B.C-1)/B.C;
+
+    B.cs   = (INT *)calloc(B.nchunks+1, sizeof(INT));
+    B.cl   = (INT *)calloc(MAX(B.nchunks,1), sizeof(INT));
+    B.perm = (INT *)calloc(MAX(B.nchunks*B.C,1), sizeof(INT));
+    iarray_set(B.nchunks*B.C, B.perm, -1);
+
+    maxlen = 0;
+    for ( i = 0; i < m; ++i ) maxlen = MAX(maxlen, IA[i+1]-IA[i]);
+    count = (INT *)calloc(maxlen+2, sizeof(INT));
+
+    // sort rows by decreasing length within each sigma window
+    for ( w0 = 0; w0 < m; w0 += B.sigma ) {
+        w1 = MIN(w0+B.sigma, m);
+        if ( B.sigma <= B.C ) {
+            for ( i = w0; i < w1; ++i ) B.perm[i] = i;
+            continue;
+        }
+        iarray_set(maxlen+2, count, 0);
+        for ( i = w0; i < w1; ++i ) count[maxlen-(IA[i+1]-IA[i])+1]++;
+        for ( k = 1; k <= maxlen+1; ++k ) count[k] += count[k-1];
+        for ( i = w0; i < w1; ++i ) B.perm[w0+count[maxlen-(IA[i+1]-IA[i])]++] = i;
+    }
+    free(count);
+
+    // chunk widths and starts
+    for ( c = 0; c < B.nchunks; ++c ) {
+        len = 0;
+        for ( r = 0; r < B.C; ++r ) {
+            i = B.perm[c*B.C+r];
+            if ( i >= 0 ) len = MAX(len, IA[i+1]-IA[i]);
+        }
+        B.cl[c] = len;
+        B.cs[c+1] = B.cs[c] + len*B.C;
+    }
+
+    B.JA  = (INT *)calloc(MAX(B.cs[B.nchunks],1), sizeof(INT));
+    B.val = (REAL *)calloc(MAX(B.cs[B.nchunks],1), sizeof(REAL));
+
+    // fill column-wise; padding repeats the last column of the row (or 0)
+    for ( c = 0; c < B.nchunks; ++c ) {
+        for ( r = 0; r < B.C; ++r ) {
+            i = B.perm[c*B.C+r];
+            len = (i >= 0) ? IA[i+1]-IA[i] : 0;
+            for ( j = 0; j < B.cl[c]; ++j ) {
+                pos = B.cs[c] + j*B.C + r;
+                if ( j < len ) {
+                    B.JA[pos]  = JA[IA[i]+j];
+                    B.val[pos] = val[IA[i]+j];
+                }
+                else {
+                    B.JA[pos]  = (len > 0) ? JA[IA[i]+len-1] : 0;
+                }
+            }
+        }
+    }
+
+    return B;
+}
+
+/*!
+ * \fn static REAL dcsr_block_fill (const dCSRmat *A, const INT nb,
+ *                                  const SHORT cmajor, INT *mark)
+ *
+ * \brief Fill ratio nb*nb*nnz(B)/nnz(A) of the BSR form B of A with nb x nb
+ *        blocks, for node-major (dof = node*nb+c, cmajor=0) or
+ *        component-major (dof = c*nnode+node, cmajor=1) numbering
+ *
+ * \param mark  work array of size A->row/nb
+ *
+ */
+static REAL dcsr_block_fill(const dCSRmat *A,
+                            const INT nb,
+                            const SHORT cmajor,
+                            INT *mark)
+{
+    const INT nn = A->row/nb;
+    INT I, J, c, r, k;
+    REAL nnzb = 0.0;
+
+    iarray_set(nn, mark, -1);
+    for (I=0; I<nn; ++I) {
+        for (c=0; c<nb; ++c) {
+            r = cmajor ? c*nn+I : I*nb+c;
+            for (k=A->IA[r]; k<A->IA[r+1]; ++k) {
+                J = cmajor ? A->JA[k]%nn : A->JA[k]/nb;
+                if (mark[J]!=I) { mark[J] = I; nnzb += 1.0; }
+            }
+        }
+    }
+
+    return nnzb*nb*nb/(REAL )MAX(A->nnz,1);
+}
+
+/*!
+ * \fn INT dcsr_detect_block (const dCSRmat *A, const INT nb_in, ivector *perm)
+ *
+ * \brief Detect the natural block size of A (e.g. vector valued problems)
+ *        and whether its unknowns are numbered node-major or
+ *        component-major
+ *
+ * \param A      Pointer to the dCSRmat matrix
+ * \param nb_in  Block size to check (e.g. from the fespace); if nb_in<=1 all
+ *               block sizes 2,...,MAX_BLOCK_NB are tried
+ * \param perm   Permutation to node-major numbering (OUTPUT): row i of the
+ *               node-major matrix is row perm->val[i] of A; perm->row=0 if A
+ *               is already node-major
+ *
+ * \return       Block size nb (1 if A has no block structure)
+ *
+ * \note A block size is accepted if the BSR form stores less than
+ *       MAX_BLOCK_FILL times the nonzeros of A; the one with the smallest
+ *       fill wins (the larger nb on ties).
+ *
+ */
+INT dcsr_detect_block(const dCSRmat *A,
+                      const INT nb_in,
+                      ivector *perm)
+{
+    const INT n = A->row;
+    INT nb, nb0, nb1, best_nb = 1, i, c, nn;
+    SHORT cmajor, best_cm = 0;
+    REAL fill, best_fill = MAX_BLOCK_FILL;
+    INT *mark;
+
+    perm->row = 0; perm->val = NULL;
+    if ( (A->row != A->col) || (n < 2) ) return 1;
+
+    if (nb_in > 1) { nb0 = nb1 = nb_in; }
+    else { nb0 = 2; nb1 = MAX_BLOCK_NB; }
+
+    mark = (INT *)calloc(n/nb0+1, sizeof(INT));
+    for (nb=nb0; nb<=nb1; ++nb) {
+        if (n%nb) continue;
+        for (cmajor=0; cmajor<2; ++cmajor) {
+            fill = dcsr_block_fill(A, nb, cmajor, mark);
+            if ( (fill < 0.99*best_fill) ||
+                 ((best_nb > 1) && (fill < 1.01*best_fill)) ) {
+                best_fill = fill; best_nb = nb; best_cm = cmajor;
+            }
+        }
+    }
+    free(mark);
+
+    if ( (best_nb > 1) && best_cm ) {
+        nn = n/best_nb;
+        *perm = ivec_create(n);
+        for (i=0; i<nn; ++i)
+            for (c=0; c<best_nb; ++c) perm->val[i*best_nb+c] = c*nn+i;
+    }
+
+    return best_nb;
+}
+
 /***********************************************************************************************/
 /*!
  * \fn dCSRmat *dcoo_2_dcsr_p(dCOOmat *A)
@@ -315,6 +315,28 @@ void param_input (const char *filenm,		\
             fgets(buffer,maxb,fp); // skip rest of line
         }
 
+        else if (strcmp(buffer,"nonlinear_itsolver_forcing")==0) {
+            val = fscanf(fp,"%s",buffer);
+            if (val!=1 || strcmp(buffer,"=")!=0) {
+                status = ERROR_INPUT_PAR; break;
+            }
+            val = fscanf(fp,"%lld",&long_ibuff); ibuff=(INT )long_ibuff;
+            if (val!=1) { status = ERROR_INPUT_PAR; break; }
+            inparam->nonlinear_itsolver_forcing = ibuff;
+            fgets(buffer,maxb,fp); // skip rest of line
+        }
+
+        else if (strcmp(buffer,"nonlinear_itsolver_pc_lag")==0) {
+            val = fscanf(fp,"%s",buffer);
+            if (val!=1 || strcmp(buffer,"=")!=0) {
+                status = ERROR_INPUT_PAR; break;
+            }
+            val = fscanf(fp,"%lld",&long_ibuff); ibuff=(INT )long_ibuff;
+            if (val!=1) { status = ERROR_INPUT_PAR; break; }
+            inparam->nonlinear_itsolver_pc_lag = ibuff;
+            fgets(buffer,maxb,fp); // skip rest of line
+        }
+
         else if (strcmp(buffer,"fas_presmoothers")==0) {
             val = fscanf(fp,"%s",buffer);
             if (val!=1 || strcmp(buffer,"=")!=0) {
@@ -655,6 +677,17 @@ void param_input (const char *filenm,		\
             fgets(buffer,maxb,fp); // skip rest of line
         }
 
+        else if (strcmp(buffer,"AMG_sell_chunk")==0) {
+            val = fscanf(fp,"%s",buffer);
+            if (val!=1 || strcmp(buffer,"=")!=0) {
+                status = ERROR_INPUT_PAR; break;
+            }
+            val = fscanf(fp,"%lld",&long_ibuff); ibuff=(INT )long_ibuff;
+            if (val!=1) { status = ERROR_INPUT_PAR; break; }
+            inparam->AMG_sell_chunk = ibuff;
+            fgets(buffer,maxb,fp); // skip rest of line
+        }
+
         else if (strcmp(buffer,"AMG_fpwr")==0) {
             val = fscanf(fp,"%s",buffer);
             if (val!=1 || strcmp(buffer,"=")!=0) {
@@ -699,6 +732,17 @@ void param_input (const char *filenm,		\
             fgets(buffer,maxb,fp); // skip rest of line
         }
 
+        else if (strcmp(buffer,"AMG_aggressive_levels")==0) {
+            val = fscanf(fp,"%s",buffer);
+            if (val!=1 || strcmp(buffer,"=")!=0) {
+                status = ERROR_INPUT_PAR; break;
+            }
+            val = fscanf(fp,"%lld",&long_ibuff); ibuff=(INT )long_ibuff;
+            if (val!=1) { status = ERROR_INPUT_PAR; break; }
+            inparam->AMG_aggressive_levels = ibuff;
+            fgets(buffer,maxb,fp); // skip rest of line
+        }
+
         //-------------------
         // SA AMG
         //-------------------
@@ -713,6 +757,17 @@ void param_input (const char *filenm,		\
            fgets(buffer,500,fp); // skip rest of line
        }
 
+       else if (strcmp(buffer,"AMG_smooth_drop_tol")==0) {
+           val = fscanf(fp,"%s",buffer);
+           if (val!=1 || strcmp(buffer,"=")!=0) {
+               status = ERROR_INPUT_PAR; break;
+           }
+           val = fscanf(fp,"%lf",&dbuff);
+           if (val!=1) { status = ERROR_INPUT_PAR; break; }
+           inparam->AMG_smooth_drop_tol = dbuff;
+           fgets(buffer,500,fp); // skip rest of line
+       }
+
        else if (strcmp(buffer,"AMG_smooth_filter")==0) {
            val = fscanf(fp,"%s",buffer);
            if (val!=1 || strcmp(buffer,"=")!=0) {
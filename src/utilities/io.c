@@ -12,6 +12,10 @@
 
 #include "hazmath.h"
 
+#if WITH_ZLIB
+#include "zlib.h"
+#endif
+
 /*
  * \fn chkn(INT n, const INT nmin, const INT nmax)
  *
@@ -1056,6 +1060,292 @@ FILE* HAZ_fopen(char *fname, char *mode )
 }
 /****************************************************************************************/
 
+/******************************************************************************/
+/*
+ * Writer for VTK unstructured grid files shared by dump_sol_vtk,
+ * dump_sol_onV_vtk, dump_blocksol_vtk and vtkw (amr_utils.c). With
+ * VTU_RAW or VTU_BASE64 the DataArrays are written as
+ * format="appended" and their data goes, after an UInt64 size header,
+ * into the AppendedData section at the end of the file. With zlib the
+ * data is compressed in blocks of VTU_BLOCK bytes (vtkZLibDataCompressor).
+ */
+static SHORT vtu_format_default = VTU_ASCII;
+static SHORT vtu_compress_default = 0;
+
+/******************************************************************************/
+/*!
+ * \fn void vtu_set_format(const SHORT format, const SHORT compress)
+ *
+ * \brief Set the format of the vtu files written afterwards
+ *
+ * \param format    VTU_ASCII (default), VTU_RAW or VTU_BASE64
+ * \param compress  1: zlib compression of the appended data (needs
+ *                  WITH_ZLIB; ignored for VTU_ASCII)
+ *
+ */
+void vtu_set_format(const SHORT format,
+                    const SHORT compress)
+{
+  vtu_format_default = (format==VTU_RAW || format==VTU_BASE64) ? format : VTU_ASCII;
+  vtu_compress_default = (compress && vtu_format_default!=VTU_ASCII);
+#if !WITH_ZLIB
+  if(vtu_compress_default) {
+    fprintf(stderr,"%%%%%% WARNING: %s: no zlib (WITH_ZLIB=0); vtu output is not compressed\n",__FUNCTION__);
+    vtu_compress_default = 0;
+  }
+#endif
+}
+
+/* byte order of this machine as the VTK byte_order attribute */
+static const char *vtu_byte_order(void)
+{
+  const unsigned short one = 1;
+  return (*(const unsigned char *)&one) ? "LittleEndian" : "BigEndian";
+}
+
+/* base64 encoding of in[0:n-1]; returns the number of characters written to out */
+static size_t vtu_base64(const unsigned char *in,
+                         const size_t n,
+                         unsigned char *out)
+{
+  static const char tbl[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t i, k = 0;
+  unsigned long b;
+  for(i=0;i+2<n;i+=3) {
+    b = ((unsigned long)in[i]<<16) | ((unsigned long)in[i+1]<<8) | in[i+2];
+    out[k++] = tbl[(b>>18)&63]; out[k++] = tbl[(b>>12)&63];
+    out[k++] = tbl[(b>>6)&63];  out[k++] = tbl[b&63];
+  }
+  if(i<n) {
+    b = (unsigned long)in[i]<<16;
+    if(i+1<n) b |= (unsigned long)in[i+1]<<8;
+    out[k++] = tbl[(b>>18)&63]; out[k++] = tbl[(b>>12)&63];
+    out[k++] = (i+1<n) ? tbl[(b>>6)&63] : '=';
+    out[k++] = '=';
+  }
+  return k;
+}
+
+/******************************************************************************/
+/*!
+ * \fn vtu_writer *vtu_open(const char *namevtk)
+ *
+ * \brief Open a vtu file and write the VTKFile element in the format set by
+ *        vtu_set_format
+ *
+ * \param namevtk  Filename
+ *
+ * \return         Pointer to the vtu_writer; the XML inside VTKFile is
+ *                 written to its fp, the DataArrays with vtu_darray and
+ *                 vtu_iarray
+ *
+ */
+vtu_writer *vtu_open(const char *namevtk)
+{
+  vtu_writer *w = (vtu_writer *)calloc(1,sizeof(vtu_writer));
+  w->fp = HAZ_fopen((char *)namevtk,"w");
+  w->format = vtu_format_default;
+  w->compress = vtu_compress_default;
+  if(w->format==VTU_ASCII) {
+    fprintf(w->fp,"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"%s\">\n",
+            vtu_byte_order());
+  } else {
+    fprintf(w->fp,"<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\"%s>\n",
+            vtu_byte_order(),w->compress ? " compressor=\"vtkZLibDataCompressor\"" : "");
+  }
+  return w;
+}
+
+/* encode nbytes of data as the next appended array of w and finish its DataArray tag */
+static void vtu_append(vtu_writer *w,
+                       const void *data,
+                       const size_t nbytes)
+{
+  unsigned long long *head = NULL;
+  unsigned char *bin = (unsigned char *)data, *blk;
+  size_t nhead, nbin = nbytes, len;
+
+  if(w->narrays==w->nalloc) {
+    w->nalloc = 2*w->nalloc+8;
+    w->block = (unsigned char **)realloc(w->block,w->nalloc*sizeof(unsigned char *));
+    w->nbytes = (size_t *)realloc(w->nbytes,w->nalloc*sizeof(size_t));
+  }
+
+  if(!w->compress) {
+    nhead = 1;
+    head = (unsigned long long *)malloc(sizeof(unsigned long long));
+    head[0] = nbytes;
+  }
+#if WITH_ZLIB
+  else {
+    // header: nblocks, block size, size of last block, compressed sizes
+    size_t nblk = (nbytes+VTU_BLOCK-1)/VTU_BLOCK, b, s, bound = 0;
+    uLongf clen;
+    nhead = 3+nblk;
+    head = (unsigned long long *)calloc(nhead,sizeof(unsigned long long));
+    head[0] = nblk;
+    head[1] = VTU_BLOCK;
+    head[2] = nblk ? nbytes-(nblk-1)*VTU_BLOCK : 0;
+    for(b=0;b<nblk;b++) bound += compressBound(VTU_BLOCK);
+    bin = (unsigned char *)malloc(bound+1);
+    for(nbin=0,b=0;b<nblk;b++) {
+      s = (b<nblk-1) ? VTU_BLOCK : head[2];
+      clen = compressBound(s);
+      // speed over size: the output is written every time step. The
+      // buffer is large enough, so only a memory error is possible; the
+      // file says all blocks are compressed, so it cannot be skipped
+      if(compress2(bin+nbin,&clen,(const Bytef *)data+b*VTU_BLOCK,s,Z_BEST_SPEED)!=Z_OK)
+        check_error(ERROR_ALLOC_MEM, __FUNCTION__);
+      head[3+b] = clen;
+      nbin += clen;
+    }
+  }
+#endif
+
+  // header and data are encoded separately, as VTK reads them
+  if(w->format==VTU_BASE64) {
+    blk = (unsigned char *)malloc(4*((nhead*sizeof(unsigned long long)+2)/3+(nbin+2)/3)+1);
+    len = vtu_base64((unsigned char *)head,nhead*sizeof(unsigned long long),blk);
+    len += vtu_base64(bin,nbin,blk+len);
+  } else {
+    len = nhead*sizeof(unsigned long long)+nbin;
+    blk = (unsigned char *)malloc(len+1);
+    memcpy(blk,head,nhead*sizeof(unsigned long long));
+    memcpy(blk+nhead*sizeof(unsigned long long),bin,nbin);
+  }
+
+  fprintf(w->fp," format=\"appended\" offset=\"%llu\"/>\n",(unsigned long long)w->offset);
+  w->block[w->narrays] = blk;
+  w->nbytes[w->narrays] = len;
+  w->narrays++;
+  w->offset += len;
+
+  free(head);
+  if(bin!=(unsigned char *)data) free(bin);
+}
+
+/******************************************************************************/
+/*!
+ * \fn void vtu_darray(vtu_writer *w, const char *name, const INT ncomp,
+ *                     const REAL *x, const INT n)
+ *
+ * \brief Write a Float64 DataArray
+ *
+ * \param w      Pointer to the vtu_writer
+ * \param name   Name of the array (NULL: no name)
+ * \param ncomp  Number of components per tuple
+ * \param x      Values
+ * \param n      Number of values (tuples*ncomp)
+ *
+ */
+void vtu_darray(vtu_writer *w,
+                const char *name,
+                const INT ncomp,
+                const REAL *x,
+                const INT n)
+{
+  INT k;
+  fprintf(w->fp,"<DataArray type=\"Float64\"");
+  if(name) fprintf(w->fp," Name=\"%s\"",name);
+  if(ncomp>1) fprintf(w->fp," NumberOfComponents=\"%lld\"",(long long )ncomp);
+  if(w->format==VTU_ASCII) {
+    fprintf(w->fp," format=\"ascii\">");
+    for(k=0;k<n;k++) fprintf(w->fp," %23.16e ",x[k]);
+    fprintf(w->fp,"</DataArray>\n");
+  } else {
+    vtu_append(w,x,(size_t)n*sizeof(REAL));
+  }
+}
+
+/******************************************************************************/
+/*!
+ * \fn void vtu_iarray(vtu_writer *w, const char *name, const INT *ix, const INT n)
+ *
+ * \brief Write an integer (Int32 or Int64, the size of INT) DataArray
+ *
+ * \param w      Pointer to the vtu_writer
+ * \param name   Name of the array (NULL: no name)
+ * \param ix     Values
+ * \param n      Number of values
+ *
+ */
+void vtu_iarray(vtu_writer *w,
+                const char *name,
+                const INT *ix,
+                const INT n)
+{
+  INT k;
+  fprintf(w->fp,"<DataArray type=\"%s\"",(sizeof(INT)==8) ? "Int64" : "Int32");
+  if(name) fprintf(w->fp," Name=\"%s\"",name);
+  if(w->format==VTU_ASCII) {
+    fprintf(w->fp," format=\"ascii\">");
+    for(k=0;k<n;k++) fprintf(w->fp," %lld ",(long long )ix[k]);
+    fprintf(w->fp,"</DataArray>\n");
+  } else {
+    vtu_append(w,ix,(size_t)n*sizeof(INT));
+  }
+}
+
+/******************************************************************************/
+/*!
+ * \fn void vtu_close(vtu_writer *w)
+ *
+ * \brief Write the appended data (if any), close the VTKFile element and the
+ *        file and free the vtu_writer
+ *
+ * \param w      Pointer to the vtu_writer
+ *
+ */
+void vtu_close(vtu_writer *w)
+{
+  INT k;
+  if(w->narrays) {
+    fprintf(w->fp,"<AppendedData encoding=\"%s\">\n_",(w->format==VTU_BASE64) ? "base64" : "raw");
+    for(k=0;k<w->narrays;k++) {
+      fwrite(w->block[k],1,w->nbytes[k],w->fp);
+      free(w->block[k]);
+    }
+    fprintf(w->fp,"\n</AppendedData>\n");
+  }
+  fprintf(w->fp,"</VTKFile>\n");
+  fclose(w->fp);
+  free(w->block);
+  free(w->nbytes);
+  free(w);
+}
+
+/******************************************************************************/
+/* coordinates of the mesh vertices as an nv x 3 array (for the Points element) */
+static REAL *vtu_mesh_points(mesh_struct *mesh)
+{
+  INT k, nv = mesh->nv, dim = mesh->dim;
+  REAL *xyz = (REAL *)calloc(3*nv,sizeof(REAL));
+  for(k=0;k<nv;k++) {
+    xyz[3*k] = mesh->cv->x[k];
+    if(dim>1) xyz[3*k+1] = mesh->cv->y[k];
+    if(dim>2) xyz[3*k+2] = mesh->cv->z[k];
+  }
+  return xyz;
+}
+
+/* Cells element (offsets, connectivity, types) of a simplicial mesh */
+static void vtu_mesh_cells(vtu_writer *w,
+                           mesh_struct *mesh)
+{
+  // VTK_LINE (=3), VTK_TRIANGLE(=5), VTK_TETRA (=10)
+  const INT tcell = (mesh->dim==1) ? 3 : ((mesh->dim==2) ? 5 : 10);
+  INT k, nelm = mesh->nelm;
+  INT *types = (INT *)malloc(nelm*sizeof(INT));
+  for(k=0;k<nelm;k++) types[k] = tcell;
+  fprintf(w->fp,"<Cells>\n");
+  vtu_iarray(w,"offsets",mesh->el_v->IA+1,nelm);
+  vtu_iarray(w,"connectivity",mesh->el_v->JA,nelm*mesh->v_per_elm);
+  vtu_iarray(w,"types",types,nelm);
+  fprintf(w->fp,"</Cells>\n");
+  free(types);
+}
+
 /******************************************************************************/
 /*!
  * \fn void dump_sol_onV_vtk(char *namevtk,mesh_struct *mesh,REAL *sol,INT ncomp)
@@ -1075,131 +1365,39 @@ void dump_sol_onV_vtk(char *namevtk,
 {
   // Basic Quantities
   INT nv = mesh->nv;
-  INT nelm = mesh->nelm;
-  INT dim = mesh->dim;
-  INT v_per_elm = mesh->v_per_elm;
-
-  // VTK needed Quantities
-  INT tcell=-10;
-  INT k=-10,j=-10,kndl=-10;
-  char *tfloat=strndup("Float64",8);
-  char *tinto=strndup("Int64",6);
-  char *endian=strndup("LittleEndian",13);
-  /*
-    What endian?:
-
-    Intel x86; OS=MAC OS X: little-endian
-    Intel x86; OS=Windows: little-endian
-    Intel x86; OS=Linux: little-endian
-    Intel x86; OS=Solaris: little-endian
-    Dec Alpha; OS=Digital Unix: little-endian
-    Dec Alpha; OS=VMS: little-endian
-    Hewlett Packard PA-RISC; OS=HP-UX: big-endian
-    IBM RS/6000; OS=AIX: big-endian
-    Motorola PowerPC; OS=Mac OS X:  big-endian
-    SGI R4000 and up; OS=IRIX: big-endian
-    Sun SPARC; OS=Solaris: big-endian
-  */
-
-  /*
-    Types of cells for VTK
-
-    VTK_VERTEX (=1)
-    VTK_POLY_VERTEX (=2)
-    VTK_LINE (=3)
-    VTK_POLY_LINE (=4)
-    VTK_TRIANGLE(=5)
-    VTK_TRIANGLE_STRIP (=6)
-    VTK_POLYGON (=7)
-    VTK_PIXEL (=8)
-    VTK_QUAD (=9)
-    VTK_TETRA (=10)
-    VTK_VOXEL (=11)
-    VTK_HEXAHEDRON (=12)
-    VTK_WEDGE (=13)
-    VTK_PYRAMID (=14)
-  */
-
-  const INT LINE=3;
-  const INT TRI=5;
-  const INT TET=10;
+  INT i;
+  char name[40];
 
-  if(dim==1) {
-    tcell=LINE; /* line */
-  } else if(dim==2) {
-    tcell=TRI; /* triangle */
-  } else {
-    tcell=TET; /* tet */
-  }
   // Open File for Writing
-  FILE* fvtk = HAZ_fopen(namevtk,"w");
+  vtu_writer *w = vtu_open(namevtk);
+  FILE* fvtk = w->fp;
 
   // Write Headers
-  fprintf(fvtk, \
-	  "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"%s\">\n", \
-	  endian);
   fprintf(fvtk,"<UnstructuredGrid>\n");
-  fprintf(fvtk,"<Piece NumberOfPoints=\"%lld\" NumberOfCells=\"%lld\">\n",(long long )nv,(long long )nelm);
-  fprintf(fvtk,"<Points>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" NumberOfComponents=\"3\" Format=\"ascii\">", \
-  	  tfloat);
+  fprintf(fvtk,"<Piece NumberOfPoints=\"%lld\" NumberOfCells=\"%lld\">\n",(long long )nv,(long long )mesh->nelm);
 
   // Dump coordinates
-  if(dim == 1) {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],0e0,0e0);
-    }
-  } else if(dim == 2) {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],mesh->cv->y[k],0e0);
-    }
-  } else {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],mesh->cv->y[k], \
-  	      mesh->cv->z[k]);
-    }
-  }
-  fprintf(fvtk,"</DataArray>\n");
+  REAL *xyz = vtu_mesh_points(mesh);
+  fprintf(fvtk,"<Points>\n");
+  vtu_darray(w,NULL,3,xyz,3*nv);
   fprintf(fvtk,"</Points>\n");
+  free(xyz);
 
   // Dump solution Data on Vertices of mesh
   fprintf(fvtk,"<PointData Scalars=\"scalars\">\n");
-  INT i=0;
   for(i=0;i<ncomp;i++) {
-    fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component %lld\" Format=\"ascii\">",tfloat,(long long )i);
-    for(k=0;k<nv;k++) fprintf(fvtk," %23.16e ",sol[i*nv+k]);
-    fprintf(fvtk,"</DataArray>\n");
+    sprintf(name,"Solution Component %lld",(long long )i);
+    vtu_darray(w,name,1,sol+i*nv,nv);
   }
   fprintf(fvtk,"</PointData>\n");
 
-  // Dump el_v map
-  fprintf(fvtk,"<Cells>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"offsets\" Format=\"ascii\">",tinto);
-  for(k=1;k<=nelm;k++) fprintf(fvtk," %lld ",(long long )mesh->el_v->IA[k]);
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"connectivity\" Format=\"ascii\">\n",tinto);
-  for(k=0;k<nelm;k++){
-    kndl=k*v_per_elm;
-    for(j=0;j<v_per_elm;j++) fprintf(fvtk," %lld ",(long long )mesh->el_v->JA[kndl + j]);
-  }
-  fprintf(fvtk,"</DataArray>\n");
-
-  // Dump Element Type
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"types\" Format=\"ascii\">",tinto);
-  for(k=1;k<=nelm;k++)
-    fprintf(fvtk," %lld ",(long long )tcell);
+  // Dump el_v map and element types
+  vtu_mesh_cells(w,mesh);
 
   // Put in remaining headers
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"</Cells>\n");
   fprintf(fvtk,"</Piece>\n");
   fprintf(fvtk,"</UnstructuredGrid>\n");
-  fprintf(fvtk,"</VTKFile>\n");
-
-  fclose(fvtk);
-  free(tfloat);
-  free(tinto);
-  free(endian);
+  vtu_close(w);
 
   return;
 }
@@ -1225,86 +1423,23 @@ void dump_sol_vtk(char *namevtk,char *varname,mesh_struct *mesh,fespace *FE,REAL
   INT nv = mesh->nv;
   INT nelm = mesh->nelm;
   INT dim = mesh->dim;
-  INT v_per_elm = mesh->v_per_elm;
-
-  // VTK needed Quantities
-  INT tcell=-10;
-  INT k=-10,j=-10,kndl=-10;
-  char *tfloat="Float64", *tinto="Int64", *endian="LittleEndian";
-
-  /*
-    What endian?:
-
-    Intel x86; OS=MAC OS X: little-endian
-    Intel x86; OS=Windows: little-endian
-    Intel x86; OS=Linux: little-endian
-    Intel x86; OS=Solaris: little-endian
-    Dec Alpha; OS=Digital Unix: little-endian
-    Dec Alpha; OS=VMS: little-endian
-    Hewlett Packard PA-RISC; OS=HP-UX: big-endian
-    IBM RS/6000; OS=AIX: big-endian
-    Motorola PowerPC; OS=Mac OS X:  big-endian
-    SGI R4000 and up; OS=IRIX: big-endian
-    Sun SPARC; OS=Solaris: big-endian
-  */
-
-  /*
-    Types of cells for VTK
-
-    VTK_VERTEX (=1)
-    VTK_POLY_VERTEX (=2)
-    VTK_LINE (=3)
-    VTK_POLY_LINE (=4)
-    VTK_TRIANGLE(=5)
-    VTK_TRIANGLE_STRIP (=6)
-    VTK_POLYGON (=7)
-    VTK_PIXEL (=8)
-    VTK_QUAD (=9)
-    VTK_TETRA (=10)
-    VTK_VOXEL (=11)
-    VTK_HEXAHEDRON (=12)
-    VTK_WEDGE (=13)
-    VTK_PYRAMID (=14)
-  */
-
-  const INT LINE=3;
-  const INT TRI=5;
-  const INT TET=10;
+  size_t lname = strlen(varname)+40;
+  char *name = (char *)malloc(lname);
 
-  if(dim==1) {
-    tcell=LINE; /* line */
-  } else if(dim==2) {
-    tcell=TRI; /* triangle */
-  } else {
-    tcell=TET; /* tet */
-  }
   // Open File for Writing
-  FILE* fvtk = HAZ_fopen(namevtk,"w");
+  vtu_writer *w = vtu_open(namevtk);
+  FILE* fvtk = w->fp;
 
   // Write Headers
-  fprintf(fvtk,"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"%s\">\n",endian);
   fprintf(fvtk,"<UnstructuredGrid>\n");
   fprintf(fvtk,"<Piece NumberOfPoints=\"%lld\" NumberOfCells=\"%lld\">\n",(long long )nv,(long long )nelm);
-  fprintf(fvtk,"<Points>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" NumberOfComponents=\"3\" Format=\"ascii\">",tfloat);
 
-  // Dump vertex coordinates and solution
-  if(dim == 1) {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],0e0,0e0);
-    }
-  } else if(dim == 2) {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],mesh->cv->y[k],0e0);
-    }
-  } else {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],mesh->cv->y[k], \
-              mesh->cv->z[k]);
-    }
-  }
-  fprintf(fvtk,"</DataArray>\n");
+  // Dump vertex coordinates
+  REAL *xyz = vtu_mesh_points(mesh);
+  fprintf(fvtk,"<Points>\n");
+  vtu_darray(w,NULL,3,xyz,3*nv);
   fprintf(fvtk,"</Points>\n");
+  free(xyz);
 
   // Dump Solution
   // Depending on the FE space, we will dump things differently
@@ -1312,54 +1447,35 @@ void dump_sol_vtk(char *namevtk,char *varname,mesh_struct *mesh,fespace *FE,REAL
   REAL* sol_on_V=NULL;
   if(FE->FEtype==0) { // P0 - only have cell data
     fprintf(fvtk,"<CellData Scalars=\"scalars\">\n");
-    fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component - %s\" Format=\"ascii\">",tfloat,varname);
-    for(k=0;k<nelm;k++) fprintf(fvtk," %23.16e ",sol[k]);
-    fprintf(fvtk,"</DataArray>\n");
+    snprintf(name,lname,"Solution Component - %s",varname);
+    vtu_darray(w,name,1,sol,nelm);
     fprintf(fvtk,"</CellData>\n");
   } else if(FE->FEtype>0 && FE->FEtype<20) { // PX elements (assume sol at vertices comes first)
     fprintf(fvtk,"<PointData Scalars=\"scalars\">\n");
-    fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component - %s\" Format=\"ascii\">",tfloat,varname);
-    for(k=0;k<nv;k++) fprintf(fvtk," %23.16e ",sol[k]);
-    fprintf(fvtk,"</DataArray>\n");
+    snprintf(name,lname,"Solution Component - %s",varname);
+    vtu_darray(w,name,1,sol,nv);
     fprintf(fvtk,"</PointData>\n");
   } else { // Vector Elements
     sol_on_V = (REAL *) calloc(dim*mesh->nv,sizeof(REAL));
     Project_to_Vertices(sol_on_V,sol,FE,mesh);
     fprintf(fvtk,"<PointData Scalars=\"scalars\">\n");
     for(i=0;i<dim;i++) {
-      fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component - %s%lld\" Format=\"ascii\">",tfloat,varname,(long long )i);
-      for(k=0;k<nv;k++) fprintf(fvtk," %23.16e ",sol_on_V[i*nv+k]);
-      fprintf(fvtk,"</DataArray>\n");
+      snprintf(name,lname,"Solution Component - %s%lld",varname,(long long )i);
+      vtu_darray(w,name,1,sol_on_V+i*nv,nv);
     }
     fprintf(fvtk,"</PointData>\n");
   }
 
-  // Dump el_v map
-  fprintf(fvtk,"<Cells>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"offsets\" Format=\"ascii\">",tinto);
-  for(k=1;k<=nelm;k++) fprintf(fvtk," %lld ",(long long )mesh->el_v->IA[k]);
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"connectivity\" Format=\"ascii\">\n",tinto);
-  for(k=0;k<nelm;k++){
-    kndl=k*v_per_elm;
-    for(j=0;j<v_per_elm;j++) fprintf(fvtk," %lld ",(long long )mesh->el_v->JA[kndl + j]);
-  }
-  fprintf(fvtk,"</DataArray>\n");
-
-  // Dump Element Type
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"types\" Format=\"ascii\">",tinto);
-  for(k=1;k<=nelm;k++)
-    fprintf(fvtk," %lld ",(long long )tcell);
+  // Dump el_v map and element types
+  vtu_mesh_cells(w,mesh);
 
   // Put in remaining headers
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"</Cells>\n");
   fprintf(fvtk,"</Piece>\n");
   fprintf(fvtk,"</UnstructuredGrid>\n");
-  fprintf(fvtk,"</VTKFile>\n");
+  vtu_close(w);
 
-  fclose(fvtk);
   if(sol_on_V) free(sol_on_V);
+  free(name);
 
   return;
 }
@@ -1381,90 +1497,28 @@ void dump_sol_vtk(char *namevtk,char *varname,mesh_struct *mesh,fespace *FE,REAL
 void dump_blocksol_vtk(char *namevtk,char **varname,mesh_struct *mesh,block_fespace *FE,REAL *sol)
 {
   // Basic Quantities
-  INT i,nsp;
+  INT i,k,nsp;
   INT nv = mesh->nv;
   INT nelm = mesh->nelm;
   INT dim = mesh->dim;
-  INT v_per_elm = mesh->v_per_elm;
+  size_t lname = 40;
+  for(nsp=0;nsp<FE->nspaces;nsp++) lname = MAX(lname,strlen(varname[nsp])+40);
+  char *name = (char *)malloc(lname);
 
-  // VTK needed Quantities
-  INT tcell=-10;
-  INT k=-10,j=-10,kndl=-10;
-  char *tfloat="Float64", *tinto="Int64", *endian="LittleEndian";
-
-  /*
-    What endian?:
-
-    Intel x86; OS=MAC OS X: little-endian
-    Intel x86; OS=Windows: little-endian
-    Intel x86; OS=Linux: little-endian
-    Intel x86; OS=Solaris: little-endian
-    Dec Alpha; OS=Digital Unix: little-endian
-    Dec Alpha; OS=VMS: little-endian
-    Hewlett Packard PA-RISC; OS=HP-UX: big-endian
-    IBM RS/6000; OS=AIX: big-endian
-    Motorola PowerPC; OS=Mac OS X:  big-endian
-    SGI R4000 and up; OS=IRIX: big-endian
-    Sun SPARC; OS=Solaris: big-endian
-  */
-
-  /*
-    Types of cells for VTK
-
-    VTK_VERTEX (=1)
-    VTK_POLY_VERTEX (=2)
-    VTK_LINE (=3)
-    VTK_POLY_LINE (=4)
-    VTK_TRIANGLE(=5)
-    VTK_TRIANGLE_STRIP (=6)
-    VTK_POLYGON (=7)
-    VTK_PIXEL (=8)
-    VTK_QUAD (=9)
-    VTK_TETRA (=10)
-    VTK_VOXEL (=11)
-    VTK_HEXAHEDRON (=12)
-    VTK_WEDGE (=13)
-    VTK_PYRAMID (=14)
-  */
-
-  const INT LINE=3;
-  const INT TRI=5;
-  const INT TET=10;
-
-  if(dim==1) {
-    tcell=LINE; /* line */
-  } else if(dim==2) {
-    tcell=TRI; /* triangle */
-  } else {
-    tcell=TET; /* tet */
-  }
   // Open File for Writing
-  FILE* fvtk = HAZ_fopen(namevtk,"w");
+  vtu_writer *w = vtu_open(namevtk);
+  FILE* fvtk = w->fp;
 
   // Write Headers
-  fprintf(fvtk,"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"%s\">\n",endian);
   fprintf(fvtk,"<UnstructuredGrid>\n");
   fprintf(fvtk,"<Piece NumberOfPoints=\"%lld\" NumberOfCells=\"%lld\">\n",(long long )nv,(long long )nelm);
-  fprintf(fvtk,"<Points>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" NumberOfComponents=\"3\" Format=\"ascii\">",tfloat);
 
-  // Dump vertex coordinates and solution
-  if(dim == 1) {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],0e0,0e0);
-    }
-  } else if(dim == 2) {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],mesh->cv->y[k],0e0);
-    }
-  } else {
-    for(k=0;k<nv;k++) {
-      fprintf(fvtk," %23.16e %23.16e %23.16e ",mesh->cv->x[k],mesh->cv->y[k], \
-              mesh->cv->z[k]);
-    }
-  }
-  fprintf(fvtk,"</DataArray>\n");
+  // Dump vertex coordinates
+  REAL *xyz = vtu_mesh_points(mesh);
+  fprintf(fvtk,"<Points>\n");
+  vtu_darray(w,NULL,3,xyz,3*nv);
   fprintf(fvtk,"</Points>\n");
+  free(xyz);
 
   // Dump Solution for each FE space
   REAL* sol_on_V=NULL;
@@ -1481,21 +1535,21 @@ void dump_blocksol_vtk(char *namevtk,char **varname,mesh_struct *mesh,block_fesp
       anyP0=1;
       P0cntr[nsp] = 1;
     } else if((FE->var_spaces[nsp]->FEtype>0 && FE->var_spaces[nsp]->FEtype<20) || FE->var_spaces[nsp]->FEtype==103) { // PX elements (assume sol at vertices comes first)
-      fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component %lld - %s\" Format=\"ascii\">",tfloat,(long long )nsp,varname[nsp]);
-      for(k=0;k<nv;k++) fprintf(fvtk," %23.16e ",sol[spcntr + k]);
-      fprintf(fvtk,"</DataArray>\n");
+      snprintf(name,lname,"Solution Component %lld - %s",(long long )nsp,varname[nsp]);
+      vtu_darray(w,name,1,sol+spcntr,nv);
     } else if(FE->var_spaces[nsp]->FEtype==99) { // Single DoF constraint element (just plot single value everywhere)
-      fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component %lld - %s\" Format=\"ascii\">",tfloat,(long long )nsp,varname[nsp]);
-      for(k=0;k<nv;k++) fprintf(fvtk," %23.16e ",sol[spcntr]);
-      fprintf(fvtk,"</DataArray>\n");
+      sol_on_V = (REAL *) calloc(nv,sizeof(REAL));
+      for(k=0;k<nv;k++) sol_on_V[k] = sol[spcntr];
+      snprintf(name,lname,"Solution Component %lld - %s",(long long )nsp,varname[nsp]);
+      vtu_darray(w,name,1,sol_on_V,nv);
+      free(sol_on_V);
     } else { // Vector Elements
       sol_on_V = (REAL *) calloc(dim*mesh->nv,sizeof(REAL));
       solptr = sol+spcntr;
       Project_to_Vertices(sol_on_V,solptr,FE->var_spaces[nsp],mesh);
       for(i=0;i<dim;i++) {
-        fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component %lld - %s%lld\" Format=\"ascii\">",tfloat,(long long )nsp,varname[nsp],(long long )i);
-        for(k=0;k<nv;k++) fprintf(fvtk," %23.16e ",sol_on_V[i*nv+k]);
-        fprintf(fvtk,"</DataArray>\n");
+        snprintf(name,lname,"Solution Component %lld - %s%lld",(long long )nsp,varname[nsp],(long long )i);
+        vtu_darray(w,name,1,sol_on_V+i*nv,nv);
       }
       if(sol_on_V) free(sol_on_V);
     }
@@ -1509,9 +1563,8 @@ void dump_blocksol_vtk(char *namevtk,char **varname,mesh_struct *mesh,block_fesp
     fprintf(fvtk,"<CellData Scalars=\"scalars\">\n");
     for(nsp=0;nsp<FE->nspaces;nsp++) {
       if(P0cntr[nsp]==1) {
-        fprintf(fvtk,"<DataArray type=\"%s\" Name=\"Solution Component %lld - %s\" Format=\"ascii\">",tfloat,(long long )nsp,varname[nsp]);
-        for(k=0;k<nelm;k++) fprintf(fvtk," %23.16e ",sol[spcntr+k]);
-        fprintf(fvtk,"</DataArray>\n");
+        snprintf(name,lname,"Solution Component %lld - %s",(long long )nsp,varname[nsp]);
+        vtu_darray(w,name,1,sol+spcntr,nelm);
       }
       spcntr += FE->var_spaces[nsp]->ndof;
     }
@@ -1519,31 +1572,14 @@ void dump_blocksol_vtk(char *namevtk,char **varname,mesh_struct *mesh,block_fesp
   }
   if(P0cntr) free(P0cntr);
 
-  // Dump el_v map
-  fprintf(fvtk,"<Cells>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"offsets\" Format=\"ascii\">",tinto);
-  for(k=1;k<=nelm;k++) fprintf(fvtk," %lld ",(long long )mesh->el_v->IA[k]);
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"connectivity\" Format=\"ascii\">\n",tinto);
-  for(k=0;k<nelm;k++){
-    kndl=k*v_per_elm;
-    for(j=0;j<v_per_elm;j++) fprintf(fvtk," %lld ",(long long )mesh->el_v->JA[kndl + j]);
-  }
-  fprintf(fvtk,"</DataArray>\n");
-
-  // Dump Element Type
-  fprintf(fvtk,"<DataArray type=\"%s\" Name=\"types\" Format=\"ascii\">",tinto);
-  for(k=1;k<=nelm;k++)
-    fprintf(fvtk," %lld ",(long long )tcell);
+  // Dump el_v map and element types
+  vtu_mesh_cells(w,mesh);
 
   // Put in remaining headers
-  fprintf(fvtk,"</DataArray>\n");
-  fprintf(fvtk,"</Cells>\n");
   fprintf(fvtk,"</Piece>\n");
   fprintf(fvtk,"</UnstructuredGrid>\n");
-  fprintf(fvtk,"</VTKFile>\n");
-
-  fclose(fvtk);
+  vtu_close(w);
+  free(name);
 
   return;
 }
@@ -1578,7 +1614,7 @@ void create_pvd(char *namepvd, INT nfiles,char *vtkfilename,char *filetype)
   //    SGI R4000 and up; OS=IRIX: big-endian
   //    Sun SPARC; OS=Solaris: big-endian
 
-  char *endian="LittleEndian";
+  const char *endian=vtu_byte_order();
   INT i;
 
   // Open File for Writing
@@ -1586,9 +1622,7 @@ void create_pvd(char *namepvd, INT nfiles,char *vtkfilename,char *filetype)
 
   // Write Headers
   fprintf(fvtk,"<?xml version=\"1.0\"?>\n");
-  fprintf(fvtk,
-          "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"%s\" compressor=\"vtkZLibDataCompressor\">\n", \
-          endian);
+  fprintf(fvtk,"<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"%s\">\n",endian);
   fprintf(fvtk,"<Collection>\n");
   char filecounter[40];
   for(i=0;i<nfiles;i++) {
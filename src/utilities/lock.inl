@@ -0,0 +1,22 @@
+/*! \file src/utilities/lock.inl
+ *
+ *  \brief Lock for the process-wide caches (ra_cache.c, direct.c).
+ *
+ *  \note  With WITH_PTHREADS this is a pthread mutex. Otherwise it is a
+ *         spin lock on the gcc atomic builtins, which is enough for the
+ *         OpenMP threads of the library and needs no extra library.
+ *
+ */
+
+#if WITH_PTHREADS
+#include <pthread.h>
+typedef pthread_mutex_t haz_lock_t;
+#define HAZ_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define haz_lock(l)   pthread_mutex_lock(l)
+#define haz_unlock(l) pthread_mutex_unlock(l)
+#else
+typedef volatile int haz_lock_t;
+#define HAZ_LOCK_INITIALIZER 0
+#define haz_lock(l)   while(__sync_lock_test_and_set((l),1))
+#define haz_unlock(l) __sync_lock_release(l)
+#endif
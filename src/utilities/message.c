@@ -113,24 +113,30 @@ void print_amg_complexity(AMG_data *mgl,
 
   if ( print_lvl >= PRINT_SOME ) {
 
-    printf("-----------------------------------------------------------\n");
-    printf("  Level   Num of rows   Num of nonzeros   Avg. NNZ / row   \n");
-    printf("-----------------------------------------------------------\n");
+    printf("-------------------------------------------------------------------------------------\n");
+    printf("  Level   Num of rows   Num of nonzeros   Avg. NNZ / row   Coarsening   Op. complexity\n");
+    printf("-------------------------------------------------------------------------------------\n");
 
     for ( level = 0; level < max_levels; ++level) {
         AvgNNZ = (REAL) mgl[level].A.nnz/mgl[level].A.row;
-        printf("%5lld %13lld %17lld %14.2f\n", (long long )level, (long long )mgl[level].A.row, (long long )mgl[level].A.nnz, AvgNNZ);
         grid_complexity     += mgl[level].A.row;
         operator_complexity += mgl[level].A.nnz;
+        // coarsening ratio to the previous level and operator complexity up to this level
+        if ( level > 0 )
+            printf("%5lld %13lld %17lld %14.2f %12.2f %16.3f\n", (long long )level, (long long )mgl[level].A.row, (long long )mgl[level].A.nnz, AvgNNZ,
+                   (REAL) mgl[level-1].A.row/mgl[level].A.row, operator_complexity/mgl[0].A.nnz);
+        else
+            printf("%5lld %13lld %17lld %14.2f %12s %16.3f\n", (long long )level, (long long )mgl[level].A.row, (long long )mgl[level].A.nnz, AvgNNZ,
+                   "", operator_complexity/mgl[0].A.nnz);
     }
-    printf("-----------------------------------------------------------\n");
+    printf("-------------------------------------------------------------------------------------\n");
 
     grid_complexity     /= mgl[0].A.row;
     operator_complexity /= mgl[0].A.nnz;
     printf("  Grid complexity = %.3f  |", grid_complexity);
     printf("  Operator complexity = %.3f\n", operator_complexity);
 
-    printf("-----------------------------------------------------------\n");
+    printf("-------------------------------------------------------------------------------------\n");
 
   }
 }
@@ -273,6 +279,9 @@ void check_error(const SHORT status,
   case ERROR_TS_TYPE:
       printf("\n!!! ERROR HAZMATH DANGER: in function '%s' -- The time-stepping scheme you want is not implemented !!!\n\n", func_name);
       break;
+  case ERROR_TS_STEP:
+      printf("\n!!! ERROR HAZMATH DANGER: in function '%s' -- The time step size fell below its minimum !!!\n\n", func_name);
+      break;
   default:
       break;
 
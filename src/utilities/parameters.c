@@ -85,6 +85,8 @@ void param_input_init (input_param *inparam)
     inparam->nonlinear_itsolver_maxit   = 0;
     inparam->nonlinear_itsolver_tol     = 1e-6;
     inparam->nonlinear_itsolver_toltype	= 0;
+    inparam->nonlinear_itsolver_forcing = 0;
+    inparam->nonlinear_itsolver_pc_lag  = 1;
 
     //-------------------------
     // linear solver parameters
@@ -109,11 +111,12 @@ void param_input_init (input_param *inparam)
     inparam->AMG_polynomial_degree    = 2;
     inparam->AMG_relaxation           = 1.2;
     inparam->AMG_coarse_dof           = 200;
-    inparam->AMG_coarse_solver        = SOLVER_DEFAULT;
+    inparam->AMG_coarse_solver        = SOLVER_AUTO;
     inparam->AMG_tol                  = 1e-6;
     inparam->AMG_maxit                = 1;
     inparam->AMG_Schwarz_levels       = 0;
     inparam->AMG_coarse_scaling       = OFF;
+    inparam->AMG_sell_chunk           = 0;
     inparam->AMG_amli_degree          = 1;
     inparam->AMG_nl_amli_krylov_type  = 2;
     inparam->AMG_fpwr                 = 1.0;
@@ -122,8 +125,10 @@ void param_input_init (input_param *inparam)
     inparam->AMG_aggregation_type     = HEC;
     inparam->AMG_strong_coupled       = 0.04;
     inparam->AMG_max_aggregation      = 20;
+    inparam->AMG_aggressive_levels    = 0;
 
     inparam->AMG_tentative_smooth     = 0.67;
+    inparam->AMG_smooth_drop_tol      = 0.0;
     inparam->AMG_smooth_filter        = ON;
 
     // Schwarz method parameters
@@ -168,10 +173,11 @@ void param_amg_init (AMG_param *amgparam)
     amgparam->smoother             = SMOOTHER_GS;
     amgparam->presmooth_iter       = 1;
     amgparam->postsmooth_iter      = 1;
-    amgparam->coarse_solver        = SOLVER_DEFAULT;
+    amgparam->coarse_solver        = SOLVER_AUTO;
     amgparam->relaxation           = 1.0;
     amgparam->polynomial_degree    = 2;
     amgparam->coarse_scaling       = OFF;
+    amgparam->sell_chunk           = 0;
     amgparam->amli_degree          = 2;
     amgparam->amli_coef            = NULL;
     amgparam->nl_amli_krylov_type  = SOLVER_VFGMRES;
@@ -181,8 +187,10 @@ void param_amg_init (AMG_param *amgparam)
     amgparam->aggregation_type     = HEC;
     amgparam->strong_coupled       = 0.04;
     amgparam->max_aggregation      = 20;
+    amgparam->aggressive_levels    = 0;
 
     amgparam->tentative_smooth     = 0.67;
+    amgparam->smooth_drop_tol      = 0.0;
     amgparam->smooth_filter        = ON;
 
     // Schwarz smoother parameters
@@ -319,6 +327,7 @@ void param_amg_set (AMG_param *amgparam,
     amgparam->coarse_solver        = inparam->AMG_coarse_solver;
     amgparam->coarse_dof           = inparam->AMG_coarse_dof;
     amgparam->coarse_scaling       = inparam->AMG_coarse_scaling;
+    amgparam->sell_chunk           = inparam->AMG_sell_chunk;
     amgparam->amli_degree          = inparam->AMG_amli_degree;
     amgparam->amli_coef            = NULL;
     amgparam->nl_amli_krylov_type  = inparam->AMG_nl_amli_krylov_type;
@@ -327,8 +336,10 @@ void param_amg_set (AMG_param *amgparam,
     amgparam->aggregation_type     = inparam->AMG_aggregation_type;
     amgparam->strong_coupled       = inparam->AMG_strong_coupled;
     amgparam->max_aggregation      = inparam->AMG_max_aggregation;
+    amgparam->aggressive_levels    = inparam->AMG_aggressive_levels;
 
     amgparam->tentative_smooth     = inparam->AMG_tentative_smooth;
+    amgparam->smooth_drop_tol      = inparam->AMG_smooth_drop_tol;
     amgparam->smooth_filter        = inparam->AMG_smooth_filter;
 
     amgparam->Schwarz_levels       = inparam->AMG_Schwarz_levels;
@@ -378,6 +389,7 @@ void param_amg_cp (AMG_param *amgparam1,
     amgparam2->coarse_solver        = amgparam1->coarse_solver;
     amgparam2->coarse_dof           = amgparam1->coarse_dof;
     amgparam2->coarse_scaling       = amgparam1->coarse_scaling;
+    amgparam2->sell_chunk           = amgparam1->sell_chunk;
     amgparam2->amli_degree          = amgparam1->amli_degree;
 
     if(amgparam1->amli_coef) array_cp(amgparam1->amli_degree + 1, amgparam1->amli_coef, amgparam2->amli_coef);
@@ -388,8 +400,10 @@ void param_amg_cp (AMG_param *amgparam1,
     amgparam2->aggregation_type     = amgparam1->aggregation_type;
     amgparam2->strong_coupled       = amgparam1->strong_coupled;
     amgparam2->max_aggregation      = amgparam1->max_aggregation;
+    amgparam2->aggressive_levels    = amgparam1->aggressive_levels;
 
     amgparam2->tentative_smooth     = amgparam1->tentative_smooth;
+    amgparam2->smooth_drop_tol      = amgparam1->smooth_drop_tol;
     amgparam2->smooth_filter        = amgparam1->smooth_filter;
 
     amgparam2->Schwarz_levels       = amgparam1->Schwarz_levels;
@@ -499,6 +513,7 @@ void param_amg_print (AMG_param *amgparam)
         printf("AMG coarse dof:                    %lld\n", (long long )amgparam->coarse_dof);
         printf("AMG coarse solver type:            %lld\n", (long long )amgparam->coarse_solver);
         printf("AMG scaling of coarse correction:  %lld\n", (long long )amgparam->coarse_scaling);
+        printf("AMG SELL-C-sigma chunk height:     %lld\n", (long long )amgparam->sell_chunk);
         printf("AMG smoother type:                 %lld\n", (long long )amgparam->smoother);
         printf("AMG num of presmoothing:           %lld\n", (long long )amgparam->presmooth_iter);
         printf("AMG num of postsmoothing:          %lld\n", (long long )amgparam->postsmooth_iter);
@@ -532,11 +547,13 @@ void param_amg_print (AMG_param *amgparam)
                 printf("Aggregation AMG max aggregation:   %lld\n", (long long )amgparam->max_aggregation);
                 printf("SA AMG tentative smooth parameter: %.4f\n", amgparam->tentative_smooth);
                 printf("SA AMG smooth filter:              %lld\n", (long long )amgparam->smooth_filter);
+                printf("SA AMG smooth drop tolerance:      %.2e\n", amgparam->smooth_drop_tol);
 
             default: // UA_AMG
                 printf("Aggregation type:                  %lld\n", (long long )amgparam->aggregation_type);
                 printf("Aggregation AMG strong coupling:   %.4f\n", amgparam->strong_coupled);
                 printf("Aggregation AMG max aggregation:   %lld\n", (long long )amgparam->max_aggregation);
+                printf("Aggregation AMG aggressive levels: %lld\n", (long long )amgparam->aggressive_levels);
                 break;
         }
 
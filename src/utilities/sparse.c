@@ -10,6 +10,7 @@
  *
  */
 #include "hazmath.h"
+#include "dbsr_block.inl"
 
 /***********************************************************************************************/
 /*!
@@ -5401,6 +5402,31 @@ void dbsr_aAxpby (const REAL   alpha,
 }
 
 
+/*!
+ * \brief y := y + alpha*A*x for a dBSRmat with fixed block size NB; one
+ *        function per block size in DBSR_FOR_EACH_NB (see dbsr_block.inl)
+ */
+#define DBSR_AAXPY_NB(NB)                                               \
+static void dbsr_aAxpy_nb##NB(const REAL alpha,                         \
+                              const dBSRmat *A,                         \
+                              const REAL *x,                            \
+                              REAL *y)                                  \
+{                                                                       \
+    const INT  *IA = A->IA, *JA = A->JA;                                \
+    const REAL *val = A->val;                                           \
+    INT i, k, l;                                                        \
+    REAL t[NB];                                                         \
+    DBSR_OMP(omp parallel for private(k,l,t))                           \
+    for ( i = 0; i < A->ROW; ++i ) {                                    \
+        for ( l = 0; l < NB; ++l ) t[l] = 0.0;                          \
+        for ( k = IA[i]; k < IA[i+1]; ++k )                             \
+            dbsr_blk_ypAx_##NB(val+k*NB*NB, x+JA[k]*NB, t);             \
+        for ( l = 0; l < NB; ++l ) y[i*NB+l] += alpha*t[l];             \
+    }                                                                   \
+}
+
+DBSR_FOR_EACH_NB(DBSR_AAXPY_NB)
+
 /*!
  * \fn void dbsr_aAxpy (const REAL alpha, const dBSRmat *A,
  *                      const REAL *x, REAL *y)
@@ -5444,6 +5470,16 @@ void dbsr_aAxpy (const REAL      alpha,
         return; // Nothing to compute
     }
 
+    //----------------------------------------------
+    //   Unrolled kernels for common block sizes
+    //----------------------------------------------
+#define DBSR_CASE_AAXPY(NB) case NB: dbsr_aAxpy_nb##NB(alpha, A, x, y); return;
+    switch (nb) {
+        DBSR_FOR_EACH_NB(DBSR_CASE_AAXPY)
+        default: break;
+    }
+#undef DBSR_CASE_AAXPY
+
     //-------------------------------------------------
     //   y = (1.0/alpha)*y
     //-------------------------------------------------
@@ -5593,6 +5629,16 @@ void dbsr_mxv (const dBSRmat  *A,
     //-----------------------------------------------------------------
     array_set(size, y, 0.0);
 
+    //----------------------------------------------
+    //   Unrolled kernels for common block sizes
+    //----------------------------------------------
+#define DBSR_CASE_MXV(NB) case NB: dbsr_aAxpy_nb##NB(1.0, A, x, y); return;
+    switch (nb) {
+        DBSR_FOR_EACH_NB(DBSR_CASE_MXV)
+        default: break;
+    }
+#undef DBSR_CASE_MXV
+
     //-----------------------------------------------------------------
     //   y = A*x (Core Computation)
     //   each non-zero block elements are stored in row-major order
@@ -5893,29 +5939,27 @@ void dbsr_rap (const dBSRmat  *R,
          for (jj1 = ir[i]; jj1 < ir[i+1]; ++jj1) {
              i1 = jr[jj1];
              for (jj2 = ia[i1]; jj2 < ia[i1+1]; ++jj2) {
-                 ddense_mul(&rj[jj1*nb2],&aj[jj2*nb2], tmp, nb);
+                 dbsr_blk_mul(&rj[jj1*nb2],&aj[jj2*nb2], tmp, nb);
                  i2 = ja[jj2];
                  if (As_marker[i2] != i) {
                      As_marker[i2] = i;
                      for (jj3 = ip[i2]; jj3 < ip[i2+1]; ++jj3) {
                          i3 = jp[jj3];
-                         ddense_mul(tmp, &pj[jj3*nb2], tmp+nb2, nb);
                          if (Ps_marker[i3] < jj_row_begining) {
                              Ps_marker[i3] = counter;
-                             array_cp(nb2, tmp+nb2, &acj[counter*nb2]);
+                             dbsr_blk_mul(tmp, &pj[jj3*nb2], &acj[counter*nb2], nb);
                              jac[counter] = i3;
                              counter ++;
                          }
                          else {
-                             array_axpy(nb2, 1.0, tmp+nb2, &acj[Ps_marker[i3]*nb2]);
+                             dbsr_blk_mul_add(tmp, &pj[jj3*nb2], &acj[Ps_marker[i3]*nb2], tmp+nb2, nb);
                              }
                          }
                      }
                      else {
                          for (jj3 = ip[i2]; jj3 < ip[i2+1]; jj3 ++) {
                              i3 = jp[jj3];
-                             ddense_mul(tmp, &pj[jj3*nb2], tmp+nb2, nb);
-                             array_axpy(nb2, 1.0, tmp+nb2, &acj[Ps_marker[i3]*nb2]);
+                             dbsr_blk_mul_add(tmp, &pj[jj3*nb2], &acj[Ps_marker[i3]*nb2], tmp+nb2, nb);
                          }
                      }
                  }
@@ -6231,4 +6275,142 @@ dCSRmat condenseBSRLinf (const dBSRmat *A)
     return Acsr;
 }
 
+/***********************************************************************************************/
+/*!
+ * \fn void dsell_free (dSELLmat *A)
+ *
+ * \brief Free dSELLmat sparse matrix
+ *
+ * \param A   Pointer to the dSELLmat matrix
+ *
+ */
+void dsell_free(dSELLmat *A)
+{
+  if ( A == NULL ) return;
+
+  if (A->cs)   { free(A->cs);   A->cs   = NULL; }
+  if (A->cl)   { free(A->cl);   A->cl   = NULL; }
+  if (A->perm) { free(A->perm); A->perm = NULL; }
+  if (A->JA)   { free(A->JA);   A->JA   = NULL; }
+  if (A->val)  { free(A->val);  A->val  = NULL; }
+
+  A->row = A->col = A->nnz = A->nchunks = 0;
+}
+
+/*!
+ * \fn static inline void dsell_kernel (const dSELLmat *A, const REAL alpha,
+ *                                      const REAL *x, REAL *y, const INT C,
+ *                                      const SHORT add)
+ *
+ * \brief y = alpha*A*x (add=0) or y = y + alpha*A*x (add=1) for SELL-C-sigma
+ *
+ * \note Called with a constant C for the common chunk heights so that the
+ *       loops over the chunk slots are unrolled and vectorized.
+ */
+static inline void dsell_kernel(const dSELLmat *A,
+                                const REAL alpha,
+                                const REAL *x,
+                                REAL *y,
+                                const INT C,
+                                const SHORT add)
+{
+  const INT *cs = A->cs, *cl = A->cl, *perm = A->perm, *ja = A->JA;
+  const REAL *aj = A->val;
+  REAL t[SELL_MAX_CHUNK];
+  INT c, j, r, i, pos;
+
+  for (c=0;c<A->nchunks;++c) {
+    for (r=0;r<C;++r) t[r]=0.0;
+    for (j=0;j<cl[c];++j) {
+      pos=cs[c]+j*C;
+      for (r=0;r<C;++r) t[r]+=aj[pos+r]*x[ja[pos+r]];
+    }
+    for (r=0;r<C;++r) {
+      i=perm[c*C+r];
+      if (i<0) continue;
+      if (add) y[i]+=alpha*t[r];
+      else     y[i]=alpha*t[r];
+    }
+  }
+}
+
+/*!
+ * \fn static void dsell_dispatch (const dSELLmat *A, const REAL alpha,
+ *                                 const REAL *x, REAL *y, const SHORT add)
+ *
+ * \brief Call dsell_kernel with a compile-time chunk height when possible
+ */
+static void dsell_dispatch(const dSELLmat *A,
+                           const REAL alpha,
+                           const REAL *x,
+                           REAL *y,
+                           const SHORT add)
+{
+  switch (A->C) {
+    case 2:  dsell_kernel(A,alpha,x,y,2,add);  break;
+    case 4:  dsell_kernel(A,alpha,x,y,4,add);  break;
+    case 8:  dsell_kernel(A,alpha,x,y,8,add);  break;
+    case 16: dsell_kernel(A,alpha,x,y,16,add); break;
+    default: dsell_kernel(A,alpha,x,y,A->C,add); break;
+  }
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn void dsell_mxv (const dSELLmat *A, const REAL *x, REAL *y)
+ *
+ * \brief Matrix-vector multiplication y = A*x for SELL-C-sigma
+ *
+ * \param A   Pointer to dSELLmat matrix A
+ * \param x   Pointer to array x
+ * \param y   Pointer to array y
+ *
+ * \note Rows of A without nonzeros are set to zero in y.
+ */
+void dsell_mxv(const dSELLmat *A,
+               const REAL *x,
+               REAL *y)
+{
+  dsell_dispatch(A,1.0,x,y,0);
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn void dsell_aAxpy (const REAL alpha, const dSELLmat *A, const REAL *x, REAL *y)
+ *
+ * \brief Matrix-vector multiplication y = alpha*A*x + y for SELL-C-sigma
+ *
+ * \param alpha  REAL factor alpha
+ * \param A      Pointer to dSELLmat matrix A
+ * \param x      Pointer to array x
+ * \param y      Pointer to array y
+ *
+ */
+void dsell_aAxpy(const REAL alpha,
+                 const dSELLmat *A,
+                 const REAL *x,
+                 REAL *y)
+{
+  dsell_dispatch(A,alpha,x,y,1);
+}
+
+/***********************************************************************************************/
+/*!
+ * \fn void dsell_matvec (void *A, REAL *x, REAL *y)
+ *
+ * \brief y = A*x with A a dSELLmat; the fct of a matvec for general_pcg,
+ *        general_pvgmres etc.
+ *
+ * \param A   Pointer to dSELLmat matrix A (the data of the matvec)
+ * \param x   Pointer to array x
+ * \param y   Pointer to array y
+ *
+ */
+void dsell_matvec(void *A,
+                  REAL *x,
+                  REAL *y)
+{
+  dsell_mxv((const dSELLmat *)A,x,y);
+}
+
 /*********************************EOF***********************************/
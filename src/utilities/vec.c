@@ -338,6 +338,37 @@ void dvec_cp (dvector *x,
 
 }
 
+/***********************************************************************************************/
+/*!
+ * \fn void dvec_perm (dvector *x, const INT *P, const SHORT inv)
+ *
+ * \brief Permute the entries of a dvector in place: x_new[i] = x[P[i]]
+ *        (inv=0, the convention of dcsr_perm) or x_new[P[i]] = x[i] (inv=1)
+ *
+ * \param x    Pointer to dvector (MODIFIED)
+ * \param P    Permutation
+ * \param inv  0: apply P; 1: apply the inverse of P
+ *
+ * \note With Ap=dcsr_perm(A,P), the solution of A*u=b is u=dvec_perm(up,P,1)
+ *       where Ap*up=dvec_perm(b,P,0).
+ *
+ */
+void dvec_perm (dvector *x,
+                const INT *P,
+                const SHORT inv)
+{
+    INT i;
+    REAL *y=(REAL *)calloc(x->row,sizeof(REAL));
+    if (inv) {
+        for (i=0;i<x->row;i++) y[P[i]]=x->val[i];
+    }
+    else {
+        for (i=0;i<x->row;i++) y[i]=x->val[P[i]];
+    }
+    memcpy(x->val,y,x->row*sizeof(REAL));
+    free(y);
+}
+
 /***********************************************************************************************/
 /*!
  * \fn void ivec_cp (ivector *x, ivector *y)